@@ -0,0 +1,262 @@
+//=============================================================================
+//  Constructor and Destructor
+//=============================================================================
+BackgroundAnalyser::BackgroundAnalyser (const String& threadName, int numSignals)
+    : Thread (threadName),
+      wantsToBeActive (false),
+      updateInterval (100),
+      historyLength (0)
+{
+    for (int signal = 0; signal < numSignals; ++signal)
+    {
+        fifos.add (new AbstractFifo (1));
+    }
+}
+
+BackgroundAnalyser::~BackgroundAnalyser()
+{
+    stopAnalysing();
+}
+
+//=============================================================================
+//  Switching On and Off
+//=============================================================================
+void BackgroundAnalyser::setActive (bool shouldBeActive)
+{
+    wantsToBeActive = shouldBeActive;
+
+    // it can't start until the fifos have been prepared
+    if (wantsToBeActive && historyLength > 0)
+    {
+        startAnalysing();
+    }
+    else
+    {
+        stopAnalysing();
+    }
+}
+
+bool BackgroundAnalyser::isActive() const
+{
+    return active.get() != 0;
+}
+
+void BackgroundAnalyser::startAnalysing()
+{
+    if (! isActive())
+    {
+        for (int signal = 0; signal < fifos.size(); ++signal)
+        {
+            fifos [signal]->reset();
+        }
+
+        history.clear();
+        sequence = 0;
+
+        active = 1;
+        startThread (3);
+    }
+}
+
+void BackgroundAnalyser::stopAnalysing()
+{
+    if (isActive())
+    {
+        active = 0;
+        stopThread (2000);
+    }
+}
+
+void BackgroundAnalyser::resumeAnalysing()
+{
+    setActive (wantsToBeActive);
+}
+
+//=============================================================================
+//  Reading the Results
+//=============================================================================
+int BackgroundAnalyser::getUpdateCount() const
+{
+    return sequence.get() / 2;
+}
+
+//=============================================================================
+//  Setup Functions
+//=============================================================================
+void BackgroundAnalyser::prepareFifos (int fifoSize, int newHistoryLength)
+{
+    jassert (! isActive());
+
+    fifoBuffer.setSize (fifos.size(), fifoSize);
+
+    for (int signal = 0; signal < fifos.size(); ++signal)
+    {
+        fifos [signal]->setTotalSize (fifoSize);
+    }
+
+    historyLength = newHistoryLength;
+    history.setSize (fifos.size(), historyLength);
+    history.clear();
+}
+
+void BackgroundAnalyser::setUpdateInterval (int milliseconds)
+{
+    updateInterval = milliseconds;
+}
+
+//=============================================================================
+//  Feeding the Analyser
+//=============================================================================
+void BackgroundAnalyser::addSamples (int signal, const AudioSampleBuffer& buffer, int numChannels)
+{
+    const int numSamples = buffer.getNumSamples();
+    numChannels = jmin (numChannels, buffer.getNumChannels());
+
+    if (! isActive() || numSamples == 0 || numChannels <= 0)
+    {
+        return;
+    }
+
+    AbstractFifo& fifo = *fifos [signal];
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite (numSamples, start1, size1, start2, size2);
+
+    if (size1 + size2 < numSamples)
+    {
+        return;
+    }
+
+    const float gain = 1.0f / numChannels;
+    const int starts [2] = {start1, start2};
+    const int sizes [2] = {size1, size2};
+    const int offsets [2] = {0, size1};
+
+    for (int part = 0; part < 2; ++part)
+    {
+        if (sizes [part] > 0)
+        {
+            fifoBuffer.copyFrom (signal, starts [part], buffer.getReadPointer (0, offsets [part]), sizes [part], gain);
+
+            for (int channel = 1; channel < numChannels; ++channel)
+            {
+                fifoBuffer.addFrom (signal, starts [part], buffer, channel, offsets [part], sizes [part], gain);
+            }
+        }
+    }
+
+    fifo.finishedWrite (numSamples);
+}
+
+//=============================================================================
+//  Analysing the History
+//=============================================================================
+const float* BackgroundAnalyser::getHistory (int signal) const
+{
+    return history.getReadPointer (signal);
+}
+
+int BackgroundAnalyser::getHistoryLength() const
+{
+    return historyLength;
+}
+
+//=============================================================================
+//  Publishing Results
+//=============================================================================
+void BackgroundAnalyser::beginPublishing()
+{
+    ++sequence;
+}
+
+void BackgroundAnalyser::finishPublishing()
+{
+    ++sequence;
+}
+
+void BackgroundAnalyser::clearPublished()
+{
+    jassert (! isActive());
+
+    sequence = 0;
+}
+
+int BackgroundAnalyser::beginReading() const
+{
+    for (;;)
+    {
+        const int sequenceBefore = sequence.get();
+
+        if ((sequenceBefore & 1) == 0)
+        {
+            return sequenceBefore;
+        }
+
+        Thread::yield();
+    }
+}
+
+bool BackgroundAnalyser::finishReading (int sequenceBefore) const
+{
+    return sequence.get() == sequenceBefore;
+}
+
+//=============================================================================
+//  The Thread Callback
+//=============================================================================
+void BackgroundAnalyser::run()
+{
+    while (! threadShouldExit())
+    {
+        wait (updateInterval);
+
+        if (threadShouldExit())
+        {
+            break;
+        }
+
+        bool newSamples = false;
+
+        for (int signal = 0; signal < fifos.size(); ++signal)
+        {
+            newSamples = readFifo (signal) || newSamples;
+        }
+
+        // nothing new means the host isn't playing, so leave the last results up
+        if (newSamples)
+        {
+            analyseHistory();
+        }
+    }
+}
+
+bool BackgroundAnalyser::readFifo (int signal)
+{
+    AbstractFifo& fifo = *fifos [signal];
+    const int numReady = fifo.getNumReady();
+
+    if (numReady == 0)
+    {
+        return false;
+    }
+
+    int start1, size1, start2, size2;
+    fifo.prepareToRead (numReady, start1, size1, start2, size2);
+
+    float* samples = history.getWritePointer (signal);
+    const float* parts [2] = {fifoBuffer.getReadPointer (signal, start1), fifoBuffer.getReadPointer (signal, start2)};
+    const int partSizes [2] = {size1, size2};
+
+    for (int part = 0; part < 2; ++part)
+    {
+        // only the newest historyLength samples are kept
+        const int numToKeep = jmin (partSizes [part], historyLength);
+        const float* newSamples = parts [part] + partSizes [part] - numToKeep;
+
+        memmove (samples, samples + numToKeep, sizeof (float) * (size_t) (historyLength - numToKeep));
+        memcpy (samples + historyLength - numToKeep, newSamples, sizeof (float) * (size_t) numToKeep);
+    }
+
+    fifo.finishedRead (numReady);
+
+    return true;
+}
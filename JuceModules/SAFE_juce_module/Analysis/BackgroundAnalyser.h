@@ -0,0 +1,170 @@
+#ifndef __BACKGROUNDANALYSER__
+#define __BACKGROUNDANALYSER__
+
+/**
+ *  A base for classes which analyse the audio a plug-in is playing on a background
+ *  thread, for an editor to show.
+ *
+ *  The audio thread mixes each block of a signal down to mono and pushes it into a
+ *  lock free FIFO, which is all it pays for the analysis, and nothing at all while
+ *  the analyser is inactive. A background thread wakes at a fixed rate, moves
+ *  whatever has arrived onto the end of a history of the latest samples of each
+ *  signal and calls analyseHistory(). If nothing has arrived the host isn't playing,
+ *  so the last results are left as they are.
+ *
+ *  Results are published with a sequence count, so the message thread can read a
+ *  consistent set of them without taking a lock, and knows when there are new ones.
+ *  Write them between beginPublishing() and finishPublishing(), and read them in a
+ *  loop between beginReading() and finishReading().
+ */
+class BackgroundAnalyser : private Thread
+{
+public:
+    //=============================================================================
+    //  Constructor and Destructor
+    //=============================================================================
+    /** Create a new analyser.
+     *
+     *  @param threadName  the name of the background thread
+     *  @param numSignals  the number of signals which are analysed
+     */
+    BackgroundAnalyser (const String& threadName, int numSignals);
+
+    /** Destructor
+     *
+     *  The thread calls analyseHistory(), so a derived class has to call
+     *  stopAnalysing() in its own destructor.
+     */
+    virtual ~BackgroundAnalyser();
+
+    //=============================================================================
+    //  Switching On and Off
+    //=============================================================================
+    /** Start or stop the background thread.
+     *
+     *  When the analyser is inactive the audio thread doesn't copy anything. This
+     *  should be called from the message thread. If the analyser hasn't been
+     *  prepared yet it starts once it has.
+     */
+    void setActive (bool shouldBeActive);
+
+    /** Returns true if the analyser is running. */
+    bool isActive() const;
+
+    //=============================================================================
+    //  Reading the Results
+    //=============================================================================
+    /** Returns a number which goes up each time new results are published.
+     *
+     *  This is zero until the first results have been worked out.
+     */
+    int getUpdateCount() const;
+
+protected:
+    //=============================================================================
+    //  Setup Functions
+    //=============================================================================
+    /** Size the FIFOs and the history.
+     *
+     *  Call this with the analyser stopped, between stopAnalysing() and
+     *  resumeAnalysing().
+     *
+     *  @param fifoSize       the number of samples each FIFO can hold, this should be
+     *                        a lot more than gets added between updates
+     *  @param historyLength  the number of samples of each signal to keep
+     */
+    void prepareFifos (int fifoSize, int historyLength);
+
+    /** Set how long the background thread waits between updates.
+     *
+     *  @param milliseconds  the time between updates
+     */
+    void setUpdateInterval (int milliseconds);
+
+    /** Stop the background thread so the analysis can be changed. */
+    void stopAnalysing();
+
+    /** Start the background thread again if setActive() asked for it. */
+    void resumeAnalysing();
+
+    //=============================================================================
+    //  Feeding the Analyser
+    //=============================================================================
+    /** Mix the first few channels of a block down to mono and add them to a signal.
+     *
+     *  This is called from the audio thread and doesn't allocate or wait. If the
+     *  signal's FIFO is full the block is skipped.
+     *
+     *  @param signal       the index of the signal the block belongs to
+     *  @param buffer       the block
+     *  @param numChannels  the number of channels in the block to mix
+     */
+    void addSamples (int signal, const AudioSampleBuffer& buffer, int numChannels);
+
+    //=============================================================================
+    //  Analysing the History
+    //=============================================================================
+    /** Work out and publish new results, this is called on the background thread. */
+    virtual void analyseHistory() = 0;
+
+    /** Returns the latest samples of a signal, oldest first. */
+    const float* getHistory (int signal) const;
+
+    /** Returns the number of samples of each signal in the history. */
+    int getHistoryLength() const;
+
+    //=============================================================================
+    //  Publishing Results
+    //=============================================================================
+    /** Call this before writing new results. */
+    void beginPublishing();
+
+    /** Call this once new results have been written. */
+    void finishPublishing();
+
+    /** Forget the published results, so getUpdateCount() goes back to zero.
+     *
+     *  Call this with the analyser stopped.
+     */
+    void clearPublished();
+
+    /** Wait until no results are being written and return the sequence count to
+     *  pass to finishReading(), or zero if nothing has been published yet. */
+    int beginReading() const;
+
+    /** Returns true if no new results were published while they were being read.
+     *
+     *  @param sequenceBefore  the value returned by beginReading()
+     */
+    bool finishReading (int sequenceBefore) const;
+
+private:
+    //=============================================================================
+    //  The Thread Callback
+    //=============================================================================
+    void run() override;
+
+    /** Move everything in a signal's FIFO onto the end of its history. */
+    bool readFifo (int signal);
+
+    void startAnalysing();
+
+    bool wantsToBeActive;
+    Atomic <int> active;
+
+    int updateInterval;
+
+    AudioSampleBuffer fifoBuffer;
+    OwnedArray <AbstractFifo> fifos;
+
+    // the latest samples of each signal
+    AudioSampleBuffer history;
+    int historyLength;
+
+    // odd while new results are being written
+    Atomic <int> sequence;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BackgroundAnalyser);
+};
+
+#endif // __BACKGROUNDANALYSER__
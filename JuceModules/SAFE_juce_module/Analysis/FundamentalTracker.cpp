@@ -1,11 +1,33 @@
+//=============================================================================
+//  A Single Step of the Tracker Recursion
+//=============================================================================
+static forcedinline void fundamentalTrackerStep (float x, float& x1, float& x2, float& c, float gamma, float& errorEnergy, float& signalEnergy, float& sumOfSquares) noexcept
+{
+    float prediction = x + x2;
+    float error = prediction - 2 * x1 * c;
+
+    c += gamma * x1 * error;
+
+    errorEnergy += error * error;
+    signalEnergy += prediction * prediction;
+    sumOfSquares += x * x;
+
+    x2 = x1;
+    x1 = x;
+}
+
 //=============================================================================
 //  Constructor and Destructor
 //=============================================================================
 FundamentalTracker::FundamentalTracker()
 {
-    reset();
-
+    fs = 44100;
     gamma = 0.002;
+
+    gateThreshold = Decibels::decibelsToGain (-60.0f);
+    minConfidence = 0.5f;
+
+    reset();
 }
 
 FundamentalTracker::~FundamentalTracker()
@@ -20,20 +42,28 @@ void FundamentalTracker::setSampleRate (double sampleRate)
     fs = sampleRate;
 }
 
+void FundamentalTracker::setGateThreshold (float newThresholdDB)
+{
+    gateThreshold = Decibels::decibelsToGain (newThresholdDB);
+}
+
+void FundamentalTracker::setMinimumConfidence (float newMinConfidence)
+{
+    minConfidence = newMinConfidence;
+}
+
 void FundamentalTracker::reset()
 {
-    for (int i = 0; i < 3; ++i)
-    {
-        signalBuffer [i] = 0;
-    }
+    prevSample = 0;
+    prevPrevSample = 0;
+    f0Estimate = 0;
 
-    for (int i = 0; i < 2; ++i)
-    {
-        f0Buffer [i] = 0;
-    }
+    fundamental = 0;
+    confidence = 0;
+    rmsLevel = 0;
 
-    signalTap = 0;
-    f0Tap = 0;
+    tracking = false;
+    blockProcessed = false;
 }
 
 //=============================================================================
@@ -41,24 +71,124 @@ void FundamentalTracker::reset()
 //=============================================================================
 void FundamentalTracker::addSample (float newSample)
 {
-    signalBuffer [signalTap] = newSample;
+    float errorEnergy = 0, signalEnergy = 0, sumOfSquares = 0;
+
+    fundamentalTrackerStep (newSample, prevSample, prevPrevSample, f0Estimate, gamma, errorEnergy, signalEnergy, sumOfSquares);
+}
+
+void FundamentalTracker::processBlock (const float* samples, int numSamples)
+{
+    float x1 = prevSample, x2 = prevPrevSample, c = f0Estimate;
+    float errorEnergy = 0, signalEnergy = 0, sumOfSquares = 0;
+
+    int i = 0;
+
+    for (; i < numSamples - 3; i += 4)
+    {
+        fundamentalTrackerStep (samples [i], x1, x2, c, gamma, errorEnergy, signalEnergy, sumOfSquares);
+        fundamentalTrackerStep (samples [i + 1], x1, x2, c, gamma, errorEnergy, signalEnergy, sumOfSquares);
+        fundamentalTrackerStep (samples [i + 2], x1, x2, c, gamma, errorEnergy, signalEnergy, sumOfSquares);
+        fundamentalTrackerStep (samples [i + 3], x1, x2, c, gamma, errorEnergy, signalEnergy, sumOfSquares);
+    }
+
+    for (; i < numSamples; ++i)
+    {
+        fundamentalTrackerStep (samples [i], x1, x2, c, gamma, errorEnergy, signalEnergy, sumOfSquares);
+    }
+
+    prevSample = x1;
+    prevPrevSample = x2;
+    f0Estimate = c;
+
+    updateFundamental (errorEnergy, signalEnergy, sumOfSquares, numSamples);
+}
+
+void FundamentalTracker::processBlock (const float* const* channels, int numChannels, int numSamples)
+{
+    if (numChannels == 1)
+    {
+        processBlock (channels [0], numSamples);
+        return;
+    }
+
+    float x1 = prevSample, x2 = prevPrevSample, c = f0Estimate;
+    float errorEnergy = 0, signalEnergy = 0, sumOfSquares = 0;
+    float channelScale = 1.0f / numChannels;
 
-    int prevSampleIndex = (signalTap + 2) % 3;
-    int prevPrevSampleIndex = (signalTap + 1) % 3;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        float x = 0;
 
-    int prevF0Index = 1 - f0Tap;
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            x += channels [channel][i];
+        }
 
-    f0Buffer [f0Tap] = f0Buffer [prevF0Index] + signalBuffer [prevSampleIndex] * gamma * 
-                       (signalBuffer [signalTap] + signalBuffer [prevPrevSampleIndex]
-                       - 2 * signalBuffer [prevSampleIndex] * f0Buffer [prevF0Index]);
+        fundamentalTrackerStep (x * channelScale, x1, x2, c, gamma, errorEnergy, signalEnergy, sumOfSquares);
+    }
 
-    signalTap = prevPrevSampleIndex;
+    prevSample = x1;
+    prevPrevSample = x2;
+    f0Estimate = c;
 
-    f0Tap = prevF0Index;
+    updateFundamental (errorEnergy, signalEnergy, sumOfSquares, numSamples);
 }
 
 float FundamentalTracker::getFundamental()
 {
-    float rawF0 = f0Buffer [1 - f0Tap];
-    return fs * acos (rawF0) / (2 * float_Pi);
+    if (! blockProcessed)
+    {
+        float rawF0 = jlimit (-1.0f, 1.0f, f0Estimate);
+        fundamental = (float) (fs * acos (rawF0) / (2 * double_Pi));
+    }
+
+    return fundamental;
+}
+
+float FundamentalTracker::getConfidence() const
+{
+    return confidence;
+}
+
+float FundamentalTracker::getRMSLevel() const
+{
+    return rmsLevel;
+}
+
+bool FundamentalTracker::isTracking() const
+{
+    return tracking;
+}
+
+//=============================================================================
+//  Block Statistics
+//=============================================================================
+void FundamentalTracker::updateFundamental (float errorEnergy, float signalEnergy, float sumOfSquares, int numSamples)
+{
+    blockProcessed = true;
+
+    if (numSamples <= 0)
+    {
+        return;
+    }
+
+    rmsLevel = sqrt (sumOfSquares / numSamples);
+
+    if (signalEnergy > 0)
+    {
+        confidence = jlimit (0.0f, 1.0f, 1 - errorEnergy / signalEnergy);
+    }
+    else
+    {
+        confidence = 0;
+    }
+
+    tracking = rmsLevel > gateThreshold && confidence >= minConfidence;
+
+    // only run the acos when the estimate is actually going to be used
+    if (tracking)
+    {
+        float rawF0 = jlimit (-1.0f, 1.0f, f0Estimate);
+        fundamental = (float) (fs * acos (rawF0) / (2 * double_Pi));
+    }
 }
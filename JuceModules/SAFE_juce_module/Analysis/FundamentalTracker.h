@@ -9,6 +9,12 @@
  *  (http://eu.wiley.com/WileyCDA/WileyTitle/productCd-0470858648.html)
  *  (Larsen, E. and Aarts, R. 2004)
  *  With a gamma value of 0.002.
+ *
+ *  Alongside the fundamental estimate the tracker produces a confidence value
+ *  for each block it processes. This is one minus the ratio of the prediction
+ *  error energy to the signal energy, so a clean periodic signal gives a value
+ *  close to 1 and noise or silence gives a value close to 0. Blocks with an RMS
+ *  level below the gate threshold leave the last good estimate untouched.
  */
 class FundamentalTracker
 {
@@ -31,6 +37,18 @@ public:
      */
     void setSampleRate (double sampleRate);
 
+    /** Set the RMS level below which blocks are ignored.
+     *
+     *  @param newThresholdDB  the gate threshold in decibels
+     */
+    void setGateThreshold (float newThresholdDB);
+
+    /** Set the confidence a block must reach for its estimate to be used.
+     *
+     *  @param newMinConfidence  the minimum confidence in the range 0-1
+     */
+    void setMinimumConfidence (float newMinConfidence);
+
     /** Reset the tracker's internal buffers to 0. */
     void reset();
 
@@ -40,19 +58,57 @@ public:
     /** Add the next sample of the signal being analysed.
      *
      *  Using this function individual samples of the input are added one at a time.
-     *  I should get around to putting in some functions where you can add arrays 
-     *  of samples but I haven't yet.
+     *  This does not update the confidence or the gate, processBlock() should be
+     *  used wherever blocks of samples are available.
      */
     void addSample (float newSample);
 
-    /** Returns an approximation of fundamental frequency of the input signal. */
+    /** Add a block of samples of the signal being analysed.
+     *
+     *  Updates the fundamental estimate, the confidence and the block RMS level.
+     *
+     *  @param samples     a pointer to the array of samples to analyse
+     *  @param numSamples  the number of samples in the array
+     */
+    void processBlock (const float* samples, int numSamples);
+
+    /** Add a block of multi channel samples of the signal being analysed.
+     *
+     *  The channels are averaged as they are read so one fundamental is
+     *  tracked across all of them.
+     *
+     *  @param channels     an array of pointers to the channels to analyse
+     *  @param numChannels  the number of channels
+     *  @param numSamples   the number of samples in each channel
+     */
+    void processBlock (const float* const* channels, int numChannels, int numSamples);
+
+    /** Returns an approximation of fundamental frequency of the input signal.
+     *
+     *  After a call to processBlock() this is the estimate from the last block
+     *  which was above the gate threshold and minimum confidence.
+     */
     float getFundamental();
 
+    /** Returns the confidence of the last processed block in the range 0-1. */
+    float getConfidence() const;
+
+    /** Returns the RMS level of the last processed block. */
+    float getRMSLevel() const;
+
+    /** Returns true if the last processed block produced a usable estimate. */
+    bool isTracking() const;
+
 private:
     double fs;
-    float signalBuffer [3], f0Buffer [2];
-    int signalTap, f0Tap;
+    float prevSample, prevPrevSample, f0Estimate;
     float gamma;
+
+    float fundamental, confidence, rmsLevel;
+    float gateThreshold, minConfidence;
+    bool tracking, blockProcessed;
+
+    void updateFundamental (float errorEnergy, float signalEnergy, float sumOfSquares, int numSamples);
 };
 
 #endif // __FUNDAMENTALTRACKER__
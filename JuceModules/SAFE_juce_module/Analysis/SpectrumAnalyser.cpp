@@ -0,0 +1,195 @@
+//=============================================================================
+//  Constructor and Destructor
+//=============================================================================
+SpectrumAnalyser::SpectrumAnalyser()
+    : BackgroundAnalyser ("SpectrumAnalyser", numSignals),
+      fs (0),
+      levelScale (1)
+{
+    setUpdateInterval (33);
+
+    // a Hann window, the levels are scaled so a full scale sine wave reads 0dB
+    window.allocate (fftSize, true);
+    float windowSum = 0;
+
+    for (int i = 0; i < fftSize; ++i)
+    {
+        window [i] = 0.5f - 0.5f * cos (2.0f * float_Pi * i / fftSize);
+        windowSum += window [i];
+    }
+
+    levelScale = 2.0f / windowSum;
+
+    fftReal.allocate (fftSize, true);
+    fftImag.allocate (fftSize, true);
+
+    twiddleReal.allocate (fftSize / 2, true);
+    twiddleImag.allocate (fftSize / 2, true);
+
+    for (int i = 0; i < fftSize / 2; ++i)
+    {
+        twiddleReal [i] = (float) cos (2.0 * double_Pi * i / fftSize);
+        twiddleImag [i] = (float) - sin (2.0 * double_Pi * i / fftSize);
+    }
+
+    bitReversedIndex.allocate (fftSize, true);
+
+    for (int i = 0; i < fftSize; ++i)
+    {
+        int reversed = 0;
+
+        for (int bit = 0; bit < fftOrder; ++bit)
+        {
+            reversed |= ((i >> bit) & 1) << (fftOrder - 1 - bit);
+        }
+
+        bitReversedIndex [i] = reversed;
+    }
+
+    latestLevels.allocate (numSignals * numBins, true);
+    publishedLevels.allocate (numSignals * numBins, true);
+}
+
+SpectrumAnalyser::~SpectrumAnalyser()
+{
+    stopAnalysing();
+}
+
+//=============================================================================
+//  Setup Functions
+//=============================================================================
+void SpectrumAnalyser::prepare (double sampleRate, int samplesPerBlock)
+{
+    stopAnalysing();
+
+    fs = sampleRate;
+
+    // room for half a second of audio, more than gets added between the slowest updates
+    prepareFifos ((int) (sampleRate / 2) + samplesPerBlock, fftSize);
+
+    resumeAnalysing();
+}
+
+double SpectrumAnalyser::getSampleRate() const
+{
+    return fs;
+}
+
+double SpectrumAnalyser::getBinFrequency (int bin) const
+{
+    return bin * fs / fftSize;
+}
+
+void SpectrumAnalyser::setUpdateRate (double newUpdateRate)
+{
+    setUpdateInterval (roundToInt (1000.0 / jlimit (5.0, 60.0, newUpdateRate)));
+}
+
+//=============================================================================
+//  Feeding the Analyser
+//=============================================================================
+void SpectrumAnalyser::addSamples (Signal signal, const AudioSampleBuffer& buffer, int numChannels)
+{
+    BackgroundAnalyser::addSamples (signal, buffer, numChannels);
+}
+
+//=============================================================================
+//  Reading the Spectra
+//=============================================================================
+bool SpectrumAnalyser::getLatestSpectrum (Signal signal, float* levelsToFill) const
+{
+    // try again if the levels changed while they were being copied
+    for (;;)
+    {
+        const int sequenceBefore = beginReading();
+
+        if (sequenceBefore == 0)
+        {
+            return false;
+        }
+
+        memcpy (levelsToFill, publishedLevels + signal * numBins, sizeof (float) * numBins);
+
+        if (finishReading (sequenceBefore))
+        {
+            return true;
+        }
+    }
+}
+
+//=============================================================================
+//  Analysing the History
+//=============================================================================
+void SpectrumAnalyser::analyseHistory()
+{
+    for (int signal = 0; signal < numSignals; ++signal)
+    {
+        analyseSignal (signal, latestLevels + signal * numBins);
+    }
+
+    beginPublishing();
+    memcpy (publishedLevels, latestLevels, sizeof (float) * (size_t) (numSignals * numBins));
+    finishPublishing();
+}
+
+void SpectrumAnalyser::analyseSignal (int signal, float* levels)
+{
+    const float* samples = getHistory (signal);
+
+    for (int i = 0; i < fftSize; ++i)
+    {
+        fftReal [i] = samples [i] * window [i];
+        fftImag [i] = 0;
+    }
+
+    performFFT();
+
+    // floor the levels at -120dB so silence doesn't take the log of zero
+    const float scaleSquared = levelScale * levelScale;
+
+    for (int bin = 0; bin < numBins; ++bin)
+    {
+        const float power = (fftReal [bin] * fftReal [bin] + fftImag [bin] * fftImag [bin]) * scaleSquared;
+        levels [bin] = 10.0f * log10 (jmax (power, 1.0e-12f));
+    }
+}
+
+void SpectrumAnalyser::performFFT()
+{
+    for (int i = 0; i < fftSize; ++i)
+    {
+        const int j = bitReversedIndex [i];
+
+        if (j > i)
+        {
+            std::swap (fftReal [i], fftReal [j]);
+            std::swap (fftImag [i], fftImag [j]);
+        }
+    }
+
+    for (int length = 2; length <= fftSize; length <<= 1)
+    {
+        const int halfLength = length / 2;
+        const int twiddleStep = fftSize / length;
+
+        for (int start = 0; start < fftSize; start += length)
+        {
+            for (int k = 0; k < halfLength; ++k)
+            {
+                const float wReal = twiddleReal [k * twiddleStep];
+                const float wImag = twiddleImag [k * twiddleStep];
+
+                const int even = start + k;
+                const int odd = even + halfLength;
+
+                const float oddReal = fftReal [odd] * wReal - fftImag [odd] * wImag;
+                const float oddImag = fftReal [odd] * wImag + fftImag [odd] * wReal;
+
+                fftReal [odd] = fftReal [even] - oddReal;
+                fftImag [odd] = fftImag [even] - oddImag;
+                fftReal [even] += oddReal;
+                fftImag [even] += oddImag;
+            }
+        }
+    }
+}
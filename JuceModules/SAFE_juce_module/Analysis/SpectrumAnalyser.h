@@ -0,0 +1,114 @@
+#ifndef __SPECTRUMANALYSER__
+#define __SPECTRUMANALYSER__
+
+/**
+ *  Works out the spectrum of a plug-in's input and output as it plays.
+ *
+ *  Each update takes a Hann windowed FFT of the latest samples of each signal and
+ *  publishes the level of every bin in decibels. Because the FFT size and the update
+ *  rate are fixed, so is the CPU the analyser uses, however small the host's blocks
+ *  are. A display can read a consistent pair of spectra without taking a lock, see
+ *  BackgroundAnalyser.
+ */
+class SpectrumAnalyser : public BackgroundAnalyser
+{
+public:
+    //=============================================================================
+    //  Constructor and Destructor
+    //=============================================================================
+    /** Create a new spectrum analyser. */
+    SpectrumAnalyser();
+
+    /** Destructor */
+    ~SpectrumAnalyser();
+
+    /** The signals which are analysed. */
+    enum Signal
+    {
+        unprocessedSignal = 0, /**< The audio before the plug-in processes it. */
+        processedSignal, /**< The audio after the plug-in has processed it. */
+        numSignals
+    };
+
+    static const int fftOrder = 12; /**< The log2 of the FFT size. */
+    static const int fftSize = 1 << fftOrder; /**< The number of samples in each FFT. */
+    static const int numBins = fftSize / 2 + 1; /**< The number of levels in a spectrum, from DC up to Nyquist. */
+
+    //=============================================================================
+    //  Setup Functions
+    //=============================================================================
+    /** Get ready to analyse audio at a new sample rate.
+     *
+     *  @param sampleRate       the sample rate of the audio
+     *  @param samplesPerBlock  the largest block the audio thread will add
+     */
+    void prepare (double sampleRate, int samplesPerBlock);
+
+    /** Returns the sample rate given to the last call to prepare(). */
+    double getSampleRate() const;
+
+    /** Returns the frequency at the centre of an FFT bin.
+     *
+     *  @param bin  the index of the bin
+     */
+    double getBinFrequency (int bin) const;
+
+    /** Set how many times a second the spectra are worked out.
+     *
+     *  @param newUpdateRate  the number of updates per second, this is limited to 5 - 60
+     */
+    void setUpdateRate (double newUpdateRate);
+
+    //=============================================================================
+    //  Feeding the Analyser
+    //=============================================================================
+    /** Add a block of the plug-in's input or output, from the audio thread.
+     *
+     *  The first few channels are mixed down to mono.
+     *
+     *  @param signal       the signal the block belongs to
+     *  @param buffer       the block
+     *  @param numChannels  the number of channels in the block to mix
+     */
+    void addSamples (Signal signal, const AudioSampleBuffer& buffer, int numChannels);
+
+    //=============================================================================
+    //  Reading the Spectra
+    //=============================================================================
+    /** Copy the latest spectrum of a signal.
+     *
+     *  Returns false if nothing has been published yet.
+     *
+     *  @param signal        the signal to get the spectrum of
+     *  @param levelsToFill  an array of numBins values to put the level of each bin
+     *                       in, in decibels relative to a full scale sine wave
+     */
+    bool getLatestSpectrum (Signal signal, float* levelsToFill) const;
+
+private:
+    //=============================================================================
+    //  Analysing the History
+    //=============================================================================
+    void analyseHistory() override;
+
+    /** Work out the level of each bin of a signal's latest samples. */
+    void analyseSignal (int signal, float* levels);
+
+    /** An in place radix 2 FFT of fftReal and fftImag. */
+    void performFFT();
+
+    double fs;
+
+    HeapBlock <float> window;
+    float levelScale;
+
+    HeapBlock <float> fftReal, fftImag;
+    HeapBlock <float> twiddleReal, twiddleImag;
+    HeapBlock <int> bitReversedIndex;
+
+    HeapBlock <float> latestLevels, publishedLevels;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrumAnalyser);
+};
+
+#endif // __SPECTRUMANALYSER__
@@ -1,25 +1,225 @@
+//==============================================================================
+//  Helpers for factorising a transfer function into second order sections
+//==============================================================================
+namespace BrechtsIIRFilterHelpers
+{
+    typedef std::complex <double> Complex;
+
+    /** A first or second order factor of a polynomial in z^-1. */
+    struct Factor
+    {
+        double c [3];
+        Complex root;
+        bool finite;
+    };
+
+    // Roots of c[0] z^n + c[1] z^(n-1) + ... + c[n] with c[0] != 0,
+    // found with the Durand-Kerner iteration.
+    static void findRoots (const double* c, int degree, Complex* roots)
+    {
+        if (degree < 1)
+            return;
+
+        if (degree == 1)
+        {
+            roots [0] = Complex (- c [1] / c [0], 0);
+            return;
+        }
+
+        const Complex seed (0.4, 0.9);
+        roots [0] = Complex (1, 0);
+
+        for (int k = 1; k < degree; ++k)
+        {
+            roots [k] = roots [k - 1] * seed;
+        }
+
+        for (int iteration = 0; iteration < 500; ++iteration)
+        {
+            double maxChange = 0;
+
+            for (int k = 0; k < degree; ++k)
+            {
+                const Complex z = roots [k];
+                Complex numerator (c [0], 0), denominator (c [0], 0);
+
+                for (int i = 1; i <= degree; ++i)
+                {
+                    numerator = numerator * z + c [i];
+                }
+
+                for (int j = 0; j < degree; ++j)
+                {
+                    if (j != k)
+                        denominator *= z - roots [j];
+                }
+
+                if (denominator == Complex (0, 0))
+                    denominator = Complex (1.0e-12, 0);
+
+                const Complex change = numerator / denominator;
+                roots [k] -= change;
+                maxChange = jmax (maxChange, std::abs (change));
+            }
+
+            if (maxChange < 1.0e-14)
+                break;
+        }
+    }
+
+    static Factor makeLinearFactor (const Complex& root, bool finite)
+    {
+        Factor factor;
+        factor.c [0] = finite ? 1 : 0;
+        factor.c [1] = finite ? - root.real() : 1;
+        factor.c [2] = 0;
+        factor.root = root;
+        factor.finite = finite;
+        return factor;
+    }
+
+    static Factor multiplyLinearFactors (const Factor& first, const Factor& second)
+    {
+        Factor factor;
+        factor.c [0] = first.c [0] * second.c [0];
+        factor.c [1] = first.c [0] * second.c [1] + first.c [1] * second.c [0];
+        factor.c [2] = first.c [1] * second.c [1];
+        factor.root = first.finite ? first.root : second.root;
+        factor.finite = first.finite || second.finite;
+        return factor;
+    }
+
+    struct RealPartComparator
+    {
+        static int compareElements (const Complex& first, const Complex& second) noexcept
+        {
+            return first.real() < second.real() ? -1 : (first.real() > second.real() ? 1 : 0);
+        }
+    };
+
+    // Groups roots (plus any roots at infinity) into real valued factors of at
+    // most second order. Conjugate pairs share a factor, real roots are paired
+    // in order and an odd one out becomes a first order factor.
+    static void buildFactors (const Complex* roots, int numRoots, int numInfiniteRoots, Array <Factor>& factors)
+    {
+        Array <Complex> upper, lower, real;
+
+        for (int i = 0; i < numRoots; ++i)
+        {
+            const double tolerance = 1.0e-7 * jmax (1.0, std::abs (roots [i]));
+
+            if (roots [i].imag() > tolerance)
+                upper.add (roots [i]);
+            else if (roots [i].imag() < - tolerance)
+                lower.add (roots [i]);
+            else
+                real.add (Complex (roots [i].real(), 0));
+        }
+
+        // with real coefficients these should balance, anything left over
+        // is numerically close enough to the real axis to be treated as real
+        jassert (upper.size() == lower.size());
+
+        while (upper.size() > lower.size())
+        {
+            real.add (Complex (upper.getLast().real(), 0));
+            upper.removeLast();
+        }
+
+        while (lower.size() > upper.size())
+        {
+            real.add (Complex (lower.getLast().real(), 0));
+            lower.removeLast();
+        }
+
+        for (int i = 0; i < upper.size(); ++i)
+        {
+            Factor factor;
+            factor.c [0] = 1;
+            factor.c [1] = -2 * upper [i].real();
+            factor.c [2] = std::norm (upper [i]);
+            factor.root = upper [i];
+            factor.finite = true;
+            factors.add (factor);
+        }
+
+        RealPartComparator comparator;
+        real.sort (comparator);
+
+        Array <Factor> linearFactors;
+
+        for (int i = 0; i < real.size(); ++i)
+        {
+            linearFactors.add (makeLinearFactor (real [i], true));
+        }
+
+        for (int i = 0; i < numInfiniteRoots; ++i)
+        {
+            linearFactors.add (makeLinearFactor (Complex (0, 0), false));
+        }
+
+        for (int i = 0; i + 1 < linearFactors.size(); i += 2)
+        {
+            factors.add (multiplyLinearFactors (linearFactors [i], linearFactors [i + 1]));
+        }
+
+        if (linearFactors.size() % 2)
+        {
+            factors.add (linearFactors.getLast());
+        }
+    }
+}
+
 //==============================================================================
 BrechtsIIRFilter::BrechtsIIRFilter(int filterOrder) noexcept // constructor
-    : _filterOrder  (filterOrder)
+    : _filterOrder  (jmax (0, filterOrder))
+    , _numSections  (0)
+    , _numChannels  (1)
+    , _stateStride  (4)
     , _active       (false)
 {
-    _coefficients   = new float[2*filterOrder+1];
-    _memory         = new float[filterOrder];
+    _coefficients.allocate (2 * _filterOrder + 1, true);
+    allocateState();
 }
 
-BrechtsIIRFilter::BrechtsIIRFilter (const BrechtsIIRFilter& other) noexcept
-    :
-      _filterOrder  (other._filterOrder)
-    , _coefficients (other._coefficients) // possible?
-    , _active       (other._active)
+BrechtsIIRFilter::BrechtsIIRFilter (const BrechtsIIRFilter& other)
+    : _filterOrder  (0)
+    , _numSections  (0)
+    , _numChannels  (1)
+    , _stateStride  (4)
+    , _active       (false)
 {
-    _memory = new float[_filterOrder]; //??
+    *this = other;
+}
+
+BrechtsIIRFilter& BrechtsIIRFilter::operator= (const BrechtsIIRFilter& other)
+{
+    if (this != &other)
+    {
+        const SpinLock::ScopedLockType sl (processLock);
+
+        _filterOrder = other._filterOrder;
+        _coefficients.allocate (2 * _filterOrder + 1, false);
+        memcpy (_coefficients, other._coefficients, sizeof (float) * (2 * _filterOrder + 1));
+
+        _numSections = other._numSections;
+        _sections.allocate (jmax (1, 5 * _numSections), true);
+        memcpy (_sections, other._sections, sizeof (float) * 5 * _numSections);
+
+        _numChannels = other._numChannels;
+        _stateStride = other._stateStride;
+        const int stateSize = jmax (1, 2 * _numSections * _stateStride);
+        _state.allocate (stateSize, false);
+        memcpy (_state, other._state, sizeof (float) * stateSize);
+
+        _active = other._active;
+    }
+
+    return *this;
 }
 
 BrechtsIIRFilter::~BrechtsIIRFilter() noexcept
 {
-    delete _coefficients;
-    delete _memory;
 }
 
 //==============================================================================
@@ -41,95 +241,404 @@ void BrechtsIIRFilter::toggleActivity() noexcept
 }
 
 //==============================================================================
-void BrechtsIIRFilter::setCoefficients (float * newCoefficients, int filterOrder) noexcept
+void BrechtsIIRFilter::setCoefficients (const float* newCoefficients, int filterOrder)
 {
-    _coefficients = newCoefficients; //? copy coefficients!!! 
+    jassert (filterOrder >= 0);
+
+    BrechtsIIRFilter newFilter (filterOrder);
+    memcpy (newFilter._coefficients, newCoefficients, sizeof (float) * (2 * newFilter._filterOrder + 1));
+    newFilter.decomposeIntoSections();
+
+    const SpinLock::ScopedLockType sl (processLock);
+
+    _filterOrder = newFilter._filterOrder;
+    _coefficients.swapWith (newFilter._coefficients);
+
+    // keep the filter state if the structure hasn't changed
+    if (_numSections != newFilter._numSections)
+    {
+        _numSections = newFilter._numSections;
+        allocateState();
+    }
+
+    _sections.swapWith (newFilter._sections);
+    _active = true;
+}
+
+void BrechtsIIRFilter::setSections (const IIRCoefficients* sections, int numSections)
+{
+    jassert (numSections >= 0);
+
+    HeapBlock <float> newSections, newCoefficients;
+    newSections.allocate (jmax (1, 5 * numSections), true);
+
+    for (int section = 0; section < numSections; ++section)
+    {
+        memcpy (newSections + 5 * section, sections [section].coefficients, sizeof (float) * 5);
+    }
+
+    // multiply the sections out so getCoefficients() stays meaningful
+    const int newOrder = 2 * numSections;
+    HeapBlock <double> b, a;
+    b.allocate (newOrder + 1, true);
+    a.allocate (newOrder + 1, true);
+    b [0] = a [0] = 1;
+
+    for (int section = 0; section < numSections; ++section)
+    {
+        const float* c = sections [section].coefficients;
+        const int currentOrder = 2 * section;
+
+        for (int i = currentOrder + 2; i >= 0; --i)
+        {
+            double newB = 0, newA = 0;
+
+            for (int tap = 0; tap < 3; ++tap)
+            {
+                if (i - tap >= 0 && i - tap <= currentOrder)
+                {
+                    newB += b [i - tap] * c [tap];
+                    newA += a [i - tap] * (tap == 0 ? 1.0 : c [2 + tap]);
+                }
+            }
+
+            b [i] = newB;
+            a [i] = newA;
+        }
+    }
+
+    newCoefficients.allocate (2 * newOrder + 1, true);
+
+    for (int i = 0; i <= newOrder; ++i)
+    {
+        newCoefficients [i] = (float) b [i];
+    }
+
+    for (int i = 1; i <= newOrder; ++i)
+    {
+        newCoefficients [newOrder + i] = (float) a [i];
+    }
+
+    const SpinLock::ScopedLockType sl (processLock);
+
+    _filterOrder = newOrder;
+    _coefficients.swapWith (newCoefficients);
+
+    if (_numSections != numSections)
+    {
+        _numSections = numSections;
+        allocateState();
+    }
+
+    _sections.swapWith (newSections);
     _active = true;
 }
 
+//==============================================================================
+void BrechtsIIRFilter::setNumChannels (int numChannels)
+{
+    jassert (numChannels > 0);
+
+    const SpinLock::ScopedLockType sl (processLock);
+
+    _numChannels = jmax (1, numChannels);
+    allocateState();
+}
+
 //==============================================================================
 void BrechtsIIRFilter::reset() noexcept
 {
-    // clear _memory
+    const SpinLock::ScopedLockType sl (processLock);
+
+    _state.clear (jmax (1, 2 * _numSections * _stateStride));
 }
 
 //==============================================================================
 float BrechtsIIRFilter::processSingleSampleRaw (const float inputSample) noexcept
 {
-    float out = _coefficients[0] * inputSample + _memory[0];
+    float sample = inputSample;
 
-    
-    //v1 = coefficients.coefficients[1] * in - coefficients.coefficients[3] * out + v2;
-    //v2 = coefficients.coefficients[2] * in - coefficients.coefficients[4] * out;
-    
-    for (int tap = 1; tap < _filterOrder; tap++)
+    for (int section = 0; section < _numSections; ++section)
     {
-        // to be delayed by tap + 1 samples: b_i * x[n] - a_i * y[n] + content of next memory element
-        _memory[tap - 1] = _coefficients[tap] * inputSample - _coefficients[_filterOrder + tap] + _memory[tap];
-        
-        // snap to zero
-        if (_memory[tap - 1] > -1.0e-8 && _memory[tap - 1] > 1.0e-8)
-        {
-            _memory[tap] = 0.0f;
-        }
+        const float* c = _sections + 5 * section;
+        float* v1 = _state + 2 * section * _stateStride;
+        float* v2 = v1 + _stateStride;
+
+        const float in = sample;
+        const float out = c [0] * in + *v1;
+
+        *v1 = c [1] * in - c [3] * out + *v2;
+        *v2 = c [2] * in - c [4] * out;
+
+        sample = out;
     }
-    
-    // last memory element:
-    _memory[_filterOrder - 1] = _coefficients[_filterOrder] * inputSample - _coefficients[2*_filterOrder];
 
-    return out;
+    return sample;
 }
 
 //==============================================================================
 void BrechtsIIRFilter::processSamples (float* const buffer, const int numSamples) noexcept
 {
+    const SpinLock::ScopedLockType sl (processLock);
+
     if (_active)
     {
-        float * mem = new float[_filterOrder];
-        
-        // store memory contents in auxiliary variable (why?)
-        for (int tap = 0; tap < _filterOrder; tap++)
-        {
-            mem[tap] = _memory[tap];
-        }
-        
-        // compute output and write new values to memory elements
-        for (int sample = 0; sample < numSamples; ++sample)
-        {
-            /* For biquad (juce::IIRfilter):
-             * const float in = buffer[sample];
-             * const float out = c0 * in + lv1;
-             * buffer[sample] = out;
-
-             * lv1 = c1 * in - c3 * out + lv2;
-             * lv2 = c2 * in - c4 * out;
-             */
-            
-            // IIR filter Direct Form I
-            float in  = buffer[sample];
-            float out = _coefficients[0] * in + mem[0];
-            buffer[sample] = out;
-            
-            for (int tap = 1; tap < _filterOrder; tap++)
+        processChannel (buffer, numSamples, 0);
+    }
+}
+
+void BrechtsIIRFilter::processSamples (float* const* channels, int numChannels, int numSamples) noexcept
+{
+    const SpinLock::ScopedLockType sl (processLock);
+
+    if (! _active)
+        return;
+
+    jassert (numChannels <= _numChannels);
+    numChannels = jmin (numChannels, _numChannels);
+
+    int channel = 0;
+
+   #if SAFE_USE_SSE_INTRINSICS
+    // four channels at a time, one per lane, interleaved into a short block so
+    // each section can run over all of it with its coefficients broadcast and its
+    // state held in registers
+    const int blockSize = 128;
+    __m128 block [blockSize];
+
+    for (; channel + 3 < numChannels; channel += 4)
+    {
+        float* const channel0 = channels [channel];
+        float* const channel1 = channels [channel + 1];
+        float* const channel2 = channels [channel + 2];
+        float* const channel3 = channels [channel + 3];
+
+        for (int start = 0; start < numSamples; start += blockSize)
+        {
+            const int numThisTime = jmin (blockSize, numSamples - start);
+
+            for (int i = 0; i < numThisTime; ++i)
+            {
+                block [i] = _mm_setr_ps (channel0 [start + i], channel1 [start + i],
+                                         channel2 [start + i], channel3 [start + i]);
+            }
+
+            for (int section = 0; section < _numSections; ++section)
+            {
+                const float* c = _sections + 5 * section;
+                const __m128 c0 = _mm_set1_ps (c [0]);
+                const __m128 c1 = _mm_set1_ps (c [1]);
+                const __m128 c2 = _mm_set1_ps (c [2]);
+                const __m128 c3 = _mm_set1_ps (c [3]);
+                const __m128 c4 = _mm_set1_ps (c [4]);
+
+                float* v1 = _state + 2 * section * _stateStride + channel;
+                float* v2 = v1 + _stateStride;
+                __m128 lv1 = _mm_loadu_ps (v1);
+                __m128 lv2 = _mm_loadu_ps (v2);
+
+                for (int i = 0; i < numThisTime; ++i)
+                {
+                    const __m128 in = block [i];
+                    const __m128 out = _mm_add_ps (_mm_mul_ps (c0, in), lv1);
+                    block [i] = out;
+
+                    lv1 = _mm_add_ps (_mm_sub_ps (_mm_mul_ps (c1, in), _mm_mul_ps (c3, out)), lv2);
+                    lv2 = _mm_sub_ps (_mm_mul_ps (c2, in), _mm_mul_ps (c4, out));
+                }
+
+                _mm_storeu_ps (v1, lv1);
+                _mm_storeu_ps (v2, lv2);
+            }
+
+            for (int i = 0; i < numThisTime; ++i)
             {
-                // to be delayed by tap + 1 samples: b_i * x[n] - a_i * y[n] + content of next memory element
-                mem[tap - 1] = _coefficients[tap] * in - _coefficients[_filterOrder+tap] + mem[tap];
+                float out [4];
+                _mm_storeu_ps (out, block [i]);
+
+                channel0 [start + i] = out [0];
+                channel1 [start + i] = out [1];
+                channel2 [start + i] = out [2];
+                channel3 [start + i] = out [3];
             }
-            
-            // last memory element:
-            mem[_filterOrder - 1] = _coefficients[_filterOrder] * in - _coefficients[2*_filterOrder];
         }
-        
-        for (int tap = 0; tap < _filterOrder; tap++)
+    }
+
+    // processChannel() snaps the state of the rest itself
+    snapStateToZero (channel);
+   #endif
+
+    for (; channel < numChannels; ++channel)
+    {
+        processChannel (channels [channel], numSamples, channel);
+    }
+}
+
+//==============================================================================
+void BrechtsIIRFilter::processChannel (float* samples, int numSamples, int channel) noexcept
+{
+    // one section at a time over the whole block, the block stays in cache
+    // and each section's coefficients and state stay in registers
+    for (int section = 0; section < _numSections; ++section)
+    {
+        const float* c = _sections + 5 * section;
+        const float c0 = c [0];
+        const float c1 = c [1];
+        const float c2 = c [2];
+        const float c3 = c [3];
+        const float c4 = c [4];
+
+        float* v1 = _state + 2 * section * _stateStride + channel;
+        float* v2 = v1 + _stateStride;
+        float lv1 = *v1, lv2 = *v2;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float in = samples [i];
+            const float out = c0 * in + lv1;
+            samples [i] = out;
+
+            lv1 = c1 * in - c3 * out + lv2;
+            lv2 = c2 * in - c4 * out;
+        }
+
+        // snap to zero
+        if (! (lv1 < -1.0e-8 || lv1 > 1.0e-8)) lv1 = 0;
+        if (! (lv2 < -1.0e-8 || lv2 > 1.0e-8)) lv2 = 0;
+
+        *v1 = lv1;
+        *v2 = lv2;
+    }
+}
+
+void BrechtsIIRFilter::snapStateToZero (int numChannelsToSnap) noexcept
+{
+    for (int row = 0; row < 2 * _numSections; ++row)
+    {
+        float* state = _state + row * _stateStride;
+
+        for (int channel = 0; channel < numChannelsToSnap; ++channel)
         {
-            // snap to zero
-            if (mem[tap] > -1.0e-8 && mem[tap] > 1.0e-8)
+            if (! (state [channel] < -1.0e-8 || state [channel] > 1.0e-8))
+                state [channel] = 0;
+        }
+    }
+}
+
+//==============================================================================
+void BrechtsIIRFilter::allocateState()
+{
+    _stateStride = (_numChannels + 3) & ~3;
+    _state.allocate (jmax (1, 2 * _numSections * _stateStride), true);
+}
+
+void BrechtsIIRFilter::decomposeIntoSections()
+{
+    using namespace BrechtsIIRFilterHelpers;
+
+    const int order = _filterOrder;
+    const float* b = _coefficients;
+    const float* a = _coefficients + order;
+
+    // leading zeros in the numerator are delays, which show up as roots at infinity
+    int firstNonZero = 0;
+
+    while (firstNonZero <= order && b [firstNonZero] == 0)
+        ++firstNonZero;
+
+    const double gain = firstNonZero <= order ? b [firstNonZero] : 0.0;
+    const int numFiniteZeros = firstNonZero <= order ? order - firstNonZero : 0;
+
+    HeapBlock <double> numerator, denominator;
+    numerator.allocate (order + 1, true);
+    denominator.allocate (order + 1, true);
+
+    for (int i = 0; i <= numFiniteZeros; ++i)
+    {
+        numerator [i] = b [firstNonZero + i];
+    }
+
+    denominator [0] = 1;
+
+    for (int i = 1; i <= order; ++i)
+    {
+        denominator [i] = a [i];
+    }
+
+    HeapBlock <Complex> zeros, poles;
+    zeros.allocate (jmax (1, order), true);
+    poles.allocate (jmax (1, order), true);
+
+    findRoots (numerator, numFiniteZeros, zeros);
+    findRoots (denominator, order, poles);
+
+    Array <Factor> zeroFactors, poleFactors;
+    buildFactors (zeros, numFiniteZeros, order - numFiniteZeros, zeroFactors);
+    buildFactors (poles, order, 0, poleFactors);
+
+    jassert (zeroFactors.size() == poleFactors.size());
+
+    _numSections = jmax (1, poleFactors.size());
+    _sections.allocate (5 * _numSections, true);
+
+    if (poleFactors.size() == 0)
+    {
+        _sections [0] = (float) gain;
+        return;
+    }
+
+    // pair the poles nearest the unit circle with their closest zeros first,
+    // then run the sections from the least to the most resonant
+    Array <int> poleOrder;
+
+    for (int i = 0; i < poleFactors.size(); ++i)
+    {
+        int insertIndex = 0;
+
+        while (insertIndex < poleOrder.size()
+               && std::abs (poleFactors [poleOrder [insertIndex]].root) >= std::abs (poleFactors [i].root))
+            ++insertIndex;
+
+        poleOrder.insert (insertIndex, i);
+    }
+
+    Array <bool> zeroUsed;
+    zeroUsed.insertMultiple (0, false, zeroFactors.size());
+
+    for (int i = 0; i < poleOrder.size(); ++i)
+    {
+        const Factor& pole = poleFactors [poleOrder [i]];
+
+        int bestZero = -1;
+        double bestDistance = 0;
+
+        for (int j = 0; j < zeroFactors.size(); ++j)
+        {
+            if (zeroUsed [j])
+                continue;
+
+            const double distance = zeroFactors [j].finite ? std::abs (zeroFactors [j].root - pole.root) : 1.0e10;
+
+            if (bestZero < 0 || distance < bestDistance)
             {
-                mem[tap] = 0.0f;
+                bestZero = j;
+                bestDistance = distance;
             }
-            
-            // write auxilary memory element back to internal memory
-            _memory[tap] = mem[tap];
         }
+
+        zeroUsed.set (bestZero, true);
+        const Factor& zero = zeroFactors [bestZero];
+
+        float* c = _sections + 5 * (_numSections - 1 - i);
+        c [0] = (float) zero.c [0];
+        c [1] = (float) zero.c [1];
+        c [2] = (float) zero.c [2];
+        c [3] = (float) pole.c [1];
+        c [4] = (float) pole.c [2];
+    }
+
+    for (int tap = 0; tap < 3; ++tap)
+    {
+        _sections [tap] = (float) (_sections [tap] * gain);
     }
 }
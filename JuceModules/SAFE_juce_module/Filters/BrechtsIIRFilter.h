@@ -8,7 +8,17 @@
 
 //==============================================================================
 /**
-    An IIR filter class for high-order filters. 
+    An IIR filter class for high-order filters.
+
+    The filter keeps its own copy of the coefficients it is given. Internally
+    the transfer function is factored into second order sections which are run
+    one after the other in transposed direct form II, the same structure as the
+    JUCE IIRFilter. All memory is allocated when the coefficients or the number
+    of channels change, so processing never allocates.
+
+    Several channels can share one set of coefficients. Call setNumChannels()
+    and then use the multi channel processSamples(), which runs four channels
+    at a time in SIMD lanes where SSE is available.
 */
 class BrechtsIIRFilter
 {
@@ -23,7 +33,10 @@ public:
     BrechtsIIRFilter(int filterOrder = 1) noexcept;
 
     /** Creates a copy of another filter. */
-    BrechtsIIRFilter (const BrechtsIIRFilter&) noexcept;
+    BrechtsIIRFilter (const BrechtsIIRFilter&);
+
+    /** Copies the coefficients and state of another filter. */
+    BrechtsIIRFilter& operator= (const BrechtsIIRFilter&);
 
     /** Destructor. */
     ~BrechtsIIRFilter() noexcept;
@@ -31,20 +44,60 @@ public:
     //==============================================================================
     /** Sets the filter to active (default if coefficients are set). */
     void makeActive() noexcept;
-    
+
     //==============================================================================
     /** Clears the filter so that any incoming data passes through unchanged. */
     void makeInactive() noexcept;
-    
+
     //==============================================================================
     /** Toggles the filter's activity. */
     void toggleActivity() noexcept;
-    
-    /** Returns the coefficients that this filter is using. */
-    float * getCoefficients() const noexcept    { return _coefficients; }
 
-    /** Applies a set of coefficients to this filter. */
-    void setCoefficients (float * coefficients, int filterOrder) noexcept;
+    /** Returns the coefficients that this filter is using.
+
+        These are laid out as b0 ... bN followed by a1 ... aN, where N is the
+        filter order and a0 has been normalised to 1.
+    */
+    const float* getCoefficients() const noexcept   { return _coefficients; }
+
+    /** Returns the order of the filter. */
+    int getFilterOrder() const noexcept             { return _filterOrder; }
+
+    /** Returns the number of second order sections the filter is run as. */
+    int getNumSections() const noexcept             { return _numSections; }
+
+    /** Applies a set of coefficients to this filter.
+
+        The coefficients are copied so the array can be freed afterwards. The
+        transfer function is factorised into second order sections, but the
+        precision of single precision polynomial coefficients falls off quickly
+        with order, so for high order designs setSections() should be preferred.
+
+        @param coefficients  b0 ... bN followed by a1 ... aN (2N + 1 values)
+        @param filterOrder   the order N of the filter
+    */
+    void setCoefficients (const float* coefficients, int filterOrder);
+
+    /** Applies a cascade of biquads to this filter.
+
+        Use this when the filter is designed as second order sections in the
+        first place, it avoids factorising the transfer function.
+
+        @param sections     an array of biquad coefficients
+        @param numSections  the number of biquads in the array
+    */
+    void setSections (const IIRCoefficients* sections, int numSections);
+
+    //==============================================================================
+    /** Sets the number of channels which will be processed with this filter.
+
+        Each channel keeps its own filter state. This allocates memory so
+        should not be called from the audio thread.
+    */
+    void setNumChannels (int numChannels);
+
+    /** Returns the number of channels the filter has state for. */
+    int getNumChannels() const noexcept             { return _numChannels; }
 
     //==============================================================================
     /** Resets the filter's processing pipeline, ready to start a new stream of data.
@@ -57,23 +110,44 @@ public:
 
     /** Performs the filter operation on one sample. */
     float processSingleSampleRaw (const float inputSample) noexcept;
-    
+
     /** Performs the filter operation on the given set of samples. */
     void processSamples (float* samples, int numSamples) noexcept;
-    
+
+    /** Performs the filter operation on several channels of samples.
+
+        @param channels     an array of pointers to the channels to filter
+        @param numChannels  the number of channels - this should not be more
+                            than the number passed to setNumChannels()
+        @param numSamples   the number of samples in each channel
+    */
+    void processSamples (float* const* channels, int numChannels, int numSamples) noexcept;
+
     // make butterworth LPF/HPF/BPF, shelves, peaking
     // make chebychev
     // make elliptical
-    
+
 protected:
     //==============================================================================
-    // SpinLock processLock; //?
+    SpinLock processLock;
+
     int _filterOrder;
-    float * _coefficients;
-    float * _memory; // memory elements
+    HeapBlock <float> _coefficients;
+
+    int _numSections;
+    HeapBlock <float> _sections; // 5 coefficients per section, as in IIRCoefficients
+
+    int _numChannels, _stateStride;
+    HeapBlock <float> _state; // v1 and v2 for each section and channel
+
     bool _active;
 
-    BrechtsIIRFilter& operator= (const BrechtsIIRFilter&);
+    void allocateState();
+    void decomposeIntoSections();
+    void processChannel (float* samples, int numSamples, int channel) noexcept;
+    void snapStateToZero (int numChannelsToSnap) noexcept;
+
+    JUCE_LEAK_DETECTOR (BrechtsIIRFilter);
 };
 
 
@@ -0,0 +1,176 @@
+namespace DecimatorHelpers
+{
+    // the zeroth order modified bessel function of the first kind, which shapes
+    // the kaiser window
+    static double besselI0 (double x)
+    {
+        double sum = 1, term = 1;
+
+        for (int k = 1; term > 1.0e-17 * sum; ++k)
+        {
+            const double halfXOverK = x / (2.0 * k);
+            term *= halfXOverK * halfXOverK;
+            sum += term;
+        }
+
+        return sum;
+    }
+}
+
+//=================================================================================
+//  Constructor and Destructor
+//=================================================================================
+Decimator::Decimator()
+    : factor (0),
+      numTaps (0),
+      delay (0)
+{
+    setDecimationFactor (1);
+}
+
+Decimator::~Decimator()
+{
+}
+
+//=================================================================================
+//  Set and Get Factor
+//=================================================================================
+void Decimator::setDecimationFactor (int newFactor)
+{
+    jassert (newFactor >= 1);
+    newFactor = jmax (1, newFactor);
+
+    if (newFactor == factor)
+    {
+        return;
+    }
+
+    factor = newFactor;
+
+    if (factor == 1)
+    {
+        numTaps = 1;
+        delay = 0;
+        coefficients.allocate (numTaps, false);
+        coefficients [0] = 1.0;
+        return;
+    }
+
+    // an odd length keeps the delay a whole number of samples
+    numTaps = factor * numTapsPerPhase + 1;
+    delay = (numTaps - 1) / 2;
+    coefficients.allocate (numTaps, false);
+
+    // cut off a little below the new nyquist frequency, with a kaiser window this
+    // keeps anything which would alias below 20 kHz more than 78 dB down at an output
+    // rate of 44.1 kHz, which a blackman window of the same length can't manage
+    const double cutoff = 0.48 / factor;
+    const double beta = 8.5;
+    const double windowScale = 1.0 / DecimatorHelpers::besselI0 (beta);
+    double sum = 0;
+
+    for (int i = 0; i < numTaps; ++i)
+    {
+        // worked out from the distance to the centre, so the filter is exactly symmetric
+        const double n = i - delay;
+        const double sinc = n == 0 ? 2.0 * cutoff : std::sin (2.0 * double_Pi * cutoff * n) / (double_Pi * n);
+        const double position = n / delay;
+        const double window = DecimatorHelpers::besselI0 (beta * std::sqrt (1.0 - position * position)) * windowScale;
+
+        coefficients [i] = sinc * window;
+        sum += coefficients [i];
+    }
+
+    // unity gain at dc
+    for (int i = 0; i < numTaps; ++i)
+    {
+        coefficients [i] /= sum;
+    }
+}
+
+int Decimator::getDecimationFactor() const
+{
+    return factor;
+}
+
+int Decimator::getDelay() const
+{
+    return delay;
+}
+
+int Decimator::getStretchMargin() const
+{
+    return (delay + factor - 1) / factor * factor;
+}
+
+int Decimator::getFactorForSampleRate (double sampleRate, double minimumOutputRate)
+{
+    return jmax (1, (int) (sampleRate / minimumOutputRate));
+}
+
+//=================================================================================
+//  Process Some Audio
+//=================================================================================
+void Decimator::decimate (const float* input, int numInputSamples, int firstOutputSample,
+                          double* output, int numOutputSamples) const
+{
+    for (int n = 0; n < numOutputSamples; ++n)
+    {
+        // the filter is symmetric, so it can run forwards over the input
+        const int start = (firstOutputSample + n) * factor - delay;
+        double sum = 0;
+
+        if (start >= 0 && start + numTaps <= numInputSamples)
+        {
+            // four separate sums so the additions don't have to wait for each other
+            const float* inputSamples = input + start;
+            double sums [4] = {0, 0, 0, 0};
+            int i = 0;
+
+            for (; i + 4 <= numTaps; i += 4)
+            {
+                sums [0] += coefficients [i] * inputSamples [i];
+                sums [1] += coefficients [i + 1] * inputSamples [i + 1];
+                sums [2] += coefficients [i + 2] * inputSamples [i + 2];
+                sums [3] += coefficients [i + 3] * inputSamples [i + 3];
+            }
+
+            for (; i < numTaps; ++i)
+            {
+                sums [0] += coefficients [i] * inputSamples [i];
+            }
+
+            sum = (sums [0] + sums [1]) + (sums [2] + sums [3]);
+        }
+        else
+        {
+            // the same sums in the same order, so a stretch of a recording padded
+            // with zeros decimates exactly as the whole recording does
+            double sums [4] = {0, 0, 0, 0};
+            int i = 0;
+
+            for (; i + 4 <= numTaps; i += 4)
+            {
+                for (int j = 0; j < 4; ++j)
+                {
+                    if (isPositiveAndBelow (start + i + j, numInputSamples))
+                    {
+                        sums [j] += coefficients [i + j] * input [start + i + j];
+                    }
+                }
+            }
+
+            for (; i < numTaps; ++i)
+            {
+                if (isPositiveAndBelow (start + i, numInputSamples))
+                {
+                    sums [0] += coefficients [i] * input [start + i];
+                }
+            }
+
+            sum = (sums [0] + sums [1]) + (sums [2] + sums [3]);
+        }
+
+        output [n] = sum;
+    }
+}
@@ -0,0 +1,93 @@
+#ifndef __DECIMATOR__
+#define __DECIMATOR__
+
+/** A linear phase FIR decimator.
+ *
+ *  Reduces the sample rate of a recording by an integer factor, low pass filtering
+ *  it with a windowed sinc filter first so nothing aliases. Only the samples which
+ *  are kept are filtered, which is what the polyphase form of a decimator saves
+ *  over filtering everything and then throwing samples away, so the cost is the
+ *  same per output sample whatever the factor.
+ *
+ *  The whole recording is passed in each time, so any stretch of the output can be
+ *  worked out on its own and the filter's delay is taken out. Recordings too long to
+ *  hold in memory can be passed in a stretch at a time, see getDelay().
+ */
+class Decimator
+{
+public:
+    //=============================================================================
+    //  Constructor and Destructor
+    //=============================================================================
+    /** Create a new decimator which leaves the sample rate alone. */
+    Decimator();
+
+    /** Destructor */
+    ~Decimator();
+
+    //=============================================================================
+    //  Set and Get Factor
+    //=============================================================================
+    /** Set the factor to reduce the sample rate by.
+     *
+     *  This works out a new set of filter coefficients.
+     *
+     *  @param newFactor  the new decimation factor, 1 passes the audio through as it is
+     */
+    void setDecimationFactor (int newFactor);
+
+    /** Returns the factor the sample rate is reduced by. */
+    int getDecimationFactor() const;
+
+    /** Returns the largest factor which keeps the output at or above a given rate.
+     *
+     *  @param sampleRate         the sample rate of the audio to decimate
+     *  @param minimumOutputRate  the lowest sample rate to decimate to
+     */
+    static int getFactorForSampleRate (double sampleRate, double minimumOutputRate);
+
+    /** Returns the number of input samples either side of an output sample which
+     *  the filter looks at.
+     *
+     *  A stretch of a recording passed to decimate() needs this many extra samples
+     *  at each end for its output to match decimating the whole recording.
+     */
+    int getDelay() const;
+
+    /** Returns getDelay() rounded up to a whole number of output samples.
+     *
+     *  Reading a stretch of a long recording with this many extra samples at each end
+     *  keeps the stretch's decimated samples lined up with the whole recording's.
+     */
+    int getStretchMargin() const;
+
+    //=============================================================================
+    //  Process Some Audio
+    //=============================================================================
+    /** Work out a stretch of the decimated recording.
+     *
+     *  Samples before the start and after the end of the recording are taken as zero.
+     *
+     *  @param input              the whole recording at the original sample rate
+     *  @param numInputSamples    the number of samples in the recording
+     *  @param firstOutputSample  the index of the first decimated sample to work out
+     *  @param output             an array to write the decimated samples to
+     *  @param numOutputSamples   the number of decimated samples to work out
+     */
+    void decimate (const float* input, int numInputSamples, int firstOutputSample,
+                   double* output, int numOutputSamples) const;
+
+private:
+    //=============================================================================
+    //  Filter Bits
+    //=============================================================================
+    static const int numTapsPerPhase = 48;
+
+    int factor;
+    int numTaps, delay;
+    HeapBlock <double> coefficients;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Decimator);
+};
+
+#endif // __DECIMATOR__
@@ -3,17 +3,16 @@
 //=================================================================================
 QuadratureFilter::QuadratureFilter()
 {
-    realFilter1.setCoefficient (0.6923878);
-    realFilter2.setCoefficient (0.9360654322959);
-    realFilter3.setCoefficient (0.9882295226860);
-    realFilter4.setCoefficient (0.9987488452737);
+    const float realCoefficients [numStages] = {0.6923878f, 0.9360654322959f, 0.9882295226860f, 0.9987488452737f};
+    const float imagCoefficients [numStages] = {0.4021921162426f, 0.8561710882420f, 0.9722909545651f, 0.9952884791278f};
 
-    imagFilter1.setCoefficient (0.4021921162426);
-    imagFilter2.setCoefficient (0.8561710882420);
-    imagFilter3.setCoefficient (0.9722909545651);
-    imagFilter4.setCoefficient (0.9952884791278);
+    for (int stage = 0; stage < numStages; ++stage)
+    {
+        coefficients [stage][0] = coefficients [stage][1] = realCoefficients [stage] * realCoefficients [stage];
+        coefficients [stage][2] = coefficients [stage][3] = imagCoefficients [stage] * imagCoefficients [stage];
+    }
 
-    delayCounter = 0;
+    reset();
 }
 
 QuadratureFilter::~QuadratureFilter()
@@ -25,17 +24,13 @@ QuadratureFilter::~QuadratureFilter()
 //=================================================================================
 void QuadratureFilter::reset()
 {
-    realFilter1.reset();
-    realFilter2.reset();
-    realFilter3.reset();
-    realFilter4.reset();
-
-    imagFilter1.reset();
-    imagFilter2.reset();
-    imagFilter3.reset();
-    imagFilter4.reset();
-    
-    FloatVectorOperations::clear (delaySamples, 2);
+    for (int stage = 0; stage < numStages; ++stage)
+    {
+        FloatVectorOperations::clear (inputState [stage], numLanes);
+        FloatVectorOperations::clear (outputState [stage], numLanes);
+    }
+
+    delayedReal = 0;
 }
 
 //=================================================================================
@@ -43,25 +38,118 @@ void QuadratureFilter::reset()
 //=================================================================================
 void QuadratureFilter::processSamples (const float* input, float* realOutput, float* imagOutput, int numSamples)
 {
-    FloatVectorOperations::copy (realOutput, input, numSamples);
-    FloatVectorOperations::copy (imagOutput, input, numSamples);
+    int i = 0;
+
+   #if SAFE_USE_SSE_INTRINSICS
+    __m128 c [numStages], xState [numStages], yState [numStages];
+
+    for (int stage = 0; stage < numStages; ++stage)
+    {
+        c [stage] = _mm_loadu_ps (coefficients [stage]);
+        xState [stage] = _mm_loadu_ps (inputState [stage]);
+        yState [stage] = _mm_loadu_ps (outputState [stage]);
+    }
+
+    const __m128 denormalThreshold = _mm_set1_ps (1.0e-8f);
+    const __m128 signMask = _mm_set1_ps (-0.0f);
+
+    for (; i < numSamples - 1; i += 2)
+    {
+        __m128 x = _mm_setr_ps (input [i], input [i + 1], input [i], input [i + 1]);
+
+        for (int stage = 0; stage < numStages; ++stage)
+        {
+            __m128 y = _mm_sub_ps (_mm_mul_ps (c [stage], _mm_add_ps (x, yState [stage])), xState [stage]);
+            xState [stage] = x;
+
+            // deal with those pesky denormals, the next stage still gets the unsnapped output
+            yState [stage] = _mm_and_ps (y, _mm_cmpgt_ps (_mm_andnot_ps (signMask, y), denormalThreshold));
+            x = y;
+        }
+
+        float out [numLanes];
+        _mm_storeu_ps (out, x);
+
+        realOutput [i] = delayedReal;
+        realOutput [i + 1] = out [0];
+        delayedReal = out [1];
+
+        imagOutput [i] = - out [2];
+        imagOutput [i + 1] = - out [3];
+    }
+
+    for (int stage = 0; stage < numStages; ++stage)
+    {
+        _mm_storeu_ps (inputState [stage], xState [stage]);
+        _mm_storeu_ps (outputState [stage], yState [stage]);
+    }
+   #else
+    for (; i < numSamples - 1; i += 2)
+    {
+        float x [numLanes] = {input [i], input [i + 1], input [i], input [i + 1]};
+
+        for (int stage = 0; stage < numStages; ++stage)
+        {
+            for (int lane = 0; lane < numLanes; ++lane)
+            {
+                float y = coefficients [stage][lane] * (x [lane] + outputState [stage][lane]) - inputState [stage][lane];
+                inputState [stage][lane] = x [lane];
+                outputState [stage][lane] = snapToZero (y);
+                x [lane] = y;
+            }
+        }
+
+        realOutput [i] = delayedReal;
+        realOutput [i + 1] = x [0];
+        delayedReal = x [1];
+
+        imagOutput [i] = - x [2];
+        imagOutput [i + 1] = - x [3];
+    }
+   #endif
+
+    if (i < numSamples)
+    {
+        processSingleSample (input [i], realOutput [i], imagOutput [i]);
+    }
+}
 
-    realFilter1.processSamples (realOutput, numSamples);
-    realFilter2.processSamples (realOutput, numSamples);
-    realFilter3.processSamples (realOutput, numSamples);
-    realFilter4.processSamples (realOutput, numSamples);
+void QuadratureFilter::processSingleSample (float input, float& realOutput, float& imagOutput) noexcept
+{
+    // Runs the even lanes on their own then moves the odd lanes down so the
+    // next block starts with its first sample in the even lanes again.
+    float realSample = input, imagSample = input;
 
-    delaySamples [delayCounter] = realOutput [numSamples - 1];
-    for (int sampleNumber = numSamples - 1; sampleNumber > 0; --sampleNumber)
+    for (int stage = 0; stage < numStages; ++stage)
     {
-        realOutput [sampleNumber] = realOutput [sampleNumber - 1];
+        float* x = inputState [stage];
+        float* y = outputState [stage];
+
+        float realY = coefficients [stage][0] * (realSample + y [0]) - x [0];
+        float imagY = coefficients [stage][2] * (imagSample + y [2]) - x [2];
+
+        x [0] = x [1];
+        x [1] = realSample;
+        y [0] = y [1];
+        y [1] = snapToZero (realY);
+
+        x [2] = x [3];
+        x [3] = imagSample;
+        y [2] = y [3];
+        y [3] = snapToZero (imagY);
+
+        realSample = realY;
+        imagSample = imagY;
     }
-    delayCounter = 1 - delayCounter;
-    realOutput [0] = delaySamples [delayCounter];
-
-    imagFilter1.processSamples (imagOutput, numSamples);
-    imagFilter2.processSamples (imagOutput, numSamples);
-    imagFilter3.processSamples (imagOutput, numSamples);
-    imagFilter4.processSamples (imagOutput, numSamples);
-    FloatVectorOperations::multiply (imagOutput, -1, numSamples);
+
+    realOutput = delayedReal;
+    delayedReal = realSample;
+
+    imagOutput = - imagSample;
+}
+
+float QuadratureFilter::snapToZero (float value) noexcept
+{
+    // deal with those pesky denormals
+    return (value < -1.0e-8 || value > 1.0e-8) ? value : 0;
 }
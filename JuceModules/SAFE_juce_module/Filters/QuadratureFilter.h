@@ -56,15 +56,23 @@ public:
 
 private:
     //=============================================================================
-    //  Filters
+    //  Filter Bits
     //=============================================================================
-    AllPassFilter realFilter1, realFilter2, realFilter3, realFilter4, imagFilter1, imagFilter2, imagFilter3, imagFilter4;
-    
+    // Each allpass stage has the form y[n] = a^2 (x[n] + y[n-2]) - x[n-2] so
+    // even and odd samples never interact. Both cascades are run together on
+    // four lanes: real even, real odd, imaginary even, imaginary odd.
+    enum {numStages = 4, numLanes = 4};
+
+    float coefficients [numStages][numLanes];
+    float inputState [numStages][numLanes], outputState [numStages][numLanes];
+
     //=============================================================================
     //  Delay Bits
     //=============================================================================
-    float delaySamples [2];
-    int delayCounter;
+    float delayedReal;
+
+    void processSingleSample (float input, float& realOutput, float& imagOutput) noexcept;
+    static float snapToZero (float value) noexcept;
 };
 
 #endif // __QUADRATUREFILTER__
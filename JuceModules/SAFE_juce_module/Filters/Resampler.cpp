@@ -4,19 +4,6 @@ Resampler::Resampler(int newResamplingRatio, float newCutoffFrequency, int newAn
     _cutoffFrequency            = newCutoffFrequency;
     _antiAliasingFilterOrder    = newAntiAliasingFilterOrder;
     
-    // clear and allocate storage for filter arrays
-    _antiAliasingFilterDown.clear();
-    _antiAliasingFilterDown.ensureStorageAllocated(_antiAliasingFilterOrder);
-    _antiAliasingFilterUp.clear();
-    _antiAliasingFilterUp.ensureStorageAllocated(_antiAliasingFilterOrder);
-    
-    // add _antiAliasingFilterOrder filters
-    for (int filterNr = 0; filterNr < _antiAliasingFilterOrder; filterNr++)
-    {
-        _antiAliasingFilterDown.add(new juce::IIRFilter);
-        _antiAliasingFilterUp.add(new juce::IIRFilter);
-    }
-    
     UpdateAntiAliasingFilters();
 }
 
@@ -49,10 +36,7 @@ void Resampler::upsample(float* inputBuffer,    // low sampling rate signal
     }
     
     // apply high order low pass filter at cutoff (cascade of biquads)
-    for (int filterNr = 0; filterNr < _antiAliasingFilterOrder; filterNr++)
-    {
-        _antiAliasingFilterUp[filterNr]->processSamples(outputBuffer, numSamples*_resamplingRatio);
-    }
+    _antiAliasingFilterUp.processSamples(outputBuffer, numSamples*_resamplingRatio);
 }
 
 void Resampler::downsample(float* inputBuffer,  // high sampling rate signal
@@ -60,10 +44,7 @@ void Resampler::downsample(float* inputBuffer,  // high sampling rate signal
                            int numSamples)      // number of samples in OUTPUT buffer
 {
     // apply high order low pass filter at cutoff (cascade of biquads)
-    for (int filterNr = 0; filterNr < _antiAliasingFilterOrder; filterNr++)
-    {
-        _antiAliasingFilterDown[filterNr]->processSamples(inputBuffer, numSamples*_resamplingRatio);
-    }
+    _antiAliasingFilterDown.processSamples(inputBuffer, numSamples*_resamplingRatio);
     
     // copy every [resamplingRatio]th input sample to outputBuffer
     for (int sample = 0; sample < numSamples; sample++)
@@ -79,9 +60,13 @@ void Resampler::UpdateAntiAliasingFilters(){
     filterCoefficients = juce::IIRCoefficients::makeLowPass(_resamplingRatio, _cutoffFrequency/2.0);
     
     // set these coefficients for every filter (cascade of biquads)
+    HeapBlock<juce::IIRCoefficients> sections(_antiAliasingFilterOrder);
+    
     for (int filterNr = 0; filterNr < _antiAliasingFilterOrder; filterNr++)
     {
-        _antiAliasingFilterUp[filterNr]->setCoefficients(filterCoefficients);
-        _antiAliasingFilterDown[filterNr]->setCoefficients(filterCoefficients);
+        sections[filterNr] = filterCoefficients;
     }
+    
+    _antiAliasingFilterUp.setSections(sections, _antiAliasingFilterOrder);
+    _antiAliasingFilterDown.setSections(sections, _antiAliasingFilterOrder);
 }
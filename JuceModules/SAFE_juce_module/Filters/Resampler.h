@@ -54,9 +54,8 @@ private:
     int _antiAliasingFilterOrder;
     
     // anti-aliasing filters (to be replaced with better ones)
-    OwnedArray<juce::IIRFilter> _antiAliasingFilterUp;
-    OwnedArray<juce::IIRFilter> _antiAliasingFilterDown;
-    // replace by modifiable series of biquads?
+    BrechtsIIRFilter _antiAliasingFilterUp;
+    BrechtsIIRFilter _antiAliasingFilterDown;
     
 	JUCE_LEAK_DETECTOR (Resampler);
 };
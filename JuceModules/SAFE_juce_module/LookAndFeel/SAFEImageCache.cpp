@@ -0,0 +1,84 @@
+//==========================================================================
+//      Constructor and Destructor
+//==========================================================================
+SAFEImageCache::SAFEImageCache()
+{
+}
+
+SAFEImageCache::~SAFEImageCache()
+{
+}
+
+//==========================================================================
+//      Getting Images
+//==========================================================================
+Image SAFEImageCache::getImage (const char* imageData, int imageDataSize)
+{
+    const ScopedLock sl (lock);
+
+    // original images are stored with a size of zero
+    if (CachedImage* cachedImage = findImage (imageData, 0, 0))
+    {
+        return cachedImage->image;
+    }
+
+    CachedImage* newImage = images.add (new CachedImage);
+    newImage->data = imageData;
+    newImage->width = newImage->height = 0;
+    newImage->image = ImageFileFormat::loadFrom (imageData, (size_t) imageDataSize);
+
+    return newImage->image;
+}
+
+Image SAFEImageCache::getScaledImage (const char* imageData, int imageDataSize, int width, int height)
+{
+    const ScopedLock sl (lock);
+
+    Image original = getImage (imageData, imageDataSize);
+
+    // enlarging an image doesn't add any detail, so it isn't worth the memory
+    if (width <= 0 || height <= 0 || width >= original.getWidth() || height >= original.getHeight())
+    {
+        return original;
+    }
+
+    if (CachedImage* cachedImage = findImage (imageData, width, height))
+    {
+        return cachedImage->image;
+    }
+
+    CachedImage* newImage = images.add (new CachedImage);
+    newImage->data = imageData;
+    newImage->width = width;
+    newImage->height = height;
+    newImage->image = original.rescaled (width, height, Graphics::highResamplingQuality);
+
+    return newImage->image;
+}
+
+SAFEImageCache::CachedImage* SAFEImageCache::findImage (const char* imageData, int width, int height) const
+{
+    for (int i = 0; i < images.size(); ++i)
+    {
+        CachedImage* cachedImage = images.getUnchecked (i);
+
+        if (cachedImage->data == imageData && cachedImage->width == width && cachedImage->height == height)
+        {
+            return cachedImage;
+        }
+    }
+
+    return nullptr;
+}
+
+//==========================================================================
+//      Drawing Images
+//==========================================================================
+void SAFEImageCache::drawImage (Graphics& g, const char* imageData, int imageDataSize, const Rectangle <int>& area)
+{
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+
+    Image imageToDraw = getScaledImage (imageData, imageDataSize, roundToInt (area.getWidth() * scale), roundToInt (area.getHeight() * scale));
+
+    g.drawImage (imageToDraw, area.getX(), area.getY(), area.getWidth(), area.getHeight(), 0, 0, imageToDraw.getWidth(), imageToDraw.getHeight());
+}
@@ -0,0 +1,83 @@
+#ifndef __SAFEIMAGECACHE__
+#define __SAFEIMAGECACHE__
+
+/**
+ *  A cache of the decoded SAFEImages shared by every editor in the process.
+ *
+ *  Hold one of these with a SharedResourcePointer. Images are only decoded the
+ *  first time something asks for them, so an image which is never shown, like the
+ *  info pane or a button mode which isn't used, is never decoded. Once decoded an
+ *  image is shared by every instance until the last SharedResourcePointer goes, at
+ *  which point they are all freed.
+ *
+ *  Images can also be fetched at a particular size. These copies are resampled
+ *  once and cached too, so a component can draw them one to one on the screen
+ *  rather than scaling the original on every paint.
+ */
+class SAFEImageCache
+{
+public:
+    //==========================================================================
+    //      Constructor and Destructor
+    //==========================================================================
+    /** Create a new cache, use a SharedResourcePointer rather than making your own. */
+    SAFEImageCache();
+
+    /** Destructor */
+    ~SAFEImageCache();
+
+    //==========================================================================
+    //      Getting Images
+    //==========================================================================
+    /** Returns one of the SAFEImages, decoding it if this is the first time it is used.
+     *
+     *  @param imageData      the image data, e.g. SAFEImages::record_png
+     *  @param imageDataSize  the size of the data, e.g. SAFEImages::record_pngSize
+     */
+    Image getImage (const char* imageData, int imageDataSize);
+
+    /** Returns one of the SAFEImages resampled to a smaller size.
+     *
+     *  Images are never enlarged, if the size isn't smaller than the original the
+     *  original is returned.
+     *
+     *  @param imageData      the image data, e.g. SAFEImages::record_png
+     *  @param imageDataSize  the size of the data, e.g. SAFEImages::record_pngSize
+     *  @param width          the width to resample the image to, in physical pixels
+     *  @param height         the height to resample the image to, in physical pixels
+     */
+    Image getScaledImage (const char* imageData, int imageDataSize, int width, int height);
+
+    //==========================================================================
+    //      Drawing Images
+    //==========================================================================
+    /** Draw one of the SAFEImages stretched to fill an area.
+     *
+     *  If the area is smaller on the screen than the image, the image is resampled
+     *  to that size the first time it is drawn there, so later paints don't have
+     *  to scale it.
+     *
+     *  @param g              the graphics context to draw into
+     *  @param imageData      the image data
+     *  @param imageDataSize  the size of the data
+     *  @param area           the area to fill with the image
+     */
+    void drawImage (Graphics& g, const char* imageData, int imageDataSize, const Rectangle <int>& area);
+
+private:
+    struct CachedImage
+    {
+        const char* data;
+        int width, height;
+        Image image;
+    };
+
+    CriticalSection lock;
+    OwnedArray <CachedImage> images;
+
+    CachedImage* findImage (const char* imageData, int width, int height) const;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SAFEImageCache)
+};
+
+#endif // __SAFEIMAGECACHE__
@@ -1,26 +1,8 @@
-#ifndef IMAGE_DIRECTORY
-#define IMAGE_DIRECTORY File::getSpecialLocation (File::currentExecutableFile)
-#endif
-
 //==========================================================================
 //      Constructor and Destructor
 //==========================================================================
 SAFELookAndFeel::SAFELookAndFeel()
 {
-    File imageDirectory (IMAGE_DIRECTORY);
-
-    // load the slider images
-//    File greenSliderFile = imageDirectory.getChildFile ("Images/knob_green.png");
-//    greenSliderImage = ImageCache::getFromFile (greenSliderFile);
-//    File redSliderFile = imageDirectory.getChildFile ("Images/knob_red.png");
-//    redSliderImage = ImageCache::getFromFile (redSliderFile);
-//    File yellowSliderFile = imageDirectory.getChildFile ("Images/knob_yellow.png");
-//    yellowSliderImage = ImageCache::getFromFile (yellowSliderFile);
-
-    greenSliderImage    = ImageCache::getFromMemory(SAFEImages::knob_green_png, SAFEImages::knob_green_pngSize);
-    redSliderImage      = ImageCache::getFromMemory(SAFEImages::knob_red_png, SAFEImages::knob_red_pngSize);
-    yellowSliderImage   = ImageCache::getFromMemory(SAFEImages::knob_yellow_png, SAFEImages::knob_yellow_pngSize);
-
     setColour (ScrollBar::thumbColourId, Colours::black);
 }
 
@@ -34,27 +16,32 @@ SAFELookAndFeel::~SAFELookAndFeel()
 void SAFELookAndFeel::drawRotarySlider (Graphics &g, int /*x*/, int /*y*/, int width, int height, float sliderPosProportional, float /*rotaryStartAngle*/, float /*rotaryEndAngle*/, Slider &slider)
 {
     // select the relevant image
-    Image imageToDraw;
+    const char* imageData;
+    int imageDataSize;
     Colour sliderColour = slider.findColour (Slider::rotarySliderFillColourId);
 
     if (sliderColour == SAFEColours::green)
     {
-        imageToDraw = greenSliderImage;
+        imageData = SAFEImages::knob_green_png;
+        imageDataSize = SAFEImages::knob_green_pngSize;
     }
     else if (sliderColour == SAFEColours::red)
     {
-        imageToDraw = redSliderImage;
+        imageData = SAFEImages::knob_red_png;
+        imageDataSize = SAFEImages::knob_red_pngSize;
     }
     else
     {
-        imageToDraw = yellowSliderImage;
+        imageData = SAFEImages::knob_yellow_png;
+        imageDataSize = SAFEImages::knob_yellow_pngSize;
     }
 
     // apply a transform to the image and draw it
     AffineTransform transform;
 
-    int imageWidth = imageToDraw.getWidth();
-    int imageHeight = imageToDraw.getHeight();
+    Image originalImage = images->getImage (imageData, imageDataSize);
+    int imageWidth = originalImage.getWidth();
+    int imageHeight = originalImage.getHeight();
     
     float widthFactor = (float) width / imageWidth;
     float heightFactor = (float) height / imageHeight;
@@ -75,7 +62,11 @@ void SAFELookAndFeel::drawRotarySlider (Graphics &g, int /*x*/, int /*y*/, int w
         yTranslate = (height - imageHeight * minFactor) / 2;
     }
 
-    transform = transform.scaled (minFactor);
+    // the image is resampled once to the size it is on screen, so each paint only has to rotate it
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    Image imageToDraw = images->getScaledImage (imageData, imageDataSize, roundToInt (imageWidth * minFactor * scale), roundToInt (imageHeight * minFactor * scale));
+
+    transform = transform.scaled (imageWidth * minFactor / imageToDraw.getWidth(), imageHeight * minFactor / imageToDraw.getHeight());
     transform = transform.translated (xTranslate, yTranslate);
 
     float sliderRange = 3.0f * float_Pi / 2.0f;
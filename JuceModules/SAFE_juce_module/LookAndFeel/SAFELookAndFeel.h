@@ -32,7 +32,7 @@ public:
     void drawTextEditorOutline (Graphics &g, int width, int height, TextEditor &textEditor);
 
 private:
-    Image greenSliderImage, redSliderImage, yellowSliderImage;
+    SharedResourcePointer <SAFEImageCache> images;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SAFELookAndFeel)
 };
@@ -1,28 +1,63 @@
 LibXtractHolder::LibXtractHolder ()
 {
+    frameLength = ANALYSIS_FRAME_LENGTH;
+
     // initialise the libxtract fft stuff
-    xtract_init_fft (ANALYSIS_FRAME_LENGTH, XTRACT_SPECTRUM);
+    xtract_init_fft (frameLength, XTRACT_SPECTRUM);
 
     barkBandLimits.allocate (26, true);
 
     melFilters.n_filters = 13;
-    melFilters.filters = new double* [13];
+    allocateMelFilters();
+}
+
+LibXtractHolder::~LibXtractHolder ()
+{
+    freeMelFilters();
+
+    // free the libxtract fft stuff (important when we link statically)
+    xtract_free_fft();
+}
+
+void LibXtractHolder::setFrameLength (int newFrameLength)
+{
+    jassert (isPowerOfTwo (newFrameLength));
 
-    for (int n = 0; n < 13; ++n)
+    if (newFrameLength == frameLength)
     {
-        melFilters.filters [n] = new double [ANALYSIS_FRAME_LENGTH];
+        return;
     }
+
+    frameLength = newFrameLength;
+
+    // this frees the old fft data before setting up the new one
+    xtract_init_fft (frameLength, XTRACT_SPECTRUM);
+
+    freeMelFilters();
+    allocateMelFilters();
 }
 
-LibXtractHolder::~LibXtractHolder ()
+int LibXtractHolder::getFrameLength() const
+{
+    return frameLength;
+}
+
+void LibXtractHolder::allocateMelFilters()
 {
-    for (int n = 0; n < 13; ++n)
+    melFilters.filters = new double* [melFilters.n_filters];
+
+    for (int n = 0; n < melFilters.n_filters; ++n)
+    {
+        melFilters.filters [n] = new double [frameLength];
+    }
+}
+
+void LibXtractHolder::freeMelFilters()
+{
+    for (int n = 0; n < melFilters.n_filters; ++n)
     {
         delete[] melFilters.filters [n];
     }
 
     delete[] melFilters.filters;
-
-    // free the libxtract fft stuff (important when we link statically)
-    xtract_free_fft();
 }
@@ -13,10 +13,35 @@ public:
     /** Clean up and instance of libXtract. */
     ~LibXtractHolder ();
 
+    /** Set up the libXtract FFT and mel filters for a given frame length.
+     *
+     *  The FFT set up is global to libXtract, so every feature extractor in
+     *  the process has to use the same frame length.
+     *
+     *  @param newFrameLength  the analysis frame length - this must be a power of two
+     */
+    void setFrameLength (int newFrameLength);
+
+    /** Returns the frame length libXtract is set up for. */
+    int getFrameLength() const;
+
     HeapBlock <int> barkBandLimits; /**< The libXtract bark band limits. */
 
     xtract_mel_filter melFilters; /**< The libXtract mel filters. */
 
+    /** Hold this while setting up or using libXtract.
+     *
+     *  libXtract keeps its FFT tables, the state of its fundamental tracker and
+     *  the filters above in globals, so only one thread in the process can use it
+     *  at a time.
+     */
+    CriticalSection lock;
+
+private:
+    int frameLength;
+
+    void allocateMelFilters();
+    void freeMelFilters();
 };
 
 #endif // __LIBXTRACTHOLDER__
@@ -20,17 +20,48 @@ SAFEAudioProcessor::AnalysisThread::~AnalysisThread()
 //==========================================================================
 void SAFEAudioProcessor::AnalysisThread::run()
 {
-    GenericScopedLock <SpinLock> lock (mutex);
-
+    // trace the save if asked to
+    ScopedPointer <SAFETrace> trace (SAFETrace::isEnabled() ? new SAFETrace() : nullptr);
     WarningID warning;
 
-    if (sendToServer)
     {
-        warning = processor->sendDataToServer (descriptors, metaData);
+        SAFETrace::ScopedEvent saveEvent (trace, "Save", "save");
+        saveEvent.setArgument ("sendToServer", sendToServer);
+
+        if (trace != nullptr)
+        {
+            trace->addEvent ("Capture", "capture", processor->captureStartTicks, processor->captureEndTicks,
+                             processor->captureThreadID, "Audio Thread");
+        }
+
+        // only one plug-in saves at a time, so show how long this one waited
+        const int64 waitStartTicks = Time::getHighResolutionTicks();
+        GenericScopedLock <SpinLock> lock (mutex);
+
+        if (trace != nullptr)
+        {
+            trace->addEvent ("Wait For Other Saves", "save", waitStartTicks, Time::getHighResolutionTicks(),
+                             getThreadId(), getThreadName());
+        }
+
+        processor->currentTrace = trace;
+
+        if (sendToServer)
+        {
+            warning = processor->sendDataToServer (descriptors, metaData);
+        }
+        else
+        {
+            warning = processor->saveSemanticData (descriptors, metaData);
+        }
+
+        processor->currentTrace = nullptr;
     }
-    else
+
+    if (trace != nullptr)
     {
-        warning = processor->saveSemanticData (descriptors, metaData);
+        String traceName = JucePlugin_Name + Time::getCurrentTime().formatted ("_%Y%m%d_%H%M%S");
+        trace->writeToFile (SAFETrace::getTraceDirectory().getNonexistentChildFile (traceName, ".json", false));
     }
 
     if (warning != NoWarning)
@@ -67,13 +98,12 @@ SAFEAudioProcessor::SAFEAudioProcessor()
     // reset tap values
     unprocessedTap = processedTap = 0;
 
-    // get the semantic data file set up
-    initialiseSemanticDataFile();
-
     playHead.resetToDefault();
 
     recording = false;
     readyToSave = true;
+    longRecording = false;
+    numLongRecordingSamples = 0;
 
     numInputs = 1;
     numOutputs = 1;
@@ -83,10 +113,21 @@ SAFEAudioProcessor::SAFEAudioProcessor()
     controlRate = 64;
     controlBlockSize = (int) (44100.0 / controlRate);
     remainingControlBlockSamples = 0;
+
+    rampedParameters = 0;
+    maximumRampLength = 0;
+    interpolatingParameters = 0;
+
+    currentTrace = nullptr;
+    captureStartTicks = captureEndTicks = 0;
+    captureThreadID = nullptr;
 }
 
 SAFEAudioProcessor::~SAFEAudioProcessor()
 {
+    // a long recording can take a while to analyse, so stop it before
+    // the things it uses are deleted
+    analysisThread = nullptr;
 }
 
 //==========================================================================
@@ -110,8 +151,7 @@ float SAFEAudioProcessor::getParameter (int index)
 void SAFEAudioProcessor::setParameter (int index, float newValue)
 {
     parameters [index]->setBaseValue (newValue);
-    
-    parameterUpdateCalculations (index);
+    markParameterChanged (index);
 }
 
 float SAFEAudioProcessor::getScaledParameter (int index)
@@ -122,8 +162,7 @@ float SAFEAudioProcessor::getScaledParameter (int index)
 void SAFEAudioProcessor::setScaledParameter (int index, float newValue)
 {
     parameters [index]->setScaledValue (newValue);
-    
-    parameterUpdateCalculations (index);
+    markParameterChanged (index);
 }
 
 void SAFEAudioProcessor::setScaledParameterNotifyingHost (int index, float newValue)
@@ -154,6 +193,16 @@ const OwnedArray <SAFEParameter>& SAFEAudioProcessor::getParameterArray()
     return parameters;
 }
 
+uint64 SAFEAudioProcessor::getAndClearChangedParameters()
+{
+    return (uint64) changedParameters.exchange (0);
+}
+
+bool SAFEAudioProcessor::hasChangedParameters() const
+{
+    return changedParameters.get() != 0;
+}
+
 //==========================================================================
 //      Other Plugin Info
 //==========================================================================
@@ -265,41 +314,16 @@ void SAFEAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 //==========================================================================
 //      Semantic Data Parsing
 //==========================================================================
-void SAFEAudioProcessor::initialiseSemanticDataFile()
-{
-    File documentsDirectory (File::getSpecialLocation (File::userDocumentsDirectory));
-
-    File dataDirectory (documentsDirectory.getChildFile ("SAFEPluginData"));
-
-    if (! dataDirectory.isDirectory())
-    {
-        dataDirectory.createDirectory();
-    }
-
-    semanticDataFile = dataDirectory.getChildFile (JucePlugin_Name + String ("Data.xml"));
-
-    if (semanticDataFile.exists())
-    {
-        XmlDocument semanticDataDocument (semanticDataFile);
-        semanticDataElement = semanticDataDocument.getDocumentElement();
-    }
-    else
-    {
-        String elementName (JucePlugin_Name + String ("Data"));
-        semanticDataElement = new XmlElement (makeXmlString (elementName));
-        semanticDataElement->writeToFile (semanticDataFile, "");
-    }
-}
-
-XmlElement* SAFEAudioProcessor::getSemanticDataElement()
+SAFESemanticData& SAFEAudioProcessor::getSemanticData()
 {
-    updateSemanticDataElement();
-
-    return semanticDataElement.get();
+    return *semanticData;
 }
 
 WarningID SAFEAudioProcessor::populateXmlElementWithSemanticData (XmlElement* element, const SAFEMetaData& metaData)
 {
+    // keep the recording and the feature extractors as they are until we're done with them
+    const ScopedLock analysisScope (analysisLock);
+
     // analyse the buffered samples
     WarningID warning = analyseRecordedSamples();
 
@@ -308,6 +332,8 @@ WarningID SAFEAudioProcessor::populateXmlElementWithSemanticData (XmlElement* el
         return warning;
     }
 
+    SAFETrace::ScopedEvent populateEvent (currentTrace, "Populate XML", "save");
+
     // save the channel configuration
     XmlElement* configElement = element->createNewChildElement ("ChannelConfiguration");
 
@@ -392,9 +418,7 @@ WarningID SAFEAudioProcessor::saveSemanticData (const String& newDescriptors, co
     descriptors.addTokens (newDescriptors, " ,;", String::empty);
     int numDescriptors = descriptors.size();
 
-    updateSemanticDataElement();
-
-    XmlElement* descriptorElement = semanticDataElement->createNewChildElement ("SemanticData");
+    ScopedPointer <XmlElement> descriptorElement (new XmlElement ("SemanticData"));
 
     for (int descriptor = 0; descriptor < numDescriptors; ++descriptor)
     {
@@ -412,7 +436,8 @@ WarningID SAFEAudioProcessor::saveSemanticData (const String& newDescriptors, co
     }
 
     // save to file
-    semanticDataElement->writeToFile (semanticDataFile, "");
+    SAFETrace::ScopedEvent writeEvent (currentTrace, "Write Data File", "save");
+    semanticData->addEntry (descriptorElement.release());
 
     return warning;
 }
@@ -422,39 +447,26 @@ WarningID SAFEAudioProcessor::loadSemanticData (const String& descriptor)
     StringArray descriptorArray;
     descriptorArray.addTokens (descriptor, " ,;", String::empty);
 
-    updateSemanticDataElement();
-
     if (descriptorArray.size() > 0)
     {
         String firstDescriptor = descriptorArray [0];
 
         if (firstDescriptor.containsNonWhitespaceChars())
         {
-            // go through XML elements and look for the first one with the descriptor we want
-            forEachXmlChildElement (*semanticDataElement, descriptorElement)
-            {
-                int numAttributes = descriptorElement->getNumAttributes();
+            ScopedPointer <XmlElement> parametersElement (semanticData->createParameterSettings (firstDescriptor));
 
-                for (int attribute = 0; attribute < numAttributes; ++ attribute)
+            if (parametersElement != nullptr)
+            {
+                for (int parameterNum = 0; parameterNum < parameters.size(); ++parameterNum)
                 {
-                    String attributeValue = descriptorElement->getAttributeValue (attribute);
-
-                    if (attributeValue == firstDescriptor)
-                    {
-                        XmlElement* parametersElement = descriptorElement->getChildByName ("ParameterSettings");
-
-                        for (int parameterNum = 0; parameterNum < parameters.size(); ++parameterNum)
-                        {
-                            SAFEParameter* currentParameter = parameters [parameterNum];
-                            String xmlParameterName = makeXmlString (currentParameter->getName());
-                            float newParameterValue = (float) parametersElement->getDoubleAttribute (xmlParameterName);
-                            
-                            setScaledParameterNotifyingHost (parameterNum, newParameterValue);
-                        }
-
-                        return NoWarning;
-                    }
+                    SAFEParameter* currentParameter = parameters [parameterNum];
+                    String xmlParameterName = makeXmlString (currentParameter->getName());
+                    float newParameterValue = (float) parametersElement->getDoubleAttribute (xmlParameterName);
+                    
+                    setScaledParameterNotifyingHost (parameterNum, newParameterValue);
                 }
+
+                return NoWarning;
             }
         }
     }
@@ -483,7 +495,12 @@ WarningID SAFEAudioProcessor::sendDataToServer (const String& newDescriptors, co
 
     File tempDataFile = dataDirectory.getChildFile ("tempData.xml");
 
-    tempDataElement.writeToFile (tempDataFile, "");
+    {
+        SAFETrace::ScopedEvent writeEvent (currentTrace, "Write Temp File", "save");
+        tempDataElement.writeToFile (tempDataFile, "");
+    }
+
+    SAFETrace::ScopedEvent uploadEvent (currentTrace, "Upload", "upload");
 
     #if JUCE_LINUX
     CURLcode res;
@@ -636,40 +653,69 @@ void SAFEAudioProcessor::sendWarningToEditor (WarningID warning)
 //==========================================================================
 void SAFEAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    // the analysis thread may still be reading a recording, which we are about to
+    // resize, so tell it to give up and wait for it to let go, it checks between
+    // frames so this doesn't wait for the whole analysis
+    analysisThread->signalThreadShouldExit();
+    const ScopedLock analysisScope (analysisLock);
+
     // get the channel configuration
     numInputs = getNumInputChannels();
     numOutputs = getNumOutputChannels();
 
+    // a long recording can't carry on with a different channel layout or sample rate
+    if (recording && longRecording)
+    {
+        resetRecording();
+        discardLongRecording();
+        readyToSave = true;
+    }
+    else if (longRecording && analysisThread->isThreadRunning())
+    {
+        discardLongRecording();
+    }
+
+    // high sample rate sessions are decimated before they are analysed, so the
+    // analysis costs the same and the features are comparable whatever the rate
+    analysisDecimator.setDecimationFactor (Decimator::getFactorForSampleRate (sampleRate, minimumAnalysisSampleRate));
+    const int decimationFactor = analysisDecimator.getDecimationFactor();
+    analysisSampleRate = sampleRate / decimationFactor;
+    decimatedFrame.allocate (analysisFrameLength, true);
+
     // work out how many frames we will get in the analysis time 
-    int samplesInRecording = (int) floor (sampleRate * analysisTime / 1000);
+    int samplesInRecording = (int) floor (analysisSampleRate * analysisTime / 1000);
     numAnalysisFrames = (int) floor ((float) (samplesInRecording / analysisFrameLength));
-    numSamplesToRecord = numAnalysisFrames * analysisFrameLength;
+    numSamplesToRecord = numAnalysisFrames * analysisFrameLength * decimationFactor;
 
-    // set up analysis buffers
+    // set up analysis buffers, the audio is kept at the precision it arrives in
+    // and only widened to double a frame at a time when it is analysed
+    unprocessedBuffer.setSize (numInputs, numSamplesToRecord);
     unprocessedBuffer.clear();
     unprocessedFeatureExtractors.clear();
 
     for (int inputChannel = 0; inputChannel < numInputs; ++inputChannel)
     {
-        unprocessedBuffer.add (new Array <double>);
-        unprocessedBuffer [inputChannel]->resize (numSamplesToRecord);
-
         unprocessedFeatureExtractors.add (new SAFEFeatureExtractor);
-        unprocessedFeatureExtractors [inputChannel]->initialise (numAnalysisFrames, analysisFrameLength, sampleRate);
+        unprocessedFeatureExtractors [inputChannel]->initialise (numAnalysisFrames, analysisFrameLength, analysisSampleRate);
     }
 
+    processedBuffer.setSize (numOutputs, numSamplesToRecord);
     processedBuffer.clear();
     processedFeatureExtractors.clear();
 
     for (int outputChannel = 0; outputChannel < numOutputs; ++outputChannel)
     {
-        processedBuffer.add (new Array <double>);
-        processedBuffer [outputChannel]->resize (numSamplesToRecord);
-
         processedFeatureExtractors.add (new SAFEFeatureExtractor);
-        processedFeatureExtractors [outputChannel]->initialise (numAnalysisFrames, analysisFrameLength, sampleRate);
+        processedFeatureExtractors [outputChannel]->initialise (numAnalysisFrames, analysisFrameLength, analysisSampleRate);
     }
 
+    // long recordings only keep enough in memory to give the writer thread some slack
+    captureFile.prepare (numInputs, numOutputs, (int) (sampleRate * captureFifoTime / 1000) + samplesPerBlock);
+    numLongRecordingSamples = (int) (sampleRate * maximumLongRecordingTime / 1000);
+
+    featureMonitor.prepare (sampleRate, samplesPerBlock, decimationFactor);
+    spectrumAnalyser.prepare (sampleRate, samplesPerBlock);
+
     for (int i = 0; i < parameters.size(); ++i)
     {
         parameters [i]->setSampleRate (sampleRate);
@@ -678,26 +724,53 @@ void SAFEAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
     controlBlockSize = (int) (sampleRate / controlRate);
     midiControlBlock.ensureSize (2048);
     midiControlBlock.clear();
+    midiRampBlock.ensureSize (2048);
+    midiRampBlock.clear();
+
+    maximumRampLength = samplesPerBlock;
+
+    for (int i = 0; i < parameters.size(); ++i)
+    {
+        parameters [i]->setMaximumRampLength (maximumRampLength);
+    }
     
+    processTimer.prepare (sampleRate);
+
     // call any prep the plugin processing wants to do
     pluginPreparation (sampleRate, samplesPerBlock);
+
+    // pick up anything that was set while we weren't playing
+    updateParameters();
 }
 
 void SAFEAudioProcessor::processBlock (AudioSampleBuffer& buffer, MidiBuffer& midiMessages)
 {
-    localRecording = recording;
+    processTimer.startBlock();
 
-    recordUnprocessedSamples (buffer);
+    localRecording = recording;
 
-    // call the plugin dsp
-    bool parametersInterpolating = false;
+    {
+        const SAFEProcessTimer::ScopedStage stageTimer (processTimer, SAFEProcessTimer::parameterSmoothingStage);
+        updateParameters();
+    }
 
-    for (int i = 0; i < parameters.size(); ++i)
     {
-        parametersInterpolating = parametersInterpolating || parameters [i]->isInterpolating();
+        const SAFEProcessTimer::ScopedStage stageTimer (processTimer, SAFEProcessTimer::captureStage);
+        recordUnprocessedSamples (buffer);
+        spectrumAnalyser.addSamples (SpectrumAnalyser::unprocessedSignal, buffer, getNumInputChannels());
     }
 
-    if (parametersInterpolating)
+    // call the plugin dsp, only splitting it into control blocks
+    // while a parameter which is stepped at the control rate is moving
+    bool parametersInterpolating = interpolatingParameters != 0;
+    bool parametersStepping = (interpolatingParameters & getSteppedParameters()) != 0;
+
+    if (parametersInterpolating && ! parametersStepping)
+    {
+        processWithParameterRamps (buffer, midiMessages);
+        remainingControlBlockSamples = 0;
+    }
+    else if (parametersInterpolating)
     {
         int numChannels = buffer.getNumChannels();
         int numSamples = buffer.getNumSamples();
@@ -709,7 +782,7 @@ void SAFEAudioProcessor::processBlock (AudioSampleBuffer& buffer, MidiBuffer& mi
             midiControlBlock.clear();
             midiControlBlock.addEvents (midiMessages, 0, numSamples, 0);
 
-            pluginProcessing (controlBlock, midiControlBlock);
+            processWithParameterRamps (controlBlock, midiControlBlock);
 
             remainingControlBlockSamples -= numSamples;
         }
@@ -722,7 +795,7 @@ void SAFEAudioProcessor::processBlock (AudioSampleBuffer& buffer, MidiBuffer& mi
                 midiControlBlock.clear();
                 midiControlBlock.addEvents (midiMessages, 0, remainingControlBlockSamples, 0);
 
-                pluginProcessing (controlBlock, midiControlBlock);
+                processWithParameterRamps (controlBlock, midiControlBlock);
             }
         
             int numControlBlocks = (int) ((numSamples - remainingControlBlockSamples) / controlBlockSize);
@@ -730,13 +803,12 @@ void SAFEAudioProcessor::processBlock (AudioSampleBuffer& buffer, MidiBuffer& mi
 
             for (int block = 0; block < numControlBlocks; ++block)
             {
-                for (int i = 0; i < parameters.size(); ++i)
+                // each control block takes any changes set since the last one
+                // before stepping the smoothing on
                 {
-                    if (parameters [i]->isInterpolating())
-                    {
-                        parameters [i]->smoothValues();
-                        parameterUpdateCalculations (i);
-                    }
+                    const SAFEProcessTimer::ScopedStage stageTimer (processTimer, SAFEProcessTimer::parameterSmoothingStage);
+                    updateParameters();
+                    smoothParameters();
                 }
 
                 AudioSampleBuffer controlBlock (buffer.getArrayOfWritePointers(), numChannels, sampleNumber, controlBlockSize);
@@ -744,7 +816,7 @@ void SAFEAudioProcessor::processBlock (AudioSampleBuffer& buffer, MidiBuffer& mi
                 midiControlBlock.clear();
                 midiControlBlock.addEvents (midiMessages, sampleNumber, controlBlockSize, 0);
 
-                pluginProcessing (controlBlock, midiControlBlock);
+                processWithParameterRamps (controlBlock, midiControlBlock);
 
                 sampleNumber += controlBlockSize;
             }
@@ -753,13 +825,10 @@ void SAFEAudioProcessor::processBlock (AudioSampleBuffer& buffer, MidiBuffer& mi
 
             if (samplesLeft)
             {
-                for (int i = 0; i < parameters.size(); ++i)
                 {
-                    if (parameters [i]->isInterpolating())
-                    {
-                        parameters [i]->smoothValues();
-                        parameterUpdateCalculations (i);
-                    }
+                    const SAFEProcessTimer::ScopedStage stageTimer (processTimer, SAFEProcessTimer::parameterSmoothingStage);
+                    updateParameters();
+                    smoothParameters();
                 }
 
                 AudioSampleBuffer controlBlock (buffer.getArrayOfWritePointers(), numChannels, sampleNumber, samplesLeft);
@@ -767,7 +836,7 @@ void SAFEAudioProcessor::processBlock (AudioSampleBuffer& buffer, MidiBuffer& mi
                 midiControlBlock.clear();
                 midiControlBlock.addEvents (midiMessages, sampleNumber, samplesLeft, 0);
 
-                pluginProcessing (controlBlock, midiControlBlock);
+                processWithParameterRamps (controlBlock, midiControlBlock);
             }
 
             remainingControlBlockSamples = controlBlockSize - samplesLeft;
@@ -775,7 +844,7 @@ void SAFEAudioProcessor::processBlock (AudioSampleBuffer& buffer, MidiBuffer& mi
     }
     else
     {
-        pluginProcessing (buffer, midiMessages);
+        callPluginProcessing (buffer, midiMessages);
         remainingControlBlockSamples = 0;
     }
 
@@ -788,7 +857,134 @@ void SAFEAudioProcessor::processBlock (AudioSampleBuffer& buffer, MidiBuffer& mi
     }
 
     updatePlayHead();
-    recordProcessedSamples (buffer);
+
+    {
+        const SAFEProcessTimer::ScopedStage stageTimer (processTimer, SAFEProcessTimer::captureStage);
+        recordProcessedSamples (buffer);
+        featureMonitor.addSamples (buffer);
+        spectrumAnalyser.addSamples (SpectrumAnalyser::processedSignal, buffer, getNumOutputChannels());
+    }
+
+    processTimer.endBlock (buffer.getNumSamples());
+}
+
+void SAFEAudioProcessor::processWithParameterRamps (AudioSampleBuffer& buffer, MidiBuffer& midiMessages)
+{
+    int numChannels = buffer.getNumChannels();
+    int numSamples = buffer.getNumSamples();
+    int sampleNumber = 0;
+
+    if ((interpolatingParameters & rampedParameters) == 0 || maximumRampLength == 0)
+    {
+        callPluginProcessing (buffer, midiMessages);
+        return;
+    }
+
+    // the block is only split up if it is longer than the ramp buffers
+    while (sampleNumber < numSamples)
+    {
+        int rampLength = jmin (numSamples - sampleNumber, maximumRampLength);
+        const uint64 parametersToRamp = interpolatingParameters & rampedParameters;
+
+        {
+            const SAFEProcessTimer::ScopedStage stageTimer (processTimer, SAFEProcessTimer::parameterSmoothingStage);
+
+            for (int i = 0; i < maxNumParameters && (parametersToRamp >> i) != 0; ++i)
+            {
+                if ((parametersToRamp >> i) & 1)
+                {
+                    parameterRamps.set (i, parameters [i]->renderRamp (rampLength));
+                    parameterUpdateCalculations (i);
+                    updateInterpolatingFlag (i);
+                }
+            }
+        }
+
+        if (rampLength == numSamples)
+        {
+            callPluginProcessing (buffer, midiMessages);
+        }
+        else
+        {
+            AudioSampleBuffer rampBlock (buffer.getArrayOfWritePointers(), numChannels, sampleNumber, rampLength);
+
+            midiRampBlock.clear();
+            midiRampBlock.addEvents (midiMessages, sampleNumber, rampLength, -sampleNumber);
+
+            callPluginProcessing (rampBlock, midiRampBlock);
+        }
+
+        sampleNumber += rampLength;
+
+        for (int i = 0; i < maxNumParameters && (parametersToRamp >> i) != 0; ++i)
+        {
+            parameterRamps.set (i, nullptr);
+        }
+    }
+}
+
+void SAFEAudioProcessor::callPluginProcessing (AudioSampleBuffer& buffer, MidiBuffer& midiMessages)
+{
+    const SAFEProcessTimer::ScopedStage stageTimer (processTimer, SAFEProcessTimer::pluginProcessingStage);
+    pluginProcessing (buffer, midiMessages);
+}
+
+void SAFEAudioProcessor::updateParameters()
+{
+    for (int i = 0; i < parameters.size(); ++i)
+    {
+        if (parameters [i]->updateValue())
+        {
+            parameterUpdateCalculations (i);
+            updateInterpolatingFlag (i);
+        }
+    }
+}
+
+void SAFEAudioProcessor::smoothParameters()
+{
+    const uint64 parametersToStep = interpolatingParameters & getSteppedParameters();
+
+    for (int i = 0; i < maxNumParameters && (parametersToStep >> i) != 0; ++i)
+    {
+        if ((parametersToStep >> i) & 1)
+        {
+            parameters [i]->smoothValues();
+            parameterUpdateCalculations (i);
+            updateInterpolatingFlag (i);
+        }
+    }
+}
+
+uint64 SAFEAudioProcessor::getSteppedParameters() const
+{
+    // without ramp buffers every parameter is stepped
+    return maximumRampLength > 0 ? ~rampedParameters : ~ (uint64) 0;
+}
+
+void SAFEAudioProcessor::updateInterpolatingFlag (int index)
+{
+    const uint64 flag = (uint64) 1 << index;
+
+    if (parameters [index]->isInterpolating())
+        interpolatingParameters |= flag;
+    else
+        interpolatingParameters &= ~flag;
+}
+
+void SAFEAudioProcessor::markParameterChanged (int index)
+{
+    const int64 flag = (int64) ((uint64) 1 << index);
+
+    for (;;)
+    {
+        const int64 oldFlags = changedParameters.get();
+
+        if ((oldFlags & flag) != 0 || changedParameters.compareAndSetBool (oldFlags | flag, oldFlags))
+        {
+            return;
+        }
+    }
 }
 
 //==========================================================================
@@ -799,10 +995,17 @@ bool SAFEAudioProcessor::isPlaying()
     return playHead.isPlaying;
 }
 
-bool SAFEAudioProcessor::startRecording (const String& descriptors, const SAFEMetaData& metaData, bool newSendToServer)
+bool SAFEAudioProcessor::startRecording (const String& descriptors, const SAFEMetaData& metaData, bool newSendToServer, bool newLongRecording)
 {
     if (readyToSave)
     {
+        if (newLongRecording && ! captureFile.start())
+        {
+            sendWarningToEditor (LongRecordingFailed);
+            return false;
+        }
+
+        longRecording = newLongRecording;
         currentUnprocessedAnalysisFrame = 0;
         currentProcessedAnalysisFrame = 0;
         unprocessedTap = 0;
@@ -813,6 +1016,8 @@ bool SAFEAudioProcessor::startRecording (const String& descriptors, const SAFEMe
         sendToServer = newSendToServer;
         cacheCurrentParameters();
 
+        captureStartTicks = Time::getHighResolutionTicks();
+
         recording = true;
         readyToSave = false;
 
@@ -825,31 +1030,116 @@ bool SAFEAudioProcessor::startRecording (const String& descriptors, const SAFEMe
     }
 }
 
+void SAFEAudioProcessor::stopRecording()
+{
+    if (recording && longRecording)
+    {
+        captureEndTicks = Time::getHighResolutionTicks();
+
+        if (startAnalysisThread() != NoWarning)
+        {
+            discardLongRecording();
+        }
+    }
+}
+
 bool SAFEAudioProcessor::isRecording()
 {
     return recording;
 }
 
+bool SAFEAudioProcessor::isLongRecording()
+{
+    return recording && longRecording;
+}
+
+float SAFEAudioProcessor::getAnalysisProgress()
+{
+    const int numFrames = numLongRecordingFrames.get();
+
+    if (numFrames == 0)
+    {
+        return -1.0f;
+    }
+
+    return numLongRecordingFramesAnalysed.get() / (float) numFrames;
+}
+
 bool SAFEAudioProcessor::isReadyToSave()
 {
     return readyToSave;
 }
 
+//==========================================================================
+//      Process Timing
+//==========================================================================
+SAFEProcessTimer& SAFEAudioProcessor::getProcessTimer()
+{
+    return processTimer;
+}
+
+Result SAFEAudioProcessor::saveProcessTimings()
+{
+    File timingsFile = semanticData->getFile().getSiblingFile (JucePlugin_Name + String ("Timings.json"));
+
+    return processTimer.writeToFile (timingsFile);
+}
+
+//==========================================================================
+//      Live Features
+//==========================================================================
+SAFEFeatureMonitor& SAFEAudioProcessor::getFeatureMonitor()
+{
+    return featureMonitor;
+}
+
+SpectrumAnalyser& SAFEAudioProcessor::getSpectrumAnalyser()
+{
+    return spectrumAnalyser;
+}
+
 //==========================================================================
 //      Methods to Create New Parameters
 //==========================================================================
 void SAFEAudioProcessor::addParameter (String name, float& valueRef, float initialValue, float minValue, float maxValue, String units, float skewFactor, bool convertDBToGainValue, double interpolationTime, float UIScaleFactor)
 {
+    // the interpolation flags only have room for so many parameters
+    jassert (parameters.size() < maxNumParameters);
+
     parameters.add (new SAFEParameter (name, valueRef, initialValue, minValue, maxValue, units, skewFactor, convertDBToGainValue, interpolationTime, UIScaleFactor));
 
     parametersToSave.add (0);
+    parameterRamps.add (nullptr);
 }
 
 void SAFEAudioProcessor::addDBParameter (String name, float& valueRef, float initialValue, float minValue, float maxValue, String units, float skewFactor, double interpolationTime, float UIScaleFactor)
 {
+    jassert (parameters.size() < maxNumParameters);
+
     parameters.add (new SAFEParameter (name, valueRef, initialValue, minValue, maxValue, units, skewFactor, true, interpolationTime, UIScaleFactor));
 
     parametersToSave.add (0);
+    parameterRamps.add (nullptr);
+}
+
+void SAFEAudioProcessor::setParameterSmoothingMode (int index, SAFEParameter::SmoothingMode newMode)
+{
+    // the parameter has to have been added first
+    jassert (isPositiveAndBelow (index, parameters.size()));
+
+    parameters [index]->setSmoothingMode (newMode);
+
+    const uint64 flag = (uint64) 1 << index;
+
+    if (newMode == SAFEParameter::sampleRateSmoothing)
+        rampedParameters |= flag;
+    else
+        rampedParameters &= ~flag;
+}
+
+const float* SAFEAudioProcessor::getParameterRamp (int index) const
+{
+    return parameterRamps [index];
 }
 
 //==========================================================================
@@ -857,46 +1147,61 @@ void SAFEAudioProcessor::addDBParameter (String name, float& valueRef, float ini
 //==========================================================================
 void SAFEAudioProcessor::recordUnprocessedSamples (AudioSampleBuffer& buffer)
 {
-    if (localRecording)
+    if (localRecording && longRecording)
     {
-        int numSamples = buffer.getNumSamples();
+        if (unprocessedTap < numLongRecordingSamples)
+        {
+            captureFile.addUnprocessedSamples (buffer);
+            unprocessedTap += buffer.getNumSamples();
+        }
+    }
+    else if (localRecording)
+    {
+        int numSamples = jmin (buffer.getNumSamples(), numSamplesToRecord - unprocessedTap);
 
-        for (int i = 0; i < numSamples; ++i)
+        if (numSamples > 0)
         {
             for (int inputChannel = 0; inputChannel < numInputs; ++inputChannel)
             {
-                unprocessedBuffer [inputChannel]->set (unprocessedTap, buffer.getSample (inputChannel, i));
+                unprocessedBuffer.copyFrom (inputChannel, unprocessedTap, buffer, inputChannel, 0, numSamples);
             }
 
-            ++unprocessedTap;
-
-            if (unprocessedTap >= numSamplesToRecord)
-            {
-                break;
-            }
+            unprocessedTap += numSamples;
         }
     }
 }
 
 void SAFEAudioProcessor::recordProcessedSamples (AudioSampleBuffer& buffer)
 {
-    if (localRecording)
+    // long recordings are stopped from the message thread, see timerCallback()
+    if (localRecording && longRecording)
     {
-        int numSamples = buffer.getNumSamples();
+        if (processedTap < numLongRecordingSamples)
+        {
+            captureFile.addProcessedSamples (buffer);
+            processedTap += buffer.getNumSamples();
+            captureThreadID = Thread::getCurrentThreadId();
+        }
+    }
+    else if (localRecording)
+    {
+        int numSamples = jmin (buffer.getNumSamples(), numSamplesToRecord - processedTap);
 
-        for (int i = 0; i < numSamples; ++i)
+        if (numSamples > 0)
         {
             for (int outputChannel = 0; outputChannel < numOutputs; ++outputChannel)
             {
-                processedBuffer [outputChannel]->set (processedTap, buffer.getSample (outputChannel, i));
+                processedBuffer.copyFrom (outputChannel, processedTap, buffer, outputChannel, 0, numSamples);
             }
 
-            ++processedTap;
+            processedTap += numSamples;
 
             if (processedTap >= numSamplesToRecord)
             {
+                captureEndTicks = Time::getHighResolutionTicks();
+                captureThreadID = Thread::getCurrentThreadId();
+
                 startAnalysisThread();
-                break;
             }
         }
     }
@@ -907,20 +1212,38 @@ void SAFEAudioProcessor::recordProcessedSamples (AudioSampleBuffer& buffer)
 //==========================================================================
 WarningID SAFEAudioProcessor::analyseRecordedSamples()
 {
-    for (int frameNum = 0; frameNum < numAnalysisFrames; ++frameNum)
+    SAFETrace::ScopedEvent analyseEvent (currentTrace, "Analyse", "analysis");
+
+    // prepareToPlay() has thrown the recording away
+    if (analysisThread->threadShouldExit())
     {
-        for (int inputChannel = 0; inputChannel < numInputs; ++inputChannel)
-        {
-            double* unprocessedSamples = unprocessedBuffer [inputChannel]->getRawDataPointer() + analysisFrameLength * frameNum;
+        return AnalysisInterrupted;
+    }
+
+    if (longRecording)
+    {
+        WarningID warning = analyseLongRecording();
 
-            unprocessedFeatureExtractors [inputChannel]->getAllFeatures (unprocessedSamples, analysisFrameLength, frameNum);
+        if (warning != NoWarning)
+        {
+            return warning;
         }
+    }
+    else
+    {
+        // the extractors may have been resized for a long recording
+        initialiseFeatureExtractors (numAnalysisFrames);
 
-        for (int outputChannel = 0; outputChannel < numOutputs; ++outputChannel)
+        const int frameSamples = analysisFrameLength * analysisDecimator.getDecimationFactor();
+
+        for (int frameNum = 0; frameNum < numAnalysisFrames; ++frameNum)
         {
-            double* processedSamples = processedBuffer [outputChannel]->getRawDataPointer() + analysisFrameLength * frameNum;
+            if (analysisThread->threadShouldExit())
+            {
+                return AnalysisInterrupted;
+            }
 
-            processedFeatureExtractors [outputChannel]->getAllFeatures (processedSamples, analysisFrameLength, frameNum);
+            analyseRecordedFrames (unprocessedBuffer, processedBuffer, frameSamples * frameNum, frameNum);
         }
     }
 
@@ -941,6 +1264,132 @@ WarningID SAFEAudioProcessor::analyseRecordedSamples()
     }
 }
 
+WarningID SAFEAudioProcessor::analyseLongRecording()
+{
+    // wait for the writer thread to finish with the file
+    if (! captureFile.stop())
+    {
+        captureFile.deleteFile();
+        return LongRecordingFailed;
+    }
+
+    const int decimationFactor = analysisDecimator.getDecimationFactor();
+    const int frameSamples = analysisFrameLength * decimationFactor;
+    const int numFrames = (int) (captureFile.getNumSamples() / frameSamples);
+
+    if (numFrames == 0)
+    {
+        captureFile.deleteFile();
+        return LongRecordingTooShort;
+    }
+
+    initialiseFeatureExtractors (numFrames);
+
+    // each chunk has extra samples either side for the decimator to look at
+    const int margin = analysisDecimator.getStretchMargin();
+    const int chunkLength = numFramesPerAnalysisChunk * frameSamples + 2 * margin;
+
+    AudioSampleBuffer chunk (numInputs + numOutputs, chunkLength);
+    AudioSampleBuffer unprocessedChunk (chunk.getArrayOfWritePointers(), numInputs, chunkLength);
+    AudioSampleBuffer processedChunk (chunk.getArrayOfWritePointers() + numInputs, numOutputs, chunkLength);
+
+    numLongRecordingFramesAnalysed.set (0);
+    numLongRecordingFrames.set (numFrames);
+
+    WarningID warning = NoWarning;
+
+    for (int firstFrame = 0; firstFrame < numFrames; firstFrame += numFramesPerAnalysisChunk)
+    {
+        const int numChunkFrames = jmin (numFramesPerAnalysisChunk, numFrames - firstFrame);
+
+        {
+            SAFETrace::ScopedEvent readEvent (currentTrace, "Read Chunk", "analysis");
+            readEvent.setArgument ("firstFrame", firstFrame);
+
+            if (analysisThread->threadShouldExit())
+            {
+                warning = AnalysisInterrupted;
+                break;
+            }
+
+            if (! captureFile.readSamples (chunk, (int64) firstFrame * frameSamples - margin, chunkLength))
+            {
+                warning = LongRecordingFailed;
+                break;
+            }
+        }
+
+        for (int frame = 0; frame < numChunkFrames; ++frame)
+        {
+            analyseRecordedFrames (unprocessedChunk, processedChunk, margin + frame * frameSamples, firstFrame + frame);
+        }
+
+        numLongRecordingFramesAnalysed.set (firstFrame + numChunkFrames);
+    }
+
+    numLongRecordingFrames.set (0);
+    captureFile.deleteFile();
+
+    return warning;
+}
+
+void SAFEAudioProcessor::initialiseFeatureExtractors (int numFrames)
+{
+    for (int inputChannel = 0; inputChannel < numInputs; ++inputChannel)
+    {
+        if (unprocessedFeatureExtractors [inputChannel]->getNumAnalysisFrames() != numFrames)
+        {
+            unprocessedFeatureExtractors [inputChannel]->initialise (numFrames, analysisFrameLength, analysisSampleRate);
+        }
+    }
+
+    for (int outputChannel = 0; outputChannel < numOutputs; ++outputChannel)
+    {
+        if (processedFeatureExtractors [outputChannel]->getNumAnalysisFrames() != numFrames)
+        {
+            processedFeatureExtractors [outputChannel]->initialise (numFrames, analysisFrameLength, analysisSampleRate);
+        }
+    }
+}
+
+void SAFEAudioProcessor::analyseRecordedFrames (const AudioSampleBuffer& unprocessedRecording, const AudioSampleBuffer& processedRecording, int frameStart, int frameNum)
+{
+    for (int inputChannel = 0; inputChannel < numInputs; ++inputChannel)
+    {
+        SAFETrace::ScopedEvent frameEvent (currentTrace, "Unprocessed Frame", "analysis");
+        frameEvent.setArgument ("channel", inputChannel);
+        frameEvent.setArgument ("frame", frameNum);
+
+        analyseRecordedFrame (*unprocessedFeatureExtractors [inputChannel], unprocessedRecording, inputChannel, frameStart, frameNum);
+    }
+
+    for (int outputChannel = 0; outputChannel < numOutputs; ++outputChannel)
+    {
+        SAFETrace::ScopedEvent frameEvent (currentTrace, "Processed Frame", "analysis");
+        frameEvent.setArgument ("channel", outputChannel);
+        frameEvent.setArgument ("frame", frameNum);
+
+        analyseRecordedFrame (*processedFeatureExtractors [outputChannel], processedRecording, outputChannel, frameStart, frameNum);
+    }
+}
+
+void SAFEAudioProcessor::analyseRecordedFrame (SAFEFeatureExtractor& extractor, const AudioSampleBuffer& recording, int channel, int frameStart, int frameNum)
+{
+    const int decimationFactor = analysisDecimator.getDecimationFactor();
+
+    if (decimationFactor == 1)
+    {
+        extractor.analyseFrame (recording.getReadPointer (channel, frameStart), analysisFrameLength, frameNum);
+    }
+    else
+    {
+        analysisDecimator.decimate (recording.getReadPointer (channel), recording.getNumSamples(), frameStart / decimationFactor,
+                                    decimatedFrame, analysisFrameLength);
+
+        extractor.analyseFrame (decimatedFrame, analysisFrameLength, frameNum);
+    }
+}
+
 //==========================================================================
 //      Play Head Stuff
 //==========================================================================
@@ -958,15 +1407,6 @@ void SAFEAudioProcessor::updatePlayHead()
     }
 }
 
-//==========================================================================
-//      Semantic Data File Stuff
-//==========================================================================
-void SAFEAudioProcessor::updateSemanticDataElement()
-{
-    XmlDocument semanticDataDocument (semanticDataFile);
-    semanticDataElement = semanticDataDocument.getDocumentElement();
-}
-
 //==========================================================================
 //      Recording Tests
 //==========================================================================
@@ -998,11 +1438,24 @@ void SAFEAudioProcessor::timerCallback()
 {
     if (haveParametersChanged())
     {
+        if (isLongRecording())
+        {
+            discardLongRecording();
+        }
+
         resetRecording();
         sendWarningToEditor (ParameterChange);
     }
 
-    if (! isPlaying())
+    if (isLongRecording())
+    {
+        // a long recording finishes when the host stops rather than being thrown away
+        if (! isPlaying() || processedTap >= numLongRecordingSamples)
+        {
+            stopRecording();
+        }
+    }
+    else if (! isPlaying())
     {
         resetRecording();
         sendWarningToEditor (AudioNotPlaying);
@@ -1015,6 +1468,12 @@ void SAFEAudioProcessor::resetRecording()
     stopTimer();
 }
 
+void SAFEAudioProcessor::discardLongRecording()
+{
+    captureFile.stop();
+    captureFile.deleteFile();
+}
+
 //==========================================================================
 //      Make String ok for use in XML
 //==========================================================================
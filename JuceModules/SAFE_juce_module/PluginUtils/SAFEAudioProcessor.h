@@ -121,6 +121,11 @@ public:
      *  the value of a parameter has been set. Perhaps you need to calculate some filter
      *  coefficients of something.
      *
+     *  Parameter changes from the host or the editor are handed to the audio thread
+     *  and this gets called from there, either at the start of the next block or 
+     *  as the value is smoothed. So it is safe to touch anything the processing uses
+     *  but it should not allocate memory or take locks.
+     *
      *  @param index  the index of the parameter which was set  
      */
     virtual void parameterUpdateCalculations (int /*index*/) {};
@@ -138,6 +143,23 @@ public:
      */
     const OwnedArray <SAFEParameter>& getParameterArray();
 
+    /** Returns a bit for each parameter which has been set since the last call, and
+     *  clears them.
+     *
+     *  Bit n is set whenever parameter n is set, by the host, the editor or when a 
+     *  state is loaded. Setting the bits doesn't lock, so parameters can be set from
+     *  any thread. The SAFEAudioProcessorEditor uses this to only update what has 
+     *  changed, so there should only be one thing calling it.
+     */
+    uint64 getAndClearChangedParameters();
+
+    /** Returns true if any parameters have been set since getAndClearChangedParameters()
+     *  was last called, without clearing them.
+     *
+     *  This is a single atomic read, so it is cheap enough to poll.
+     */
+    bool hasChangedParameters() const;
+
     //==========================================================================
     //      Other Plugin Info
     //==========================================================================
@@ -195,9 +217,12 @@ public:
     //==========================================================================
     //      Semantic Data Parsing
     //==========================================================================
-    /** Returns a pointer to the XmlElement from the file the plug-in saves its descriptors
-     *  to. */
-    XmlElement* getSemanticDataElement();
+    /** Returns the file the plug-in saves its descriptors to.
+     *
+     *  This is shared by every instance of the plug-in, register a ChangeListener
+     *  with it to find out when it has loaded or a descriptor has been saved.
+     */
+    SAFESemanticData& getSemanticData();
 
     /** Load a descriptor from a local file.
      *
@@ -211,6 +236,13 @@ public:
      */
     WarningID getServerData (const String& descriptor);
 
+    /** Returns a copy of a string with any characters which can't be used in an
+     *  XML tag name removed.
+     *
+     *  @param input  the string to make safe for XML
+     */
+    static String makeXmlString (String input);
+
     //==========================================================================
     //      Analysis Thread
     //==========================================================================
@@ -220,7 +252,11 @@ public:
     //==========================================================================
     //      Process Block
     //==========================================================================
-    /** Implementation of function from AudioProcessor. */
+    /** Implementation of function from AudioProcessor.
+     *
+     *  If a save is still analysing its recording the analysis is abandoned, this
+     *  only waits for it to finish the frame or chunk it is on.
+     */
     void prepareToPlay (double sampleRate, int samplesPerBlock) final;
 
     /** Do any preparation your plug-in needs to do here.
@@ -255,17 +291,74 @@ public:
      *  Returns true if the plug-in started recording. If this returns false it means the 
      *  plug-in was already recording audio from a previous call to this function.
      *  
+     *  A normal recording is a few seconds long and is held in memory. A long recording
+     *  is streamed to a temporary file and carries on until stopRecording() is called,
+     *  the host stops playing or it reaches maximumLongRecordingTime. It is then analysed
+     *  a chunk at a time so it never has to fit in memory.
+     *
      *  You should not need to call this function. It is called by the editor when the record
      *  button is pressed.
      */
-    bool startRecording (const String& descriptors, const SAFEMetaData& metaData, bool newSendToServer);
+    bool startRecording (const String& descriptors, const SAFEMetaData& metaData, bool newSendToServer, bool newLongRecording = false);
+
+    /** Stop a long recording and start analysing it.
+     *
+     *  This should be called from the message thread. It does nothing if the plug-in 
+     *  isn't making a long recording.
+     */
+    void stopRecording();
 
     /** Returns true if the plug-in is currently recording audio. */
     bool isRecording();
 
+    /** Returns true if the plug-in is currently making a long recording. */
+    bool isLongRecording();
+
+    /** Returns how much of a long recording has been analysed, from 0 to 1.
+     *
+     *  Returns -1 if no long recording is being analysed.
+     */
+    float getAnalysisProgress();
+
+    /** The longest a long recording can be, in milliseconds. */
+    static const int maximumLongRecordingTime = 600000;
+
     /** Returns true if the plug-in has finished recording and is ready to save. */
     bool isReadyToSave();
 
+    //==========================================================================
+    //      Process Timing
+    //==========================================================================
+    /** Returns the timers for the stages of processBlock().
+     *
+     *  The editor can use this to read or reset the counters from the message thread.
+     */
+    SAFEProcessTimer& getProcessTimer();
+
+    /** Write the process timings to a file in the SAFEPluginData directory.
+     *
+     *  The file is named after the plug-in, e.g. SAFECompressorTimings.json.
+     */
+    Result saveProcessTimings();
+
+    //==========================================================================
+    //      Live Features
+    //==========================================================================
+    /** Returns the monitor which works out features of the processed audio as it plays.
+     *
+     *  The monitor does nothing until an editor switches it on, see
+     *  SAFEAudioProcessorEditor::setFeatureMonitorEnabled().
+     */
+    SAFEFeatureMonitor& getFeatureMonitor();
+
+    /** Returns the analyser which works out the spectra of the audio before and after
+     *  processing as it plays.
+     *
+     *  The analyser does nothing until something switches it on, see
+     *  FilterGraph::setSpectrumAnalyser().
+     */
+    SpectrumAnalyser& getSpectrumAnalyser();
+
 protected:
     //==========================================================================
     //      Methods to Create New Parameters
@@ -305,6 +398,57 @@ protected:
      */
     void addDBParameter (String name, float& valueRef, float initialValue = 1, float minValue = 0, float maxValue = 1, String units = String::empty, float skewFactor = 1, double interpolationTimeInit = 100, float UIScaleFactor = 1);
 
+    /** Add all of a plug-in's parameters from a layout table.
+     *
+     *  The template argument should be the last entry of the plug-in's parameter 
+     *  index enum, so a table or value array which doesn't match the enum will
+     *  fail to compile. Like addParameter() this should be called in your plug-in's
+     *  constructor.
+     *
+     *  @param layout     a static table describing each parameter
+     *  @param valueRefs  pointers to the variables which will hold each parameter's value
+     */
+    template <int numParameters>
+    void addParameters (const SAFEParameterInfo (&layout) [numParameters], float* const (&valueRefs) [numParameters])
+    {
+        static_jassert (numParameters <= maxNumParameters);
+
+        for (int i = 0; i < numParameters; ++i)
+        {
+            const SAFEParameterInfo& info = layout [i];
+
+            addParameter (info.name, *valueRefs [i], info.initialValue, info.minValue, info.maxValue, info.units, info.skewFactor, info.convertDBToGainValue, info.interpolationTime, info.UIScaleFactor);
+        }
+    }
+
+    /** The most parameters a plug-in can have. */
+    static const int maxNumParameters = 64;
+
+    /** Set how one of the plug-in's parameters moves towards new values.
+     *
+     *  By default parameters are stepped at the control rate and the block passed
+     *  to pluginProcessing() is split up so each step lands at the start of a call.
+     *  With SAFEParameter::sampleRateSmoothing getParameterRamp() can be used to read
+     *  the value of the parameter at each sample, and the block is only split up
+     *  while a control rate parameter is moving too. Only use it for parameters
+     *  whose ramp your pluginProcessing() reads, the rest would only change once
+     *  per block. This should be called in your plug-in's constructor.
+     *
+     *  @param index    the index of the parameter
+     *  @param newMode  the smoothing mode to use for the parameter
+     */
+    void setParameterSmoothingMode (int index, SAFEParameter::SmoothingMode newMode);
+
+    /** Returns the value of a parameter at each sample of the current block.
+     *
+     *  This can be called from pluginProcessing() for parameters using the sample rate
+     *  smoothing mode. If the parameter is not interpolating this returns nullptr and
+     *  the parameter's value reference holds its value for the whole block.
+     *
+     *  @param index  the index of the parameter to get the ramp for
+     */
+    const float* getParameterRamp (int index) const;
+
     //==========================================================================
     //      Play Head Stuff
     //==========================================================================
@@ -335,6 +479,22 @@ private:
     OwnedArray <SAFEParameter> parameters;
     Array <float> parametersToSave;
 
+    // one bit for each parameter which is interpolating, so the audio
+    // thread can skip over parameters which aren't changing
+    uint64 interpolatingParameters;
+    void updateInterpolatingFlag (int index);
+
+    // one bit for each parameter which has been set since the editor last looked
+    Atomic <int64> changedParameters;
+    void markParameterChanged (int index);
+
+    /** Apply any parameter values which have been set since the last block, or the
+     *  last control block while parameters are being stepped at the control rate. */
+    void updateParameters();
+
+    /** Move all the interpolating parameters on by one control block. */
+    void smoothParameters();
+
     String descriptorsToSave;
     SAFEMetaData metaDataToSave;
     bool sendToServer;
@@ -342,17 +502,42 @@ private:
     //==========================================================================
     //      Semantic Data File Stuff
     //==========================================================================
-    File semanticDataFile;
-    ScopedPointer <XmlElement> semanticDataElement;
-    void updateSemanticDataElement();
+    SharedResourcePointer <SAFESemanticData> semanticData;
 
     static const int analysisTime = 5000;
     static const int analysisFrameLength = 4096;
+    static const int minimumAnalysisSampleRate = 44100;
+    double analysisSampleRate;
     int numAnalysisFrames, currentUnprocessedAnalysisFrame, currentProcessedAnalysisFrame;
     int numSamplesToRecord;
-    OwnedArray <Array <double> > unprocessedBuffer, processedBuffer;
+    AudioSampleBuffer unprocessedBuffer, processedBuffer;
+    Decimator analysisDecimator;
+    HeapBlock <double> decimatedFrame;
     int unprocessedTap, processedTap;
 
+    // held while a save analyses the recording and reads the feature extractors,
+    // prepareToPlay() stops the analysis and takes it too so the recording isn't
+    // changed underneath it
+    CriticalSection analysisLock;
+
+    //==========================================================================
+    //      Long Recordings
+    //==========================================================================
+    // how much audio the capture fifo holds while the writer thread catches up
+    static const int captureFifoTime = 1000;
+
+    // the number of frames of a long recording read into memory at once
+    static const int numFramesPerAnalysisChunk = 16;
+
+    bool longRecording;
+    int numLongRecordingSamples;
+    SAFECaptureFile captureFile;
+    Atomic <int> numLongRecordingFrames, numLongRecordingFramesAnalysed;
+
+    /** Stop the writer thread and delete the file of a long recording which
+     *  won't be analysed. */
+    void discardLongRecording();
+
     OwnedArray <SAFEFeatureExtractor> unprocessedFeatureExtractors, processedFeatureExtractors;
 
     double controlRate;
@@ -360,6 +545,36 @@ private:
     int remainingControlBlockSamples;
     MidiBuffer midiControlBlock;
 
+    // one bit for each parameter smoothed at the sample rate
+    uint64 rampedParameters;
+    int maximumRampLength;
+    Array <const float*> parameterRamps;
+    MidiBuffer midiRampBlock;
+
+    /** Returns the flags of the parameters which are stepped at the control rate. */
+    uint64 getSteppedParameters() const;
+
+    /** Render the ramps of any parameters smoothed at the sample rate and call
+     *  pluginProcessing(), splitting the block if it is longer than the ramps. */
+    void processWithParameterRamps (AudioSampleBuffer& buffer, MidiBuffer& midiMessages);
+
+    /** Calls pluginProcessing(), timing it. */
+    void callPluginProcessing (AudioSampleBuffer& buffer, MidiBuffer& midiMessages);
+
+    SAFEProcessTimer processTimer;
+    SAFEFeatureMonitor featureMonitor;
+    SpectrumAnalyser spectrumAnalyser;
+
+    //==========================================================================
+    //      Tracing Saves
+    //==========================================================================
+    // the trace of the save in progress, only used by the analysis thread
+    SAFETrace* currentTrace;
+
+    // when the capture for the current save started and finished
+    int64 captureStartTicks, captureEndTicks;
+    Thread::ThreadID captureThreadID;
+
     #if JUCE_LINUX
     SharedResourcePointer <CurlHolder> curl;
     #endif
@@ -376,13 +591,6 @@ private:
     //      Internal Semantic Data Parsing
     //==========================================================================
 
-    /** Set up a local file for the descriptors to be saved to.
-     *
-     *  This should get put in the user's Documents directory in a new
-     *  directory called SAFEPluginData.
-     */
-    void initialiseSemanticDataFile();
-
     /** Populate an XmlElement with the latest set of audio feature data.
      *
      *  @param element   a pointer to the XmlElement to populate
@@ -431,14 +639,37 @@ private:
     //==========================================================================
     //      Analyse Buffered Audio
     //==========================================================================
-    /** Analyses the samples in the recording buffers. */
+    /** Analyses the samples in the recording buffers or the long recording file. */
     WarningID analyseRecordedSamples();
 
-    //==========================================================================
-    //      Make String ok for use in XML
-    //==========================================================================
-    String makeXmlString (String input);
-    
+    /** Analyses a long recording a chunk at a time. */
+    WarningID analyseLongRecording();
+
+    /** Make sure the feature extractors have room for a number of frames.
+     *
+     *  @param numFrames  the number of frames which will be analysed
+     */
+    void initialiseFeatureExtractors (int numFrames);
+
+    /** Analyses one frame of every channel of a recording.
+     *
+     *  @param unprocessedRecording  the unprocessed channels of the recording
+     *  @param processedRecording    the processed channels of the recording
+     *  @param frameStart            the sample in the recordings the frame starts at
+     *  @param frameNum              the analysis frame to analyse
+     */
+    void analyseRecordedFrames (const AudioSampleBuffer& unprocessedRecording, const AudioSampleBuffer& processedRecording, int frameStart, int frameNum);
+
+    /** Analyses one frame of a recording, decimating it to the analysis sample rate first.
+     *
+     *  @param extractor   the feature extractor for the channel
+     *  @param recording   the recording, or a stretch of it, to analyse
+     *  @param channel     the channel of the recording to analyse
+     *  @param frameStart  the sample in the recording the frame starts at
+     *  @param frameNum    the analysis frame to analyse
+     */
+    void analyseRecordedFrame (SAFEFeatureExtractor& extractor, const AudioSampleBuffer& recording, int channel, int frameStart, int frameNum);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SAFEAudioProcessor);
 };
 
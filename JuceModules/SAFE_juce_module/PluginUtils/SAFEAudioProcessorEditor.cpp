@@ -26,7 +26,7 @@ SAFEAudioProcessorEditor::SAFEAudioProcessorEditor (SAFEAudioProcessor* ownerFil
     if (ownerFilter->isRecording())
     {
         recordButton.setMode (SAFEButton::Recording);
-        recordButton.setEnabled (false);
+        recordButton.setEnabled (ownerFilter->isLongRecording());
     }
 
     loadButton.setMode (SAFEButton::Load);
@@ -125,12 +125,16 @@ SAFEAudioProcessorEditor::SAFEAudioProcessorEditor (SAFEAudioProcessor* ownerFil
 
     fileAccessButton.addListener (this);
 
-    descriptorLoadScreen.updateDescriptors (fileAccessButtonPressed, ownerFilter->getSemanticDataElement());
+    ownerFilter->getSemanticData().addChangeListener (this);
+    updateDescriptorList();
 
     warningVisible = false;
     warningFlagged = false;
     flaggedWarningID = NoWarning;
 
+    featureMonitorEnabled = false;
+    lastFeatureMonitorUpdate = 0;
+
     URL versionCheck ("http://193.60.133.151/SAFE/mostRecentVersion.txt");
     float mostRecentVersion = versionCheck.readEntireTextStream().getFloatValue();
 
@@ -145,13 +149,22 @@ SAFEAudioProcessorEditor::SAFEAudioProcessorEditor (SAFEAudioProcessor* ownerFil
         infoButton.setMode (SAFEButton::info);
     }
 
-    // start timer to update sliders
-    startTimer (parameterUpdateTimer, 100);
-    startTimer (meterTimer, 50);
+    // the sliders are updated on the same clock as every other meter in the process,
+    // they get their values on the first frame
+    parametersNeedFullUpdate = true;
+    animationClock->startAnimating (this);
+
+    // the rest only needs looking at a few times a second
+    animationClock->startPolling (this);
 }
 
 SAFEAudioProcessorEditor::~SAFEAudioProcessorEditor()
 {
+    animationClock->stopAnimating (this);
+    animationClock->stopPolling (this);
+    setFeatureMonitorEnabled (false);
+    getProcessor()->getSemanticData().removeChangeListener (this);
+
     SAFEMetaData metaData = metaDataScreen.getMetaData();
 
     metaDataElement->setAttribute ("Location", metaData.location);
@@ -176,7 +189,13 @@ void SAFEAudioProcessorEditor::buttonClicked (Button* button)
     // record / save button
     if (button == &recordButton)
     {
-        if (ourProcessor->isThreadRunning())
+        // clicking again finishes a long recording
+        if (ourProcessor->isLongRecording())
+        {
+            ourProcessor->stopRecording();
+            recordButton.setEnabled (false);
+        }
+        else if (ourProcessor->isThreadRunning())
         {
             displayWarning (AnalysisThreadBusy);
         }
@@ -190,8 +209,11 @@ void SAFEAudioProcessorEditor::buttonClicked (Button* button)
 
             if (ourProcessor->isPlaying())
             {
-                ourProcessor->startRecording (descriptorBoxContent, metaData, fileAccessButtonPressed);
-                recordButton.setEnabled (false);
+                // shift click to keep recording until the button is clicked again
+                const bool longRecording = ModifierKeys::getCurrentModifiers().isShiftDown();
+
+                ourProcessor->startRecording (descriptorBoxContent, metaData, fileAccessButtonPressed, longRecording);
+                recordButton.setEnabled (longRecording);
                 recordButton.setMode (SAFEButton::Recording);
             }
             else
@@ -266,7 +288,16 @@ void SAFEAudioProcessorEditor::buttonClicked (Button* button)
     // info button
     else if (button == &infoButton)
     {
-        showExtraScreen (infoScreen);
+        // shift click dumps the process timings instead
+        if (ModifierKeys::getCurrentModifiers().isShiftDown())
+        {
+            const Result saved = getProcessor()->saveProcessTimings();
+            displayWarning (saved.wasOk() ? TimingsSaved : TimingsNotSaved, 2000);
+        }
+        else
+        {
+            showExtraScreen (infoScreen);
+        }
     }
     else if (button == &infoScreen.closeButton)
     {
@@ -286,7 +317,7 @@ void SAFEAudioProcessorEditor::buttonClicked (Button* button)
             fileAccessButtonPressed = true;
         }
 
-        descriptorLoadScreen.updateDescriptors (fileAccessButtonPressed, ourProcessor->getSemanticDataElement());
+        updateDescriptorList();
     }
 }
 
@@ -311,50 +342,114 @@ void SAFEAudioProcessorEditor::sliderValueChanged (Slider* slider)
 //==========================================================================
 void SAFEAudioProcessorEditor::timerCallback (int timerID)
 {
-    if (timerID == parameterUpdateTimer)
+    if (timerID == warningTimer)
     {
-        // update sliders to new values
-        SAFEAudioProcessor* ourProcessor = getProcessor();
+        // show warnings
+        stopTimer (warningTimer);
+        descriptorBox.setColour (TextEditor::textColourId, Colours::black);
+        descriptorBox.setText (savedDescriptorBoxContent);
+        descriptorBox.setReadOnly (false);
 
-        if (ourProcessor->isReadyToSave() && ! extraScreenVisible && ! warningVisible)
-        {
-            recordButton.setMode (SAFEButton::Save);
+        recordButton.setEnabled (true);
+        loadButton.setEnabled (true);
+        metaDataButton.setEnabled (true);
 
-            {
-                recordButton.setEnabled (true);
-            }
-        }
+        warningVisible = false;
+    }
+}
 
-        if (warningFlagged)
-        {
-            displayWarning (flaggedWarningID, 1000);
-            warningFlagged = false;
-        }
+//==========================================================================
+//      Frame Updates
+//==========================================================================
+bool SAFEAudioProcessorEditor::advanceAnimation (double /*timeNow*/)
+{
+    return updateParameters();
+}
+
+bool SAFEAudioProcessorEditor::updateParameters()
+{
+    SAFEAudioProcessor* ourProcessor = getProcessor();
+    uint64 changedParameters = ourProcessor->getAndClearChangedParameters();
+
+    if (parametersNeedFullUpdate)
+    {
+        changedParameters = ~ (uint64) 0;
+        parametersNeedFullUpdate = false;
+    }
+
+    if (changedParameters == 0)
+    {
+        return false;
+    }
 
-        for (int n = 0; n < numParameters; ++n)
+    // update the sliders of the parameters which have changed
+    for (int n = 0; n < numParameters; ++n)
+    {
+        if ((changedParameters >> n) & 1)
         {
             sliders [n]->setValue (ourProcessor->getScaledParameter (n), dontSendNotification);
         }
+    }
+
+    updateUI();
 
-        updateUI();
+    return true;
+}
+
+void SAFEAudioProcessorEditor::pollForChanges()
+{
+    // the next frame picks up which parameters have changed
+    if (getProcessor()->hasChangedParameters())
+    {
+        animationClock->startAnimating (this);
     }
-    else if (timerID == warningTimer)
+
+    updateRecordingStatus();
+    updateMeters();
+
+    if (featureMonitorEnabled)
     {
-        // show warnings
-        stopTimer (warningTimer);
-        descriptorBox.setColour (TextEditor::textColourId, Colours::black);
-        descriptorBox.setText (savedDescriptorBoxContent);
-        descriptorBox.setReadOnly (false);
+        SAFEFeatureMonitor& featureMonitor = getProcessor()->getFeatureMonitor();
+        const int updateCount = featureMonitor.getUpdateCount();
+
+        if (updateCount != lastFeatureMonitorUpdate && featureMonitor.getLatestValues (featureMonitorValues))
+        {
+            lastFeatureMonitorUpdate = updateCount;
+            updateFeatureMonitor (featureMonitor.getFeatureNames(), featureMonitorValues);
+        }
+    }
+}
 
+void SAFEAudioProcessorEditor::updateRecordingStatus()
+{
+    SAFEAudioProcessor* ourProcessor = getProcessor();
+
+    recordButton.setProgress (ourProcessor->getAnalysisProgress());
+
+    if (ourProcessor->isReadyToSave() && ! extraScreenVisible && ! warningVisible)
+    {
+        recordButton.setMode (SAFEButton::Save);
         recordButton.setEnabled (true);
-        loadButton.setEnabled (true);
-        metaDataButton.setEnabled (true);
+    }
 
-        warningVisible = false;
+    if (warningFlagged)
+    {
+        displayWarning (flaggedWarningID, 1000);
+        warningFlagged = false;
     }
-    else if (timerID == meterTimer)
+}
+
+//==========================================================================
+//      Live Features
+//==========================================================================
+void SAFEAudioProcessorEditor::setFeatureMonitorEnabled (bool shouldBeEnabled)
+{
+    if (shouldBeEnabled != featureMonitorEnabled)
     {
-        updateMeters();
+        featureMonitorEnabled = shouldBeEnabled;
+        lastFeatureMonitorUpdate = 0;
+
+        getProcessor()->getFeatureMonitor().setActive (featureMonitorEnabled);
     }
 }
 
@@ -453,6 +548,20 @@ void SAFEAudioProcessorEditor::hideExtraScreen (SAFEExtraScreen& screenToHide, E
     extraScreenVisible = false;
 }
 
+void SAFEAudioProcessorEditor::updateDescriptorList()
+{
+    descriptorLoadScreen.updateDescriptors (fileAccessButtonPressed, getProcessor()->getSemanticData().getDescriptors());
+}
+
+void SAFEAudioProcessorEditor::changeListenerCallback (ChangeBroadcaster*)
+{
+    // the server list doesn't change when the local file does
+    if (! fileAccessButtonPressed)
+    {
+        updateDescriptorList();
+    }
+}
+
 //==========================================================================
 //      Show Warning Messages in Text Box
 //==========================================================================
@@ -499,6 +608,29 @@ void SAFEAudioProcessorEditor::displayWarning (WarningID id, int durationInMilli
             case CannotReachServer:
                 warningMessage = "Can't reach the server, check your internet connection";
                 break;
+
+            case TimingsSaved:
+                warningMessage = "Processing timings saved to the SAFEPluginData folder.";
+                break;
+
+            case TimingsNotSaved:
+                warningMessage = "Couldn't save the processing timings.";
+                break;
+
+            case LongRecordingFailed:
+                warningMessage = "The long recording couldn't be written to disk, so it wasn't saved.";
+                break;
+
+            case LongRecordingTooShort:
+                warningMessage = "That recording was too short to analyse, keep it going a bit longer.";
+                break;
+
+            case AnalysisInterrupted:
+                warningMessage = "The audio settings changed while the recording was being analysed, so it wasn't saved.";
+                break;
+
+            default:
+                break;
         }
 
         recordButton.setEnabled (false);
@@ -7,7 +7,10 @@
 class SAFEAudioProcessorEditor : public AudioProcessorEditor,
                                  public Button::Listener,
                                  public Slider::Listener,
-                                 public MultiTimer
+                                 public MultiTimer,
+                                 private AnimationClock::Client,
+                                 private AnimationClock::Poller,
+                                 private ChangeListener
 {
 public:
     //==========================================================================
@@ -44,7 +47,7 @@ public:
     //==========================================================================
     //      GUI Update Timer
     //==========================================================================
-    /** Timer callbacks for UI and metering updates.
+    /** Timer callback which clears warning messages.
      *  
      *  As ever we probably should be inheriting privately from MultiTimer.
      */
@@ -53,7 +56,8 @@ public:
     /** A function called to update the parameter values in the user interface.
      *
      *  Parameter sliders should update themselves automatically when parameter values are
-     *  change through other means.
+     *  change through other means. This is called once when the editor opens, then 
+     *  only on frames where a parameter has changed.
      *
      *  If your editor should react in any other way to updates in parameter
      *  values override this function and have your way with it.
@@ -70,6 +74,16 @@ public:
      */
     virtual void updateMeters() {};
 
+    /** A function called when the live feature monitor has new values.
+     *
+     *  This only gets called once setFeatureMonitorEnabled() has switched the monitor
+     *  on. Override it to show the values somewhere in your UI.
+     *
+     *  @param featureNames   the names of the features
+     *  @param featureValues  the latest value of each feature
+     */
+    virtual void updateFeatureMonitor (const StringArray& /*featureNames*/, const Array <double>& /*featureValues*/) {};
+
     //==========================================================================
     //      Externally Flag Warning
     //==========================================================================
@@ -105,12 +119,23 @@ protected:
      */
     void setExtraScreenPosition (int x, int y);
 
+    //==========================================================================
+    //      Live Features
+    //==========================================================================
+    /** Switch the processor's live feature monitor on or off.
+     *
+     *  While it is on updateFeatureMonitor() is called with new values a few times
+     *  a second. It is switched off again when the editor is closed, so the audio 
+     *  thread does no extra work without an editor to show the values.
+     *
+     *  @param shouldBeEnabled  whether the monitor should run
+     */
+    void setFeatureMonitorEnabled (bool shouldBeEnabled);
+
 private:
     enum Timers
     {
-        parameterUpdateTimer,
-        warningTimer,
-        meterTimer
+        warningTimer
     };
 
     enum ExtraScreenLocation
@@ -126,6 +151,40 @@ private:
 
     bool fileAccessButtonPressed;
 
+    bool featureMonitorEnabled;
+    int lastFeatureMonitorUpdate;
+    Array <double> featureMonitorValues;
+
+    //==========================================================================
+    //      Frame Updates
+    //==========================================================================
+    /** Update the sliders of changing parameters on the shared animation clock.
+     *
+     *  The editor only animates while parameters are changing. It stops after the
+     *  first frame where none have, and pollForChanges() starts it again.
+     */
+    bool advanceAnimation (double timeNow) override;
+
+    /** Update the sliders of any parameters which have changed, and call updateUI() if there are some.
+     *
+     *  Returns true if any parameters had changed.
+     */
+    bool updateParameters();
+
+    /** Start animating if parameters have changed, and update the recording status,
+     *  the meters and the feature monitor.
+     *
+     *  The shared clock polls this every AnimationClock::pollInterval milliseconds,
+     *  so however many editors are open they are all polled on the one timer.
+     */
+    void pollForChanges() override;
+
+    /** Update the record button and show any warnings which have been flagged. */
+    void updateRecordingStatus();
+
+    SharedResourcePointer <AnimationClock> animationClock;
+    bool parametersNeedFullUpdate;
+
     //==========================================================================
     //      Extra Screen Bits
     //==========================================================================
@@ -137,6 +196,12 @@ private:
 
     SAFEDescriptorLoadScreen descriptorLoadScreen;
 
+    /** Fill the descriptor load screen from the server or the local data file. */
+    void updateDescriptorList();
+
+    /** Refresh the local descriptors when the data file has loaded or been saved to. */
+    void changeListenerCallback (ChangeBroadcaster* source) override;
+
     SAFEInfoScreen infoScreen;
 
     int extraScreenXPos, extraScreenYPos;
@@ -0,0 +1,275 @@
+//==========================================================================
+//      Constructor and Destructor
+//==========================================================================
+SAFECaptureFile::SAFECaptureFile()
+    : Thread ("CaptureFileWriter"),
+      numUnprocessed (0),
+      numProcessed (0),
+      fifo (1),
+      pendingSamples (0),
+      droppedSamples (false),
+      writeFailed (false),
+      numSamplesWritten (0)
+{
+}
+
+SAFECaptureFile::~SAFECaptureFile()
+{
+    stop();
+    deleteFile();
+}
+
+//==========================================================================
+//      Setup
+//==========================================================================
+void SAFECaptureFile::prepare (int numUnprocessedChannels, int numProcessedChannels, int fifoSize)
+{
+    jassert (! isThreadRunning());
+
+    numUnprocessed = numUnprocessedChannels;
+    numProcessed = numProcessedChannels;
+
+    fifoBuffer.setSize (getNumChannels(), fifoSize);
+    fifo.setTotalSize (fifoSize);
+    pendingSamples = 0;
+
+    interleaved.allocate (interleavedLength * getNumChannels(), true);
+}
+
+int SAFECaptureFile::getNumChannels() const
+{
+    return numUnprocessed + numProcessed;
+}
+
+//==========================================================================
+//      Capturing
+//==========================================================================
+bool SAFECaptureFile::start()
+{
+    stop();
+    deleteFile();
+
+    file = File::createTempFile (".safecapture");
+    stream = new FileOutputStream (file);
+
+    if (stream->failedToOpen())
+    {
+        stream = nullptr;
+        return false;
+    }
+
+    fifo.reset();
+    pendingSamples = 0;
+    droppedSamples = false;
+    writeFailed = false;
+    numSamplesWritten = 0;
+
+    startThread();
+
+    return true;
+}
+
+void SAFECaptureFile::addUnprocessedSamples (const AudioSampleBuffer& buffer)
+{
+    const int numSamples = buffer.getNumSamples();
+    pendingSamples = 0;
+
+    if (numSamples == 0)
+    {
+        return;
+    }
+
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite (numSamples, start1, size1, start2, size2);
+
+    // don't wait for the writer thread, just lose the block
+    if (size1 + size2 < numSamples)
+    {
+        droppedSamples = true;
+        return;
+    }
+
+    for (int channel = 0; channel < numUnprocessed; ++channel)
+    {
+        fifoBuffer.copyFrom (channel, start1, buffer, channel, 0, size1);
+
+        if (size2 > 0)
+        {
+            fifoBuffer.copyFrom (channel, start2, buffer, channel, size1, size2);
+        }
+    }
+
+    pendingSamples = numSamples;
+}
+
+void SAFECaptureFile::addProcessedSamples (const AudioSampleBuffer& buffer)
+{
+    if (pendingSamples == 0)
+    {
+        return;
+    }
+
+    // nothing has been written since the unprocessed half, so this is the same space
+    const int numSamples = jmin (pendingSamples, buffer.getNumSamples());
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite (numSamples, start1, size1, start2, size2);
+
+    for (int channel = 0; channel < numProcessed; ++channel)
+    {
+        fifoBuffer.copyFrom (numUnprocessed + channel, start1, buffer, channel, 0, size1);
+
+        if (size2 > 0)
+        {
+            fifoBuffer.copyFrom (numUnprocessed + channel, start2, buffer, channel, size1, size2);
+        }
+    }
+
+    fifo.finishedWrite (size1 + size2);
+    pendingSamples = 0;
+}
+
+bool SAFECaptureFile::stop()
+{
+    if (isThreadRunning())
+    {
+        // the thread empties the fifo on its way out
+        signalThreadShouldExit();
+        notify();
+        waitForThreadToExit (-1);
+    }
+
+    if (stream != nullptr)
+    {
+        stream->flush();
+        writeFailed = writeFailed || stream->getStatus().failed();
+        stream = nullptr;
+    }
+
+    return ! droppedSamples && ! writeFailed;
+}
+
+//==========================================================================
+//      Reading the Capture
+//==========================================================================
+int64 SAFECaptureFile::getNumSamples() const
+{
+    return numSamplesWritten;
+}
+
+bool SAFECaptureFile::readSamples (AudioSampleBuffer& destination, int64 startSample, int numSamples)
+{
+    jassert (destination.getNumChannels() >= getNumChannels() && destination.getNumSamples() >= numSamples);
+    jassert (stream == nullptr);
+
+    destination.clear (0, numSamples);
+
+    // only the part of the stretch that was captured comes from the file
+    const int64 firstSample = jmax ((int64) 0, startSample);
+    const int64 endSample = jmin (numSamplesWritten, startSample + numSamples);
+
+    if (firstSample >= endSample)
+    {
+        return true;
+    }
+
+    FileInputStream input (file);
+    const int numChannels = getNumChannels();
+    const size_t bytesPerSample = sizeof (float) * (size_t) numChannels;
+    HeapBlock <float> samplesRead ((size_t) (interleavedLength * numChannels));
+
+    if (input.failedToOpen() || ! input.setPosition (firstSample * (int64) bytesPerSample))
+    {
+        return false;
+    }
+
+    for (int64 sample = firstSample; sample < endSample; sample += interleavedLength)
+    {
+        const int numToRead = (int) jmin ((int64) interleavedLength, endSample - sample);
+        const int bytesToRead = numToRead * (int) bytesPerSample;
+
+        if (input.read (samplesRead, bytesToRead) != bytesToRead)
+        {
+            return false;
+        }
+
+        const int destinationSample = (int) (sample - startSample);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            float* channelData = destination.getWritePointer (channel, destinationSample);
+
+            for (int i = 0; i < numToRead; ++i)
+            {
+                channelData [i] = samplesRead [i * numChannels + channel];
+            }
+        }
+    }
+
+    return true;
+}
+
+void SAFECaptureFile::deleteFile()
+{
+    jassert (! isThreadRunning());
+
+    if (file != File::nonexistent)
+    {
+        file.deleteFile();
+        file = File::nonexistent;
+    }
+
+    numSamplesWritten = 0;
+}
+
+//==========================================================================
+//      The Thread Callback
+//==========================================================================
+void SAFECaptureFile::run()
+{
+    while (! threadShouldExit())
+    {
+        writeFifoToFile();
+        wait (10);
+    }
+
+    writeFifoToFile();
+}
+
+void SAFECaptureFile::writeFifoToFile()
+{
+    const int numChannels = getNumChannels();
+    int numReady;
+
+    while ((numReady = fifo.getNumReady()) > 0)
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToRead (jmin (numReady, interleavedLength), start1, size1, start2, size2);
+
+        // interleave both parts of the fifo so the file can be appended to in one go
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            const float* firstPart = fifoBuffer.getReadPointer (channel, start1);
+            const float* secondPart = fifoBuffer.getReadPointer (channel, start2);
+
+            for (int i = 0; i < size1; ++i)
+            {
+                interleaved [i * numChannels + channel] = firstPart [i];
+            }
+
+            for (int i = 0; i < size2; ++i)
+            {
+                interleaved [(size1 + i) * numChannels + channel] = secondPart [i];
+            }
+        }
+
+        const int numRead = size1 + size2;
+
+        if (! stream->write (interleaved, sizeof (float) * (size_t) (numRead * numChannels)))
+        {
+            writeFailed = true;
+        }
+
+        numSamplesWritten += numRead;
+        fifo.finishedRead (numRead);
+    }
+}
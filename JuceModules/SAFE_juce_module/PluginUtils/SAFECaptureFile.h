@@ -0,0 +1,126 @@
+#ifndef __SAFECAPTUREFILE__
+#define __SAFECAPTUREFILE__
+
+/**
+ *  Streams a recording to a temporary file so it can be longer than fits in memory.
+ *
+ *  The audio thread adds samples to a fixed size FIFO, which is all that is held in
+ *  memory while recording. A writer thread empties the FIFO into an append only file
+ *  of interleaved floats, so the audio thread never touches the disk. Once the capture
+ *  has been stopped the file can be read back a stretch at a time.
+ *
+ *  Each block is added in two halves, the unprocessed channels and then the processed
+ *  channels, because the processing happens in place between the two. If the writer
+ *  thread falls behind and the FIFO fills up the capture is marked as having dropped
+ *  samples rather than blocking the audio thread.
+ */
+class SAFECaptureFile : private Thread
+{
+public:
+    //==========================================================================
+    //      Constructor and Destructor
+    //==========================================================================
+    /** Create a new capture file. */
+    SAFECaptureFile();
+
+    /** Destructor, deletes the temporary file. */
+    ~SAFECaptureFile();
+
+    //==========================================================================
+    //      Setup
+    //==========================================================================
+    /** Allocate the FIFO.
+     *
+     *  This must not be called while capturing.
+     *
+     *  @param numUnprocessedChannels  the number of channels added by addUnprocessedSamples()
+     *  @param numProcessedChannels    the number of channels added by addProcessedSamples()
+     *  @param fifoSize                the number of samples of each channel the FIFO holds
+     */
+    void prepare (int numUnprocessedChannels, int numProcessedChannels, int fifoSize);
+
+    /** Returns the total number of channels in the capture. */
+    int getNumChannels() const;
+
+    //==========================================================================
+    //      Capturing
+    //==========================================================================
+    /** Create a new temporary file and start the writer thread.
+     *
+     *  Returns false if the file couldn't be created.
+     */
+    bool start();
+
+    /** Add the unprocessed half of a block.
+     *
+     *  This is called from the audio thread and doesn't allocate or wait.
+     *
+     *  @param buffer  the block, only as many channels as were given to prepare() are used
+     */
+    void addUnprocessedSamples (const AudioSampleBuffer& buffer);
+
+    /** Add the processed half of the block given to the last addUnprocessedSamples().
+     *
+     *  This is called from the audio thread and doesn't allocate or wait.
+     *
+     *  @param buffer  the block, only as many channels as were given to prepare() are used
+     */
+    void addProcessedSamples (const AudioSampleBuffer& buffer);
+
+    /** Stop the writer thread once it has written everything in the FIFO.
+     *
+     *  Returns false if any samples were dropped or couldn't be written, in which case
+     *  the file shouldn't be analysed.
+     */
+    bool stop();
+
+    //==========================================================================
+    //      Reading the Capture
+    //==========================================================================
+    /** Returns the number of samples of each channel in the file. */
+    int64 getNumSamples() const;
+
+    /** Read a stretch of the file.
+     *
+     *  Samples before the start or after the end of the capture are read as zero.
+     *
+     *  @param destination  a buffer with getNumChannels() channels to read into
+     *  @param startSample  the sample in the capture to start reading from
+     *  @param numSamples   the number of samples of each channel to read
+     *
+     *  Returns false if the file couldn't be read.
+     */
+    bool readSamples (AudioSampleBuffer& destination, int64 startSample, int numSamples);
+
+    /** Delete the temporary file. */
+    void deleteFile();
+
+private:
+    //==========================================================================
+    //      The Thread Callback
+    //==========================================================================
+    void run() override;
+
+    /** Write everything in the FIFO to the file. */
+    void writeFifoToFile();
+
+    int numUnprocessed, numProcessed;
+
+    AudioSampleBuffer fifoBuffer;
+    AbstractFifo fifo;
+    int pendingSamples;
+    bool droppedSamples;
+
+    File file;
+    ScopedPointer <FileOutputStream> stream;
+    bool writeFailed;
+    int64 numSamplesWritten;
+
+    // interleaved samples on their way to the file
+    static const int interleavedLength = 4096;
+    HeapBlock <float> interleaved;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SAFECaptureFile);
+};
+
+#endif // __SAFECAPTUREFILE__
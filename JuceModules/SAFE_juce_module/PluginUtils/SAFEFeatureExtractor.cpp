@@ -1,7 +1,69 @@
+//==========================================================================
+//      Feature Graph
+//==========================================================================
+/*  The name, number of values and dependencies of each feature and spectrum.
+ *  A node is only calculated once its dependencies have been, and the features
+ *  keep the order they have always had in the feature array.
+ */
+const SAFEFeatureExtractor::Node SAFEFeatureExtractor::nodes [numNodes] =
+{
+    {"Mean", 1, {noNode, noNode}},
+    {"Variance", 1, {meanFeature, noNode}},
+    {"Standard_Deviation", 1, {varianceFeature, noNode}},
+    {"RMS_Amplitude", 1, {noNode, noNode}},
+    {"Zero_Crossing_Rate", 1, {noNode, noNode}},
+    {"Spectral_Centroid", 1, {spectrumNode, noNode}},
+    {"Spectral_Variance", 1, {spectralCentroidFeature, noNode}},
+    {"Spectral_Standard_Deviation", 1, {spectralVarianceFeature, noNode}},
+    {"Spectral_Skewness", 1, {spectralCentroidFeature, spectralStandardDeviationFeature}},
+    {"Spectral_Kurtosis", 1, {spectralCentroidFeature, spectralStandardDeviationFeature}},
+    {"Irregularity_J", 1, {spectrumNode, noNode}},
+    {"Irregularity_K", 1, {spectrumNode, noNode}},
+    {"Fundamental", 1, {noNode, noNode}},
+    {"Smoothness", 1, {spectrumNode, noNode}},
+    {"Spectral_Roll_Off", 1, {spectrumNode, noNode}},
+    {"Spectral_Flatness", 1, {spectrumNode, noNode}},
+    {"Tonality", 1, {flatnessFeature, noNode}},
+    {"Spectral_Crest", 1, {spectrumNode, noNode}},
+    {"Spectral_Slope", 1, {spectrumNode, noNode}},
+    {"Peak_Spectral_Centroid", 1, {peakSpectrumNode, noNode}},
+    {"Peak_Spectral_Variance", 1, {peakSpectralCentroidFeature, noNode}},
+    {"Peak_Spectral_Standard_Deviation", 1, {peakSpectralVarianceFeature, noNode}},
+    {"Peak_Spectral_Skewness", 1, {peakSpectralCentroidFeature, peakSpectralStandardDeviationFeature}},
+    {"Peak_Spectral_Kurtosis", 1, {peakSpectralCentroidFeature, peakSpectralStandardDeviationFeature}},
+    {"Peak_Irregularity_J", 1, {peakSpectrumNode, noNode}},
+    {"Peak_Irregularity_K", 1, {peakSpectrumNode, noNode}},
+    {"Peak_Tristimulus_1", 1, {peakSpectrumNode, fundamentalFeature}},
+    {"Peak_Tristimulus_2", 1, {peakSpectrumNode, fundamentalFeature}},
+    {"Peak_Tristimulus_3", 1, {peakSpectrumNode, fundamentalFeature}},
+    {"Inharmonicity", 1, {peakSpectrumNode, fundamentalFeature}},
+    {"Harmonic_Spectral_Centroid", 1, {harmonicSpectrumNode, noNode}},
+    {"Harmonic_Spectral_Variance", 1, {harmonicSpectralCentroidFeature, noNode}},
+    {"Harmonic_Spectral_Standard_Deviation", 1, {harmonicSpectralVarianceFeature, noNode}},
+    {"Harmonic_Spectral_Skewness", 1, {harmonicSpectralCentroidFeature, harmonicSpectralStandardDeviationFeature}},
+    {"Harmonic_Spectral_Kurtosis", 1, {harmonicSpectralCentroidFeature, harmonicSpectralStandardDeviationFeature}},
+    {"Harmonic_Irregularity_J", 1, {harmonicSpectrumNode, noNode}},
+    {"Harmonic_Irregularity_K", 1, {harmonicSpectrumNode, noNode}},
+    {"Harmonic_Tristimulus_1", 1, {harmonicSpectrumNode, fundamentalFeature}},
+    {"Harmonic_Tristimulus_2", 1, {harmonicSpectrumNode, fundamentalFeature}},
+    {"Harmonic_Tristimulus_3", 1, {harmonicSpectrumNode, fundamentalFeature}},
+    {"Noisiness", 1, {harmonicSpectrumNode, peakSpectrumNode}},
+    {"Parity_Ratio", 1, {harmonicSpectrumNode, fundamentalFeature}},
+    {"Bark_Coefficient", numBarkCoefficients, {spectrumNode, noNode}},
+    {"MFCC", numMfccs, {spectrumNode, noNode}},
+    {"Spectrum", 0, {noNode, noNode}},
+    {"Peak_Spectrum", 0, {spectrumNode, noNode}},
+    {"Harmonic_Spectrum", 0, {peakSpectrumNode, fundamentalFeature}}
+};
+
 //==========================================================================
 //      Constructor and Destructor
 //==========================================================================
 SAFEFeatureExtractor::SAFEFeatureExtractor()
+    : featureSet (getFullFeatureSet()),
+      numAnalysisFrames (0),
+      analysisFrameLength (0),
+      fs (0)
 {
 }
 
@@ -15,166 +77,390 @@ void SAFEFeatureExtractor::initialise (int numAnalysisFramesInit, int analysisFr
     analysisFrameLength = analysisFrameLengthInit;
     fs = sampleRate;
 
-    // initialise storage for time domain features
-    means.allocate (numAnalysisFrames, true);
-    variances.allocate (numAnalysisFrames, true);
-    standardDeviations.allocate (numAnalysisFrames, true);
-    rmsAmplitudes.allocate (numAnalysisFrames, true);
-    zeroCrossingRates.allocate (numAnalysisFrames, true);
-    
-    // initialise storage for spectral features
+    // initialise storage for the features of every frame
+    featureValues.allocate (numAnalysisFrames * numFeatureValues, true);
+
+    // initialise storage for the samples and spectra of the current frame
+    frameSamples.allocate (analysisFrameLength, true);
     spectrum.allocate (analysisFrameLength, true);
-    spectralCentroids.allocate (numAnalysisFrames, true);
-    spectralVariances.allocate (numAnalysisFrames, true);
-    spectralStandardDeviations.allocate (numAnalysisFrames, true);
-    spectralSkewnesses.allocate (numAnalysisFrames, true);
-    spectralKurtosises.allocate (numAnalysisFrames, true);
-    irregularityJs.allocate (numAnalysisFrames, true);
-    irregularityKs.allocate (numAnalysisFrames, true);
-    fundamentals.allocate (numAnalysisFrames, true);
-    smoothnesses.allocate (numAnalysisFrames, true);
-    rolloffs.allocate (numAnalysisFrames, true);
-    flatnesses.allocate (numAnalysisFrames, true);
-    tonalities.allocate (numAnalysisFrames, true);
-    crests.allocate (numAnalysisFrames, true);
-    spectralSlopes.allocate (numAnalysisFrames, true);
-
-    // initialise storage for peak spectral features
     peakSpectrum.allocate (analysisFrameLength, true);
-    peakSpectralCentroids.allocate (numAnalysisFrames, true);
-    peakSpectralVariances.allocate (numAnalysisFrames, true);
-    peakSpectralStandardDeviations.allocate (numAnalysisFrames, true);
-    peakSpectralSkewnesses.allocate (numAnalysisFrames, true);
-    peakSpectralKurtosises.allocate (numAnalysisFrames, true);
-    peakIrregularityJs.allocate (numAnalysisFrames, true);
-    peakIrregularityKs.allocate (numAnalysisFrames, true);
-    peakTristimulus1s.allocate (numAnalysisFrames, true);
-    peakTristimulus2s.allocate (numAnalysisFrames, true);
-    peakTristimulus3s.allocate (numAnalysisFrames, true);
-    inharmonicities.allocate (numAnalysisFrames, true);
-
-    // initialise storage for harmonic spectral features
     harmonicSpectrum.allocate (analysisFrameLength, true);
-    harmonicSpectralCentroids.allocate (numAnalysisFrames, true);
-    harmonicSpectralVariances.allocate (numAnalysisFrames, true);
-    harmonicSpectralStandardDeviations.allocate (numAnalysisFrames, true);
-    harmonicSpectralSkewnesses.allocate (numAnalysisFrames, true);
-    harmonicSpectralKurtosises.allocate (numAnalysisFrames, true);
-    harmonicIrregularityJs.allocate (numAnalysisFrames, true);
-    harmonicIrregularityKs.allocate (numAnalysisFrames, true);
-    harmonicTristimulus1s.allocate (numAnalysisFrames, true);
-    harmonicTristimulus2s.allocate (numAnalysisFrames, true);
-    harmonicTristimulus3s.allocate (numAnalysisFrames, true);
-    noisinesses.allocate (numAnalysisFrames, true);
-    parityRatios.allocate (numAnalysisFrames, true);
-
-    // initialise storage for bark and mfcc features
+
+    // initialise bark and mfcc filters
+    const ScopedLock sl (libXtract->lock);
+
+    libXtract->setFrameLength (analysisFrameLength);
     xtract_init_bark (analysisFrameLength, fs, libXtract->barkBandLimits);
-    barkCoefficients.clear();
-    
     xtract_init_mfcc (analysisFrameLength / 2, fs / 2, XTRACT_EQUAL_GAIN, 20, 20000, libXtract->melFilters.n_filters, libXtract->melFilters.filters);
-    mfccs.clear();
 
-    for (int n = 0; n < numAnalysisFrames; ++n)
+    xtract_init_wavelet_f0_state();
+}
+
+//==========================================================================
+//      Choosing Features
+//==========================================================================
+void SAFEFeatureExtractor::setFeatureSet (const BigInteger& newFeatureSet)
+{
+    featureSet = newFeatureSet.getBitRange (0, numFeatures);
+}
+
+const BigInteger& SAFEFeatureExtractor::getFeatureSet() const
+{
+    return featureSet;
+}
+
+BigInteger SAFEFeatureExtractor::getFullFeatureSet()
+{
+    BigInteger fullFeatureSet;
+    fullFeatureSet.setRange (0, numFeatures, true);
+
+    return fullFeatureSet;
+}
+
+bool SAFEFeatureExtractor::getFeatureSetFromNames (const StringArray& names, BigInteger& featureSetToFill)
+{
+    featureSetToFill.clear();
+
+    for (int i = 0; i < names.size(); ++i)
     {
-        barkCoefficients.add (new Array <double>);
-        barkCoefficients [n]->resize (25);
+        bool nameFound = false;
+
+        for (int feature = 0; feature < numFeatures && ! nameFound; ++feature)
+        {
+            BigInteger singleFeature;
+            singleFeature.setBit (feature);
+
+            if (names [i] == nodes [feature].name || getFeatureNames (singleFeature).contains (names [i]))
+            {
+                featureSetToFill.setBit (feature);
+                nameFound = true;
+            }
+        }
 
-        mfccs.add (new Array <double>);
-        mfccs [n]->resize (13);
+        if (! nameFound)
+        {
+            return false;
+        }
     }
 
-    xtract_init_wavelet_f0_state();
+    return true;
 }
 
-void SAFEFeatureExtractor::getAllFeatures (double* sampleData, int numSamples, int frameNum)
+//==========================================================================
+//      Analysis
+//==========================================================================
+void SAFEFeatureExtractor::analyseFrame (double* sampleData, int numSamples, int frameNum)
 {
-    // time domain features
-    xtract_mean (sampleData, numSamples, NULL, means + frameNum);
-    xtract_variance (sampleData, numSamples, means + frameNum, variances + frameNum);
-    xtract_standard_deviation (sampleData, numSamples, variances + frameNum, standardDeviations + frameNum);
-    xtract_rms_amplitude (sampleData, numSamples, NULL, rmsAmplitudes + frameNum);
-    xtract_zcr (sampleData, numSamples, NULL, zeroCrossingRates + frameNum);
-
-    // spectral features
-    double argumentArray [4] = {fs / numSamples, XTRACT_MAGNITUDE_SPECTRUM, 0, 0};
-    xtract_spectrum (sampleData, numSamples, argumentArray, spectrum);
-    xtract_spectral_centroid (spectrum, numSamples, NULL, spectralCentroids + frameNum);
-    xtract_spectral_variance (spectrum, numSamples, spectralCentroids + frameNum, spectralVariances + frameNum);
-    xtract_spectral_standard_deviation (spectrum, numSamples, spectralVariances + frameNum, spectralStandardDeviations + frameNum);
-    argumentArray [0] = spectralCentroids [frameNum];
-    argumentArray [1] = spectralStandardDeviations [frameNum];
-    xtract_spectral_skewness (spectrum, numSamples, argumentArray, spectralSkewnesses + frameNum);
-    xtract_spectral_kurtosis (spectrum, numSamples, argumentArray, spectralKurtosises + frameNum);
-    xtract_irregularity_j (spectrum, numSamples / 2, NULL, irregularityJs + frameNum);
-    xtract_irregularity_k (spectrum, numSamples / 2, NULL, irregularityKs + frameNum);
-    xtract_wavelet_f0 (sampleData, numSamples, &fs, fundamentals + frameNum);
-    xtract_smoothness (spectrum, numSamples / 2, NULL, smoothnesses + frameNum);
-    argumentArray [0] = fs / numSamples;
-    argumentArray [1] = 45;
-    xtract_rolloff (spectrum, numSamples / 2, argumentArray, rolloffs + frameNum);
-    xtract_flatness (spectrum, numSamples / 2, NULL, flatnesses + frameNum);
-    double logFlatness;
-    xtract_flatness_db (NULL, 0, flatnesses + frameNum, &logFlatness);
-    xtract_tonality (NULL, 0, &logFlatness, tonalities + frameNum);
-    xtract_highest_value (spectrum, numSamples / 2, NULL, argumentArray);
-    xtract_mean (spectrum, numSamples / 2, NULL, argumentArray + 1);
-    xtract_crest (NULL, 0, argumentArray, crests + frameNum);
-    xtract_spectral_slope (spectrum, numSamples, NULL, spectralSlopes + frameNum);
-
-    // peak spectrum features
-    argumentArray [0] = fs / numSamples;
-    argumentArray [1] = 10;
-    xtract_peak_spectrum (spectrum, numSamples / 2, argumentArray, peakSpectrum);
-    xtract_spectral_centroid (peakSpectrum, numSamples, NULL, peakSpectralCentroids + frameNum);
-    xtract_spectral_variance (peakSpectrum, numSamples, peakSpectralCentroids + frameNum, peakSpectralVariances + frameNum);
-    xtract_spectral_standard_deviation (peakSpectrum, numSamples, peakSpectralVariances + frameNum, peakSpectralStandardDeviations + frameNum);
-    argumentArray [0] = peakSpectralCentroids [frameNum];
-    argumentArray [1] = peakSpectralStandardDeviations [frameNum];
-    xtract_spectral_skewness (peakSpectrum, numSamples, argumentArray, peakSpectralSkewnesses + frameNum);
-    xtract_spectral_kurtosis (peakSpectrum, numSamples, argumentArray, peakSpectralKurtosises + frameNum);
-    xtract_irregularity_j (peakSpectrum, numSamples / 2, NULL, peakIrregularityJs + frameNum);
-    xtract_irregularity_k (peakSpectrum, numSamples / 2, NULL, peakIrregularityKs + frameNum);
-    xtract_tristimulus_1 (peakSpectrum, numSamples, fundamentals + frameNum, peakTristimulus1s + frameNum);
-    xtract_tristimulus_2 (peakSpectrum, numSamples, fundamentals + frameNum, peakTristimulus2s + frameNum);
-    xtract_tristimulus_3 (peakSpectrum, numSamples, fundamentals + frameNum, peakTristimulus3s + frameNum);
-    xtract_spectral_inharmonicity (peakSpectrum, numSamples, fundamentals + frameNum, inharmonicities + frameNum);
-
-    // harmonic spectrum features
-    argumentArray [0] = fundamentals [frameNum];
-    argumentArray [1] = 0.2;
-    xtract_harmonic_spectrum (peakSpectrum, numSamples, argumentArray, harmonicSpectrum);
-    xtract_spectral_centroid (harmonicSpectrum, numSamples, NULL, harmonicSpectralCentroids + frameNum);
-    xtract_spectral_variance (harmonicSpectrum, numSamples, harmonicSpectralCentroids + frameNum, harmonicSpectralVariances + frameNum);
-    xtract_spectral_standard_deviation (harmonicSpectrum, numSamples, harmonicSpectralVariances + frameNum, harmonicSpectralStandardDeviations + frameNum);
-    argumentArray [0] = harmonicSpectralCentroids [frameNum];
-    argumentArray [1] = harmonicSpectralStandardDeviations [frameNum];
-    xtract_spectral_skewness (harmonicSpectrum, numSamples, argumentArray, harmonicSpectralSkewnesses + frameNum);
-    xtract_spectral_kurtosis (harmonicSpectrum, numSamples, argumentArray, harmonicSpectralKurtosises + frameNum);
-    xtract_irregularity_j (harmonicSpectrum, numSamples / 2, NULL, harmonicIrregularityJs + frameNum);
-    xtract_irregularity_k (harmonicSpectrum, numSamples / 2, NULL, harmonicIrregularityKs + frameNum);
-    xtract_tristimulus_1 (harmonicSpectrum, numSamples, fundamentals + frameNum, harmonicTristimulus1s + frameNum);
-    xtract_tristimulus_2 (harmonicSpectrum, numSamples, fundamentals + frameNum, harmonicTristimulus2s + frameNum);
-    xtract_tristimulus_3 (harmonicSpectrum, numSamples, fundamentals + frameNum, harmonicTristimulus3s + frameNum);
-    double numHarmonics, numPartials;
-    xtract_nonzero_count (harmonicSpectrum, numSamples / 2, NULL, &numHarmonics);
-    xtract_nonzero_count (peakSpectrum, numSamples / 2, NULL, &numPartials);
-    argumentArray [0] = numHarmonics;
-    argumentArray [1] = numPartials;
-    xtract_noisiness (NULL, 0, argumentArray, noisinesses + frameNum);
-    xtract_odd_even_ratio (harmonicSpectrum, numSamples, fundamentals + frameNum, parityRatios + frameNum);
-
-    // bark features
-    double* barkCoefficientsFrame = barkCoefficients [frameNum]->getRawDataPointer();
-    xtract_bark_coefficients (spectrum, numSamples / 2, libXtract->barkBandLimits, barkCoefficientsFrame);
-
-    // mfcc features
-    double* mfccsFrame = mfccs [frameNum]->getRawDataPointer();
-    xtract_mfcc (spectrum, numSamples / 2, &libXtract->melFilters, mfccsFrame);
+    double* frameValues = featureValues + frameNum * numFeatureValues;
+    calculatedNodes.clear();
+
+    // other extractors may be using libXtract on other threads
+    const ScopedLock sl (libXtract->lock);
+
+    for (int feature = 0; feature < numFeatures; ++feature)
+    {
+        if (featureSet [feature])
+        {
+            calculateNode (feature, sampleData, numSamples, frameValues);
+        }
+    }
+}
+
+void SAFEFeatureExtractor::analyseFrame (const float* sampleData, int numSamples, int frameNum)
+{
+    jassert (numSamples <= analysisFrameLength);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        frameSamples [i] = sampleData [i];
+    }
+
+    analyseFrame (frameSamples, numSamples, frameNum);
+}
+
+void SAFEFeatureExtractor::calculateNode (int node, double* sampleData, int numSamples, double* frameValues)
+{
+    // each node is only calculated once a frame, however many nodes depend on it
+    if (calculatedNodes [node])
+    {
+        return;
+    }
+
+    for (int i = 0; i < maxDependencies; ++i)
+    {
+        const int dependency = nodes [node].dependencies [i];
+
+        if (dependency != noNode)
+        {
+            calculateNode (dependency, sampleData, numSamples, frameValues);
+        }
+    }
+
+    double* result = frameValues + getValueIndex (node);
+
+    switch (node)
+    {
+        // time domain features
+        case meanFeature:
+            xtract_mean (sampleData, numSamples, NULL, result);
+            break;
+
+        case varianceFeature:
+            xtract_variance (sampleData, numSamples, frameValues + meanFeature, result);
+            break;
+
+        case standardDeviationFeature:
+            xtract_standard_deviation (sampleData, numSamples, frameValues + varianceFeature, result);
+            break;
+
+        case rmsAmplitudeFeature:
+            xtract_rms_amplitude (sampleData, numSamples, NULL, result);
+            break;
+
+        case zeroCrossingRateFeature:
+            xtract_zcr (sampleData, numSamples, NULL, result);
+            break;
+
+        case fundamentalFeature:
+            xtract_wavelet_f0 (sampleData, numSamples, &fs, result);
+            break;
+
+        // spectral features
+        case spectrumNode:
+        {
+            double argumentArray [4] = {fs / numSamples, XTRACT_MAGNITUDE_SPECTRUM, 0, 0};
+            xtract_spectrum (sampleData, numSamples, argumentArray, spectrum);
+            break;
+        }
+
+        case spectralCentroidFeature:
+            xtract_spectral_centroid (spectrum, numSamples, NULL, result);
+            break;
+
+        case spectralVarianceFeature:
+            xtract_spectral_variance (spectrum, numSamples, frameValues + spectralCentroidFeature, result);
+            break;
+
+        case spectralStandardDeviationFeature:
+            xtract_spectral_standard_deviation (spectrum, numSamples, frameValues + spectralVarianceFeature, result);
+            break;
+
+        case spectralSkewnessFeature:
+        case spectralKurtosisFeature:
+        {
+            double argumentArray [2] = {frameValues [spectralCentroidFeature], frameValues [spectralStandardDeviationFeature]};
+
+            if (node == spectralSkewnessFeature)
+            {
+                xtract_spectral_skewness (spectrum, numSamples, argumentArray, result);
+            }
+            else
+            {
+                xtract_spectral_kurtosis (spectrum, numSamples, argumentArray, result);
+            }
+
+            break;
+        }
+
+        case irregularityJFeature:
+            xtract_irregularity_j (spectrum, numSamples / 2, NULL, result);
+            break;
+
+        case irregularityKFeature:
+            xtract_irregularity_k (spectrum, numSamples / 2, NULL, result);
+            break;
+
+        case smoothnessFeature:
+            xtract_smoothness (spectrum, numSamples / 2, NULL, result);
+            break;
+
+        case rolloffFeature:
+        {
+            double argumentArray [2] = {fs / numSamples, 45};
+            xtract_rolloff (spectrum, numSamples / 2, argumentArray, result);
+            break;
+        }
+
+        case flatnessFeature:
+            xtract_flatness (spectrum, numSamples / 2, NULL, result);
+            break;
+
+        case tonalityFeature:
+        {
+            double logFlatness;
+            xtract_flatness_db (NULL, 0, frameValues + flatnessFeature, &logFlatness);
+            xtract_tonality (NULL, 0, &logFlatness, result);
+            break;
+        }
+
+        case crestFeature:
+        {
+            double argumentArray [2];
+            xtract_highest_value (spectrum, numSamples / 2, NULL, argumentArray);
+            xtract_mean (spectrum, numSamples / 2, NULL, argumentArray + 1);
+            xtract_crest (NULL, 0, argumentArray, result);
+            break;
+        }
+
+        case spectralSlopeFeature:
+            xtract_spectral_slope (spectrum, numSamples, NULL, result);
+            break;
+
+        // peak spectrum features
+        case peakSpectrumNode:
+        {
+            double argumentArray [2] = {fs / numSamples, 10};
+            xtract_peak_spectrum (spectrum, numSamples / 2, argumentArray, peakSpectrum);
+            break;
+        }
+
+        case peakSpectralCentroidFeature:
+            xtract_spectral_centroid (peakSpectrum, numSamples, NULL, result);
+            break;
+
+        case peakSpectralVarianceFeature:
+            xtract_spectral_variance (peakSpectrum, numSamples, frameValues + peakSpectralCentroidFeature, result);
+            break;
+
+        case peakSpectralStandardDeviationFeature:
+            xtract_spectral_standard_deviation (peakSpectrum, numSamples, frameValues + peakSpectralVarianceFeature, result);
+            break;
+
+        case peakSpectralSkewnessFeature:
+        case peakSpectralKurtosisFeature:
+        {
+            double argumentArray [2] = {frameValues [peakSpectralCentroidFeature], frameValues [peakSpectralStandardDeviationFeature]};
+
+            if (node == peakSpectralSkewnessFeature)
+            {
+                xtract_spectral_skewness (peakSpectrum, numSamples, argumentArray, result);
+            }
+            else
+            {
+                xtract_spectral_kurtosis (peakSpectrum, numSamples, argumentArray, result);
+            }
+
+            break;
+        }
+
+        case peakIrregularityJFeature:
+            xtract_irregularity_j (peakSpectrum, numSamples / 2, NULL, result);
+            break;
+
+        case peakIrregularityKFeature:
+            xtract_irregularity_k (peakSpectrum, numSamples / 2, NULL, result);
+            break;
+
+        case peakTristimulus1Feature:
+            xtract_tristimulus_1 (peakSpectrum, numSamples, frameValues + fundamentalFeature, result);
+            break;
+
+        case peakTristimulus2Feature:
+            xtract_tristimulus_2 (peakSpectrum, numSamples, frameValues + fundamentalFeature, result);
+            break;
+
+        case peakTristimulus3Feature:
+            xtract_tristimulus_3 (peakSpectrum, numSamples, frameValues + fundamentalFeature, result);
+            break;
+
+        case inharmonicityFeature:
+            xtract_spectral_inharmonicity (peakSpectrum, numSamples, frameValues + fundamentalFeature, result);
+            break;
+
+        // harmonic spectrum features
+        case harmonicSpectrumNode:
+        {
+            double argumentArray [2] = {frameValues [fundamentalFeature], 0.2};
+            xtract_harmonic_spectrum (peakSpectrum, numSamples, argumentArray, harmonicSpectrum);
+            break;
+        }
+
+        case harmonicSpectralCentroidFeature:
+            xtract_spectral_centroid (harmonicSpectrum, numSamples, NULL, result);
+            break;
+
+        case harmonicSpectralVarianceFeature:
+            xtract_spectral_variance (harmonicSpectrum, numSamples, frameValues + harmonicSpectralCentroidFeature, result);
+            break;
+
+        case harmonicSpectralStandardDeviationFeature:
+            xtract_spectral_standard_deviation (harmonicSpectrum, numSamples, frameValues + harmonicSpectralVarianceFeature, result);
+            break;
+
+        case harmonicSpectralSkewnessFeature:
+        case harmonicSpectralKurtosisFeature:
+        {
+            double argumentArray [2] = {frameValues [harmonicSpectralCentroidFeature], frameValues [harmonicSpectralStandardDeviationFeature]};
+
+            if (node == harmonicSpectralSkewnessFeature)
+            {
+                xtract_spectral_skewness (harmonicSpectrum, numSamples, argumentArray, result);
+            }
+            else
+            {
+                xtract_spectral_kurtosis (harmonicSpectrum, numSamples, argumentArray, result);
+            }
+
+            break;
+        }
+
+        case harmonicIrregularityJFeature:
+            xtract_irregularity_j (harmonicSpectrum, numSamples / 2, NULL, result);
+            break;
+
+        case harmonicIrregularityKFeature:
+            xtract_irregularity_k (harmonicSpectrum, numSamples / 2, NULL, result);
+            break;
+
+        case harmonicTristimulus1Feature:
+            xtract_tristimulus_1 (harmonicSpectrum, numSamples, frameValues + fundamentalFeature, result);
+            break;
+
+        case harmonicTristimulus2Feature:
+            xtract_tristimulus_2 (harmonicSpectrum, numSamples, frameValues + fundamentalFeature, result);
+            break;
+
+        case harmonicTristimulus3Feature:
+            xtract_tristimulus_3 (harmonicSpectrum, numSamples, frameValues + fundamentalFeature, result);
+            break;
+
+        case noisinessFeature:
+        {
+            double argumentArray [2];
+            xtract_nonzero_count (harmonicSpectrum, numSamples / 2, NULL, argumentArray);
+            xtract_nonzero_count (peakSpectrum, numSamples / 2, NULL, argumentArray + 1);
+            xtract_noisiness (NULL, 0, argumentArray, result);
+            break;
+        }
+
+        case parityRatioFeature:
+            xtract_odd_even_ratio (harmonicSpectrum, numSamples, frameValues + fundamentalFeature, result);
+            break;
+
+        // bark and mfcc features
+        case barkCoefficientsFeature:
+            xtract_bark_coefficients (spectrum, numSamples / 2, libXtract->barkBandLimits, result);
+            break;
+
+        case mfccsFeature:
+            xtract_mfcc (spectrum, numSamples / 2, &libXtract->melFilters, result);
+            break;
+
+        default:
+            jassertfalse;
+            break;
+    }
+
+    calculatedNodes.setBit (node);
 }
 
+//==========================================================================
+//      Results
+//==========================================================================
 void SAFEFeatureExtractor::addToXml (XmlElement* parentElement)
 {
+    const StringArray featureNames (getFeatureNames (featureSet));
+
     for (int frameNum = 0; frameNum < numAnalysisFrames; ++frameNum)
     {
         String frameName = String ("Frame") + String (frameNum);
@@ -186,68 +472,11 @@ void SAFEFeatureExtractor::addToXml (XmlElement* parentElement)
             frameElement = parentElement->createNewChildElement (frameName);
         }
 
-        // time domain features
-        frameElement->setAttribute ("Mean", means [frameNum]);
-        frameElement->setAttribute ("Variance", variances [frameNum]);
-        frameElement->setAttribute ("Standard_Deviation", standardDeviations [frameNum]);
-        frameElement->setAttribute ("RMS_Amplitude", rmsAmplitudes [frameNum]);
-        frameElement->setAttribute ("Zero_Crossing_Rate", zeroCrossingRates [frameNum]);
+        const Array <double> features (getFeatureArray (frameNum));
 
-        // spectral features
-        frameElement->setAttribute ("Spectral_Centroid", spectralCentroids [frameNum]);
-        frameElement->setAttribute ("Spectral_Variance", spectralVariances [frameNum]);
-        frameElement->setAttribute ("Spectral_Standard_Deviation", spectralStandardDeviations [frameNum]);
-        frameElement->setAttribute ("Spectral_Skewness", spectralSkewnesses [frameNum]);
-        frameElement->setAttribute ("Spectral_Kurtosis", spectralKurtosises [frameNum]);
-        frameElement->setAttribute ("Irregularity_J", irregularityJs [frameNum]);
-        frameElement->setAttribute ("Irregularity_K", irregularityKs [frameNum]);
-        frameElement->setAttribute ("Fundamental", fundamentals [frameNum]);
-        frameElement->setAttribute ("Smoothness", smoothnesses [frameNum]);
-        frameElement->setAttribute ("Spectral_Roll_Off", rolloffs [frameNum]);
-        frameElement->setAttribute ("Spectral_Flatness", flatnesses [frameNum]);
-        frameElement->setAttribute ("Tonality", tonalities [frameNum]);
-        frameElement->setAttribute ("Spectral_Crest", crests [frameNum]);
-        frameElement->setAttribute ("Spectral_Slope", spectralSlopes [frameNum]);
-
-        // peak spectral features
-        frameElement->setAttribute ("Peak_Spectral_Centroid", peakSpectralCentroids [frameNum]);
-        frameElement->setAttribute ("Peak_Spectral_Variance", peakSpectralVariances [frameNum]);
-        frameElement->setAttribute ("Peak_Spectral_Standard_Deviation", peakSpectralStandardDeviations [frameNum]);
-        frameElement->setAttribute ("Peak_Spectral_Skewness", peakSpectralSkewnesses [frameNum]);
-        frameElement->setAttribute ("Peak_Spectral_Kurtosis", peakSpectralKurtosises [frameNum]);
-        frameElement->setAttribute ("Peak_Irregularity_J", peakIrregularityJs [frameNum]);
-        frameElement->setAttribute ("Peak_Irregularity_K", peakIrregularityKs [frameNum]);
-        frameElement->setAttribute ("Peak_Tristimulus_1", peakTristimulus1s [frameNum]);
-        frameElement->setAttribute ("Peak_Tristimulus_2", peakTristimulus2s [frameNum]);
-        frameElement->setAttribute ("Peak_Tristimulus_3", peakTristimulus3s [frameNum]);
-        frameElement->setAttribute ("Inharmonicity", inharmonicities [frameNum]);
-
-        // harmonic spectral features
-        frameElement->setAttribute ("Harmonic_Spectral_Centroid", harmonicSpectralCentroids [frameNum]);
-        frameElement->setAttribute ("Harmonic_Spectral_Variance", harmonicSpectralVariances [frameNum]);
-        frameElement->setAttribute ("Harmonic_Spectral_Standard_Deviation", harmonicSpectralStandardDeviations [frameNum]);
-        frameElement->setAttribute ("Harmonic_Spectral_Skewness", harmonicSpectralSkewnesses [frameNum]);
-        frameElement->setAttribute ("Harmonic_Spectral_Kurtosis", harmonicSpectralKurtosises [frameNum]);
-        frameElement->setAttribute ("Harmonic_Irregularity_J", harmonicIrregularityJs [frameNum]);
-        frameElement->setAttribute ("Harmonic_Irregularity_K", harmonicIrregularityKs [frameNum]);
-        frameElement->setAttribute ("Harmonic_Tristimulus_1", harmonicTristimulus1s [frameNum]);
-        frameElement->setAttribute ("Harmonic_Tristimulus_2", harmonicTristimulus2s [frameNum]);
-        frameElement->setAttribute ("Harmonic_Tristimulus_3", harmonicTristimulus3s [frameNum]);
-        frameElement->setAttribute ("Noisiness", noisinesses [frameNum]);
-        frameElement->setAttribute ("Parity_Ratio", parityRatios [frameNum]);
-
-        // bark features
-        for (int n = 0; n < 25; ++n)
+        for (int feature = 0; feature < features.size(); ++feature)
         {
-            String attributeName = String ("Bark_Coefficient_") + String (n);
-            frameElement->setAttribute (attributeName, barkCoefficients [frameNum]->getUnchecked (n));
-        }
-
-        // mfccs
-        for (int n = 0; n < 13; ++n)
-        {
-            String attributeName = String ("MFCC_") + String (n);
-            frameElement->setAttribute (attributeName, mfccs [frameNum]->getUnchecked (n));
+            frameElement->setAttribute (featureNames [feature], features [feature]);
         }
     }
 }
@@ -255,119 +484,59 @@ void SAFEFeatureExtractor::addToXml (XmlElement* parentElement)
 Array <double> SAFEFeatureExtractor::getFeatureArray (int frameNum) const
 {
     Array <double> array;
+    const double* frameValues = featureValues + frameNum * numFeatureValues;
 
-    array.add (means [frameNum]);
-    array.add (variances [frameNum]);
-    array.add (standardDeviations [frameNum]);
-    array.add (rmsAmplitudes [frameNum]);
-    array.add (zeroCrossingRates [frameNum]);
-    array.add (spectralCentroids [frameNum]);
-    array.add (spectralVariances [frameNum]);
-    array.add (spectralStandardDeviations [frameNum]);
-    array.add (spectralSkewnesses [frameNum]);
-    array.add (spectralKurtosises [frameNum]);
-    array.add (irregularityJs [frameNum]);
-    array.add (irregularityKs [frameNum]);
-    array.add (fundamentals [frameNum]);
-    array.add (smoothnesses [frameNum]);
-    array.add (rolloffs [frameNum]);
-    array.add (flatnesses [frameNum]);
-    array.add (tonalities [frameNum]);
-    array.add (crests [frameNum]);
-    array.add (spectralSlopes [frameNum]);
-    array.add (peakSpectralCentroids [frameNum]);
-    array.add (peakSpectralVariances [frameNum]);
-    array.add (peakSpectralStandardDeviations [frameNum]);
-    array.add (peakSpectralSkewnesses [frameNum]);
-    array.add (peakSpectralKurtosises [frameNum]);
-    array.add (peakIrregularityJs [frameNum]);
-    array.add (peakIrregularityKs [frameNum]);
-    array.add (peakTristimulus1s [frameNum]);
-    array.add (peakTristimulus2s [frameNum]);
-    array.add (peakTristimulus3s [frameNum]);
-    array.add (inharmonicities [frameNum]);
-    array.add (harmonicSpectralCentroids [frameNum]);
-    array.add (harmonicSpectralVariances [frameNum]);
-    array.add (harmonicSpectralStandardDeviations [frameNum]);
-    array.add (harmonicSpectralSkewnesses [frameNum]);
-    array.add (harmonicSpectralKurtosises [frameNum]);
-    array.add (harmonicIrregularityJs [frameNum]);
-    array.add (harmonicIrregularityKs [frameNum]);
-    array.add (harmonicTristimulus1s [frameNum]);
-    array.add (harmonicTristimulus2s [frameNum]);
-    array.add (harmonicTristimulus3s [frameNum]);
-    array.add (noisinesses [frameNum]);
-    array.add (parityRatios [frameNum]);
-
-    for (int n = 0; n < 25; ++n)
+    for (int feature = 0; feature < numFeatures; ++feature)
     {
-        array.add (barkCoefficients [frameNum]->getUnchecked (n));
+        if (featureSet [feature])
+        {
+            array.addArray (frameValues + getValueIndex (feature), nodes [feature].numValues);
+        }
     }
 
-    for (int n = 0; n < 13; ++n)
+    return array;
+}
+
+StringArray SAFEFeatureExtractor::getFeatureNames (const BigInteger& featureSetToName)
+{
+    StringArray names;
+
+    for (int feature = 0; feature < numFeatures; ++feature)
     {
-        array.add (mfccs [frameNum]->getUnchecked (n));
+        if (featureSetToName [feature])
+        {
+            const Node& node = nodes [feature];
+
+            if (node.numValues == 1)
+            {
+                names.add (node.name);
+            }
+            else
+            {
+                for (int n = 0; n < node.numValues; ++n)
+                {
+                    names.add (String (node.name) + "_" + String (n));
+                }
+            }
+        }
     }
 
-    return array;
+    return names;
+}
+
+int SAFEFeatureExtractor::getNumAnalysisFrames() const
+{
+    return numAnalysisFrames;
 }
 
 MemoryBlock SAFEFeatureExtractor::getMD5Checksum() const
 {
     MemoryBlock featureBlock;
-    int blockSize = numAnalysisFrames * sizeof (double);
-
-    featureBlock.append (means, blockSize);
-    featureBlock.append (variances, blockSize);
-    featureBlock.append (standardDeviations, blockSize);
-    featureBlock.append (rmsAmplitudes, blockSize);
-    featureBlock.append (zeroCrossingRates, blockSize);
-    featureBlock.append (spectralCentroids, blockSize);
-    featureBlock.append (spectralVariances, blockSize);
-    featureBlock.append (spectralStandardDeviations, blockSize);
-    featureBlock.append (spectralSkewnesses, blockSize);
-    featureBlock.append (spectralKurtosises, blockSize);
-    featureBlock.append (irregularityJs, blockSize);
-    featureBlock.append (irregularityKs, blockSize);
-    featureBlock.append (fundamentals, blockSize);
-    featureBlock.append (smoothnesses, blockSize);
-    featureBlock.append (rolloffs, blockSize);
-    featureBlock.append (flatnesses, blockSize);
-    featureBlock.append (tonalities, blockSize);
-    featureBlock.append (crests, blockSize);
-    featureBlock.append (spectralSlopes, blockSize);
-    featureBlock.append (peakSpectralCentroids, blockSize);
-    featureBlock.append (peakSpectralVariances, blockSize);
-    featureBlock.append (peakSpectralStandardDeviations, blockSize);
-    featureBlock.append (peakSpectralSkewnesses, blockSize);
-    featureBlock.append (peakSpectralKurtosises, blockSize);
-    featureBlock.append (peakIrregularityJs, blockSize);
-    featureBlock.append (peakIrregularityKs, blockSize);
-    featureBlock.append (peakTristimulus1s, blockSize);
-    featureBlock.append (peakTristimulus2s, blockSize);
-    featureBlock.append (peakTristimulus3s, blockSize);
-    featureBlock.append (inharmonicities, blockSize);
-    featureBlock.append (harmonicSpectralCentroids, blockSize);
-    featureBlock.append (harmonicSpectralVariances, blockSize);
-    featureBlock.append (harmonicSpectralStandardDeviations, blockSize);
-    featureBlock.append (harmonicSpectralSkewnesses, blockSize);
-    featureBlock.append (harmonicSpectralKurtosises, blockSize);
-    featureBlock.append (harmonicIrregularityJs, blockSize);
-    featureBlock.append (harmonicIrregularityKs, blockSize);
-    featureBlock.append (harmonicTristimulus1s, blockSize);
-    featureBlock.append (harmonicTristimulus2s, blockSize);
-    featureBlock.append (harmonicTristimulus3s, blockSize);
-    featureBlock.append (noisinesses, blockSize);
-    featureBlock.append (parityRatios, blockSize);
-
-    for (int n = 0; n < 25; ++n)
-    {
-        featureBlock.append (barkCoefficients [n]->getRawDataPointer(), blockSize);
-    }
-    
-    for (int n = 0; n < 13; ++n)
+
+    for (int frameNum = 0; frameNum < numAnalysisFrames; ++frameNum)
     {
-        featureBlock.append (mfccs [n]->getRawDataPointer(), blockSize);
+        const Array <double> features (getFeatureArray (frameNum));
+        featureBlock.append (features.getRawDataPointer(), features.size() * sizeof (double));
     }
 
     MD5 md5Checksum (featureBlock);
@@ -377,67 +546,43 @@ MemoryBlock SAFEFeatureExtractor::getMD5Checksum() const
 
 bool SAFEFeatureExtractor::operator == (const SAFEFeatureExtractor& testObject)
 {
+    if (featureSet != testObject.featureSet || numAnalysisFrames != testObject.numAnalysisFrames)
+    {
+        return false;
+    }
+
     bool returnValue = true;
 
     for (int frameNum = 0; frameNum < numAnalysisFrames; ++ frameNum)
     {
-        returnValue = returnValue && checkEqualityOrNan (means [frameNum], testObject.means [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (variances [frameNum], testObject.variances [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (standardDeviations [frameNum], testObject.standardDeviations [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (rmsAmplitudes [frameNum], testObject.rmsAmplitudes [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (zeroCrossingRates [frameNum], testObject.zeroCrossingRates [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (spectralCentroids [frameNum], testObject.spectralCentroids [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (spectralVariances [frameNum], testObject.spectralVariances [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (spectralStandardDeviations [frameNum], testObject.spectralStandardDeviations [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (spectralSkewnesses [frameNum], testObject.spectralSkewnesses [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (spectralKurtosises [frameNum], testObject.spectralKurtosises [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (irregularityJs [frameNum], testObject.irregularityJs [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (irregularityKs [frameNum], testObject.irregularityKs [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (fundamentals [frameNum], testObject.fundamentals [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (smoothnesses [frameNum], testObject.smoothnesses [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (rolloffs [frameNum], testObject.rolloffs [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (flatnesses [frameNum], testObject.flatnesses [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (tonalities [frameNum], testObject.tonalities [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (crests [frameNum], testObject.crests [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (spectralSlopes [frameNum], testObject.spectralSlopes [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (peakSpectralCentroids [frameNum], testObject.peakSpectralCentroids [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (peakSpectralVariances [frameNum], testObject.peakSpectralVariances [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (peakSpectralStandardDeviations [frameNum], testObject.peakSpectralStandardDeviations [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (peakSpectralSkewnesses [frameNum], testObject.peakSpectralSkewnesses [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (peakSpectralKurtosises [frameNum], testObject.peakSpectralKurtosises [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (peakIrregularityJs [frameNum], testObject.peakIrregularityJs [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (peakIrregularityKs [frameNum], testObject.peakIrregularityKs [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (peakTristimulus1s [frameNum], testObject.peakTristimulus1s [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (peakTristimulus2s [frameNum], testObject.peakTristimulus2s [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (peakTristimulus3s [frameNum], testObject.peakTristimulus3s [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (inharmonicities [frameNum], testObject.inharmonicities [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (harmonicSpectralCentroids [frameNum], testObject.harmonicSpectralCentroids [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (harmonicSpectralVariances [frameNum], testObject.harmonicSpectralVariances [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (harmonicSpectralStandardDeviations [frameNum], testObject.harmonicSpectralStandardDeviations [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (harmonicSpectralSkewnesses [frameNum], testObject.harmonicSpectralSkewnesses [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (harmonicSpectralKurtosises [frameNum], testObject.harmonicSpectralKurtosises [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (harmonicIrregularityJs [frameNum], testObject.harmonicIrregularityJs [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (harmonicIrregularityKs [frameNum], testObject.harmonicIrregularityKs [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (harmonicTristimulus1s [frameNum], testObject.harmonicTristimulus1s [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (harmonicTristimulus2s [frameNum], testObject.harmonicTristimulus2s [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (harmonicTristimulus3s [frameNum], testObject.harmonicTristimulus3s [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (noisinesses [frameNum], testObject.noisinesses [frameNum]);
-        returnValue = returnValue && checkEqualityOrNan (parityRatios [frameNum], testObject.parityRatios [frameNum]);
-
-        for (int n = 0; n < 25; ++n)
-        {
-            returnValue = returnValue && checkEqualityOrNan (barkCoefficients [frameNum]->getUnchecked (n), testObject.barkCoefficients [frameNum]->getUnchecked (n));
-        }
+        const Array <double> features (getFeatureArray (frameNum));
+        const Array <double> testFeatures (testObject.getFeatureArray (frameNum));
 
-        for (int n = 0; n < 13; ++n)
+        for (int n = 0; n < features.size(); ++n)
         {
-            returnValue = returnValue && checkEqualityOrNan (mfccs [frameNum]->getUnchecked (n), testObject.mfccs [frameNum]->getUnchecked (n));
+            returnValue = returnValue && checkEqualityOrNan (features [n], testFeatures [n]);
         }
     }
 
     return returnValue;
 }
 
+//==========================================================================
+//      Internal Bits
+//==========================================================================
+int SAFEFeatureExtractor::getValueIndex (int node)
+{
+    // the features' values are stored one after the other for each frame
+    int index = 0;
+
+    for (int feature = 0; feature < node && feature < numFeatures; ++feature)
+    {
+        index += nodes [feature].numValues;
+    }
+
+    return index;
+}
+
 bool SAFEFeatureExtractor::checkEqualityOrNan (double a, double b)
 {
     if ((a != a) && (b != b))
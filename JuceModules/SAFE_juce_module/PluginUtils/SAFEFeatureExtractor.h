@@ -3,6 +3,10 @@
 
 /**
  *  A class for extracting features from audio using libXtract.
+ *
+ *  libXtract is shared by every extractor in the process, so initialise() and
+ *  analyseFrame() hold LibXtractHolder::lock. Extractors can be used on different
+ *  threads, each frame just waits for any other frame being analysed.
  */
 class SAFEFeatureExtractor
 {
@@ -19,12 +23,107 @@ public:
     /** Initialise the feature extractor.
      *  
      *  @param numAnalysisFramesInit     The number of analysis frames.
-     *  @param analysisFrameLengthInit  The number of samples in each analysis frame.
+     *  @param analysisFrameLengthInit  The number of samples in each analysis frame - this 
+     *                                  must be a power of two.
      *  @param sampleRate                The sample rate of the audio to analyse.
      */
     void initialise (int numAnalysisFramesInit, int analysisFrameLengthInit, double sampleRate);
 
+    //==========================================================================
+    //      Choosing Features
+    //==========================================================================
+    /** The audio features which can be extracted.
+     *
+     *  Each of these is one value per frame, apart from the bark coefficients
+     *  and MFCCs which are 25 and 13 values per frame.
+     */
+    enum Feature
+    {
+        meanFeature,
+        varianceFeature,
+        standardDeviationFeature,
+        rmsAmplitudeFeature,
+        zeroCrossingRateFeature,
+        spectralCentroidFeature,
+        spectralVarianceFeature,
+        spectralStandardDeviationFeature,
+        spectralSkewnessFeature,
+        spectralKurtosisFeature,
+        irregularityJFeature,
+        irregularityKFeature,
+        fundamentalFeature,
+        smoothnessFeature,
+        rolloffFeature,
+        flatnessFeature,
+        tonalityFeature,
+        crestFeature,
+        spectralSlopeFeature,
+        peakSpectralCentroidFeature,
+        peakSpectralVarianceFeature,
+        peakSpectralStandardDeviationFeature,
+        peakSpectralSkewnessFeature,
+        peakSpectralKurtosisFeature,
+        peakIrregularityJFeature,
+        peakIrregularityKFeature,
+        peakTristimulus1Feature,
+        peakTristimulus2Feature,
+        peakTristimulus3Feature,
+        inharmonicityFeature,
+        harmonicSpectralCentroidFeature,
+        harmonicSpectralVarianceFeature,
+        harmonicSpectralStandardDeviationFeature,
+        harmonicSpectralSkewnessFeature,
+        harmonicSpectralKurtosisFeature,
+        harmonicIrregularityJFeature,
+        harmonicIrregularityKFeature,
+        harmonicTristimulus1Feature,
+        harmonicTristimulus2Feature,
+        harmonicTristimulus3Feature,
+        noisinessFeature,
+        parityRatioFeature,
+        barkCoefficientsFeature,
+        mfccsFeature,
+        numFeatures
+    };
+
+    /** Choose which features analyseFrame() works out.
+     *
+     *  Only the requested features, and the spectra and other features they are
+     *  worked out from, are calculated, and only the requested features are reported
+     *  by getFeatureArray() and addToXml(). By default every feature is extracted.
+     *
+     *  This should be called before the first frame is analysed.
+     *
+     *  @param newFeatureSet  a set bit for each Feature to extract
+     */
+    void setFeatureSet (const BigInteger& newFeatureSet);
+
+    /** Returns the set of features being extracted. */
+    const BigInteger& getFeatureSet() const;
+
+    /** Returns a feature set with every feature in it. */
+    static BigInteger getFullFeatureSet();
+
+    /** Make a feature set from some feature names.
+     *
+     *  The names are those returned by getFeatureNames(). Any one of the bark
+     *  coefficients or MFCCs, or the names Bark_Coefficient and MFCC, selects the
+     *  whole group.
+     *
+     *  @param names       the names of the features to extract
+     *  @param featureSet  the feature set to fill in
+     *
+     *  @return false if any of the names isn't a feature
+     */
+    static bool getFeatureSetFromNames (const StringArray& names, BigInteger& featureSet);
+
+    //==========================================================================
+    //      Analysis
+    //==========================================================================
     /** Analyse a frame of audio.
+     *
+     *  Each feature in the feature set, and each feature or spectrum it depends on,
+     *  is worked out once for the frame.
      *
      *  @param sampleData  a pointer to an array containing the audio samples to analyse
      *  @param numSamples  the number of samples to analyse - this should be the same as
@@ -33,8 +132,23 @@ public:
      *                     be between 0 and the value for numAnalysisFrameInit passed
      *                     to initialise() - 1
      */
-    void getAllFeatures (double* sampleData, int numSamples, int frameNum);
+    void analyseFrame (double* sampleData, int numSamples, int frameNum);
+
+    /** Analyse a frame of single precision audio.
+     *
+     *  The samples are widened to double precision, which is exact, so the features
+     *  are exactly the same as if the audio had been stored as doubles. Keeping
+     *  recordings as floats halves the memory they take.
+     *
+     *  @param sampleData  a pointer to an array containing the audio samples to analyse
+     *  @param numSamples  the number of samples to analyse
+     *  @param frameNum    the frame number of the current frame
+     */
+    void analyseFrame (const float* sampleData, int numSamples, int frameNum);
 
+    //==========================================================================
+    //      Results
+    //==========================================================================
     /** Add all the audio features from a set of frames to an XMLElement
      *
      *  @param parentElement  a pointer to the XMLElement to add the audio features to
@@ -47,7 +161,7 @@ public:
      *                   be between 0 and the value for numAnalysisFrameInit passed
      *                   to initialise() - 1
      *
-     *  The features are as follows:
+     *  The features in the feature set are returned in the following order:
      *  - Temporal Mean
      *  - Temporal Variance
      *  - Temporal Standard Deviation
@@ -131,6 +245,18 @@ public:
      */
     Array <double> getFeatureArray (int frameNum) const;
 
+    /** Returns the names of the audio features in a feature set.
+     *
+     *  These are in the same order as the values returned by getFeatureArray()
+     *  and are the attribute names used by addToXml().
+     *
+     *  @param featureSet  the features to get the names of
+     */
+    static StringArray getFeatureNames (const BigInteger& featureSet = getFullFeatureSet());
+
+    /** Returns the number of frames the feature extractor was initialised with. */
+    int getNumAnalysisFrames() const;
+
     /** Get an MD5 checksum of the audio features. */
     MemoryBlock getMD5Checksum() const;
 
@@ -139,58 +265,36 @@ public:
     bool operator == (const SAFEFeatureExtractor& testObject);
 
 private:
-    HeapBlock <double> means;
-    HeapBlock <double> variances;
-    HeapBlock <double> standardDeviations;
-    HeapBlock <double> rmsAmplitudes;
-    HeapBlock <double> zeroCrossingRates;
-
-    HeapBlock <double> spectrum;
-    HeapBlock <double> spectralCentroids;
-    HeapBlock <double> spectralVariances;
-    HeapBlock <double> spectralStandardDeviations;
-    HeapBlock <double> spectralSkewnesses;
-    HeapBlock <double> spectralKurtosises;
-    HeapBlock <double> irregularityJs;
-    HeapBlock <double> irregularityKs;
-    HeapBlock <double> fundamentals;
-    HeapBlock <double> smoothnesses;
-    HeapBlock <double> rolloffs;
-    HeapBlock <double> flatnesses;
-    HeapBlock <double> tonalities;
-    HeapBlock <double> crests;
-    HeapBlock <double> spectralSlopes;
-
-    HeapBlock <double> peakSpectrum;
-    HeapBlock <double> peakSpectralCentroids;
-    HeapBlock <double> peakSpectralVariances;
-    HeapBlock <double> peakSpectralStandardDeviations;
-    HeapBlock <double> peakSpectralSkewnesses;
-    HeapBlock <double> peakSpectralKurtosises;
-    HeapBlock <double> peakIrregularityJs;
-    HeapBlock <double> peakIrregularityKs;
-    HeapBlock <double> peakTristimulus1s;
-    HeapBlock <double> peakTristimulus2s;
-    HeapBlock <double> peakTristimulus3s;
-    HeapBlock <double> inharmonicities;
-
-    HeapBlock <double> harmonicSpectrum;
-    HeapBlock <double> harmonicSpectralCentroids;
-    HeapBlock <double> harmonicSpectralVariances;
-    HeapBlock <double> harmonicSpectralStandardDeviations;
-    HeapBlock <double> harmonicSpectralSkewnesses;
-    HeapBlock <double> harmonicSpectralKurtosises;
-    HeapBlock <double> harmonicIrregularityJs;
-    HeapBlock <double> harmonicIrregularityKs;
-    HeapBlock <double> harmonicTristimulus1s;
-    HeapBlock <double> harmonicTristimulus2s;
-    HeapBlock <double> harmonicTristimulus3s;
-    HeapBlock <double> noisinesses;
-    HeapBlock <double> parityRatios;
-
-    OwnedArray <Array <double> > barkCoefficients;
-
-    OwnedArray <Array <double> > mfccs;
+    /** The spectra the features are worked out from, which follow the
+     *  features in the graph. */
+    enum IntermediateNode
+    {
+        spectrumNode = numFeatures,
+        peakSpectrumNode,
+        harmonicSpectrumNode,
+        numNodes
+    };
+
+    static const int noNode = -1;
+    static const int maxDependencies = 2;
+    static const int numBarkCoefficients = 25;
+    static const int numMfccs = 13;
+    static const int numFeatureValues = barkCoefficientsFeature + numBarkCoefficients + numMfccs;
+
+    /** A node in the feature graph. */
+    struct Node
+    {
+        const char* name;
+        int numValues;
+        int dependencies [maxDependencies];
+    };
+
+    static const Node nodes [numNodes];
+
+    BigInteger featureSet, calculatedNodes;
+
+    HeapBlock <double> featureValues;
+    HeapBlock <double> frameSamples, spectrum, peakSpectrum, harmonicSpectrum;
 
     int numAnalysisFrames;
     int analysisFrameLength;
@@ -200,6 +304,9 @@ private:
 
     SharedResourcePointer <LibXtractHolder> libXtract;
 
+    void calculateNode (int node, double* sampleData, int numSamples, double* frameValues);
+    static int getValueIndex (int node);
+
     bool checkEqualityOrNan (double a, double b);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SAFEFeatureExtractor);
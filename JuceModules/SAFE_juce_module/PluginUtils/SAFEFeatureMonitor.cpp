@@ -0,0 +1,135 @@
+//==========================================================================
+//      Constructor and Destructor
+//==========================================================================
+SAFEFeatureMonitor::SAFEFeatureMonitor()
+    : BackgroundAnalyser ("FeatureMonitor", 1),
+      margin (0),
+      numPublishedValues (0)
+{
+    setUpdateInterval (200);
+
+    BigInteger defaultFeatureSet;
+    defaultFeatureSet.setBit (SAFEFeatureExtractor::rmsAmplitudeFeature);
+    defaultFeatureSet.setBit (SAFEFeatureExtractor::spectralCentroidFeature);
+    defaultFeatureSet.setBit (SAFEFeatureExtractor::rolloffFeature);
+
+    setFeatureSet (defaultFeatureSet);
+}
+
+SAFEFeatureMonitor::~SAFEFeatureMonitor()
+{
+    stopAnalysing();
+}
+
+//==========================================================================
+//      Setup
+//==========================================================================
+void SAFEFeatureMonitor::prepare (double sampleRate, int samplesPerBlock, int decimationFactor)
+{
+    stopAnalysing();
+
+    decimator.setDecimationFactor (decimationFactor);
+
+    // the frame sits far enough back from the newest sample for the decimator to see
+    // past both ends of it
+    margin = (decimator.getDelay() + decimationFactor - 1) / decimationFactor * decimationFactor;
+    decimatedFrame.allocate (frameLength, true);
+
+    // room for a second of audio, a lot more than gets added between updates
+    prepareFifos ((int) sampleRate + samplesPerBlock, frameLength * decimationFactor + 2 * margin);
+
+    extractor.initialise (1, frameLength, sampleRate / decimationFactor);
+
+    resumeAnalysing();
+}
+
+void SAFEFeatureMonitor::setFeatureSet (const BigInteger& newFeatureSet)
+{
+    stopAnalysing();
+
+    featureSet = newFeatureSet;
+    extractor.setFeatureSet (featureSet);
+
+    numPublishedValues = SAFEFeatureExtractor::getFeatureNames (featureSet).size();
+    publishedValues.allocate (jmax (1, numPublishedValues), true);
+    clearPublished();
+
+    resumeAnalysing();
+}
+
+StringArray SAFEFeatureMonitor::getFeatureNames() const
+{
+    return SAFEFeatureExtractor::getFeatureNames (featureSet);
+}
+
+void SAFEFeatureMonitor::setUpdateRate (double newUpdateRate)
+{
+    // at least twice a second so the fifo never fills up
+    setUpdateInterval (jlimit (10, 500, roundToInt (1000.0 / newUpdateRate)));
+}
+
+//==========================================================================
+//      Feeding the Monitor
+//==========================================================================
+void SAFEFeatureMonitor::addSamples (const AudioSampleBuffer& buffer)
+{
+    BackgroundAnalyser::addSamples (0, buffer, 1);
+}
+
+//==========================================================================
+//      Reading the Features
+//==========================================================================
+bool SAFEFeatureMonitor::getLatestValues (Array <double>& valuesToFill) const
+{
+    // try again if the values changed while they were being copied
+    for (;;)
+    {
+        const int sequenceBefore = beginReading();
+
+        if (sequenceBefore == 0)
+        {
+            return false;
+        }
+
+        valuesToFill.clearQuick();
+
+        for (int i = 0; i < numPublishedValues; ++i)
+        {
+            valuesToFill.add (publishedValues [i]);
+        }
+
+        if (finishReading (sequenceBefore))
+        {
+            return true;
+        }
+    }
+}
+
+//==========================================================================
+//      Analysing the History
+//==========================================================================
+void SAFEFeatureMonitor::analyseHistory()
+{
+    const int decimationFactor = decimator.getDecimationFactor();
+
+    if (decimationFactor == 1)
+    {
+        extractor.analyseFrame (getHistory (0), frameLength, 0);
+    }
+    else
+    {
+        decimator.decimate (getHistory (0), getHistoryLength(), margin / decimationFactor, decimatedFrame, frameLength);
+        extractor.analyseFrame (decimatedFrame, frameLength, 0);
+    }
+
+    const Array <double> values (extractor.getFeatureArray (0));
+
+    beginPublishing();
+
+    for (int i = 0; i < jmin (values.size(), numPublishedValues); ++i)
+    {
+        publishedValues [i] = values [i];
+    }
+
+    finishPublishing();
+}
@@ -0,0 +1,108 @@
+#ifndef __SAFEFEATUREMONITOR__
+#define __SAFEFEATUREMONITOR__
+
+/**
+ *  Works out a few audio features of the processed signal all the time, for the
+ *  editor to show.
+ *
+ *  The first processed channel is analysed a few times a second: the latest frame
+ *  is decimated the same way the saved recordings are and a small set of features
+ *  is worked out from it. The editor reads the values without taking a lock, see
+ *  BackgroundAnalyser.
+ *
+ *  Only one editor should use a monitor at a time, it is switched on and off by
+ *  setActive().
+ */
+class SAFEFeatureMonitor : public BackgroundAnalyser
+{
+public:
+    //==========================================================================
+    //      Constructor and Destructor
+    //==========================================================================
+    /** Create a new monitor which works out the RMS amplitude, spectral centroid
+     *  and spectral roll off. */
+    SAFEFeatureMonitor();
+
+    /** Destructor */
+    ~SAFEFeatureMonitor();
+
+    //==========================================================================
+    //      Setup
+    //==========================================================================
+    /** Get ready to monitor audio at a new sample rate.
+     *
+     *  This is called from SAFEAudioProcessor::prepareToPlay().
+     *
+     *  @param sampleRate        the sample rate of the audio
+     *  @param samplesPerBlock   the largest block the audio thread will add
+     *  @param decimationFactor  the factor to reduce the sample rate by before analysing
+     */
+    void prepare (double sampleRate, int samplesPerBlock, int decimationFactor);
+
+    /** Choose the features to work out.
+     *
+     *  libXtract's fundamental tracker keeps its state from one frame to the next,
+     *  and it is shared with the analysis of saved recordings. Choosing the
+     *  fundamental, or any feature worked out from it, makes the fundamental of a
+     *  save depend on when the monitor happened to run.
+     *
+     *  @param newFeatureSet  one bit for each SAFEFeatureExtractor::Feature
+     */
+    void setFeatureSet (const BigInteger& newFeatureSet);
+
+    /** Returns the names of the values the monitor publishes, in order. */
+    StringArray getFeatureNames() const;
+
+    /** Set how many times a second the features are worked out.
+     *
+     *  @param newUpdateRate  the number of updates per second
+     */
+    void setUpdateRate (double newUpdateRate);
+
+    //==========================================================================
+    //      Feeding the Monitor
+    //==========================================================================
+    /** Add the first channel of a processed block, from the audio thread.
+     *
+     *  @param buffer  the processed block
+     */
+    void addSamples (const AudioSampleBuffer& buffer);
+
+    //==========================================================================
+    //      Reading the Features
+    //==========================================================================
+    /** Copy the latest features.
+     *
+     *  Returns false if nothing has been published yet.
+     *
+     *  @param valuesToFill  an array to put the values in, in the same order as
+     *                       getFeatureNames()
+     */
+    bool getLatestValues (Array <double>& valuesToFill) const;
+
+private:
+    //==========================================================================
+    //      Analysing the History
+    //==========================================================================
+    /** Analyse the latest frame in the history and publish the results. */
+    void analyseHistory() override;
+
+    // the same frame length as the saved features, so the values can be compared
+    static const int frameLength = 4096;
+
+    // the history has this many extra samples at each end for the decimator
+    int margin;
+
+    Decimator decimator;
+    HeapBlock <double> decimatedFrame;
+
+    SAFEFeatureExtractor extractor;
+    BigInteger featureSet;
+
+    HeapBlock <double> publishedValues;
+    int numPublishedValues;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SAFEFeatureMonitor);
+};
+
+#endif // __SAFEFEATUREMONITOR__
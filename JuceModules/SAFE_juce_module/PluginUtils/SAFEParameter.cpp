@@ -18,6 +18,14 @@ SAFEParameter::SAFEParameter (String nameInit, float& valueRef, float initialVal
     controlRate = 64;
     interpolationTime = interpolationTimeInit;
     updateBlockSizes();
+    interpolationStep = 0;
+    currentControlBlock = 0;
+
+    smoothingMode = controlRateSmoothing;
+    maximumRampLength = 0;
+    rampResolution = 32;
+    rampSamplesRemaining = 0;
+    rampStep = 0;
 
     UIScaleFactor = UIScaleFactorInit;
 
@@ -33,50 +41,42 @@ SAFEParameter::~SAFEParameter()
 //==========================================================================
 void SAFEParameter::setBaseValue (float newBaseValue)
 {
-    baseValue = newBaseValue;
-    
     float range = maxValue - minValue;
-    scaledValue = range * pow (baseValue, (1 / skewFactor)) + minValue;
+    float newScaledValue = range * pow (newBaseValue, (1 / skewFactor)) + minValue;
     
-    gainValue = Decibels::decibelsToGain (scaledValue);
-
-    startInterpolating();
+    publishValues (newBaseValue, newScaledValue);
 }
 
 void SAFEParameter::setScaledValue (float newScaledValue)
 {
-    scaledValue = newScaledValue;
-    
-    gainValue = Decibels::decibelsToGain (scaledValue);
-    
     float range = maxValue - minValue;
-    float proportion = scaledValue - minValue;
-    baseValue = pow ((proportion / range), skewFactor);  
+    float proportion = newScaledValue - minValue;
+    float newBaseValue = pow ((proportion / range), skewFactor);  
 
-    startInterpolating();
+    publishValues (newBaseValue, newScaledValue);
 }
 
 float SAFEParameter::getBaseValue() const
 {
-    return baseValue;
+    return getTargetBaseValue();
 }
 
 float SAFEParameter::getScaledValue() const
 {
-    return scaledValue;
+    return getTargetScaledValue();
 }
 
 float SAFEParameter::getUIScaledValue() const
 {
-    return scaledValue * UIScaleFactor;
+    return getTargetScaledValue() * UIScaleFactor;
 }
 
 float SAFEParameter::getGainValue() const
 {
     if (convertToGain)
-        return gainValue;
+        return Decibels::decibelsToGain (getTargetScaledValue());
     else
-        return scaledValue;
+        return getTargetScaledValue();
 }
 
 float SAFEParameter::getDefaultValue() const
@@ -135,6 +135,22 @@ void SAFEParameter::setInterpolationTime (double newInterpolationTime)
     updateBlockSizes();
 }
 
+bool SAFEParameter::updateValue()
+{
+    if (changePending.compareAndSetBool (0, 1))
+    {
+        baseValue = getTargetBaseValue();
+        scaledValue = getTargetScaledValue();
+        gainValue = Decibels::decibelsToGain (scaledValue);
+
+        startInterpolating();
+
+        return true;
+    }
+
+    return false;
+}
+
 bool SAFEParameter::isInterpolating() const
 {
     return interpolating;
@@ -142,7 +158,16 @@ bool SAFEParameter::isInterpolating() const
 
 void SAFEParameter::smoothValues()
 {
-    if (interpolating)
+    if (interpolating && smoothingMode == sampleRateSmoothing)
+    {
+        // there is no ramp to step along, so go straight to the new value
+        smoothedValue = baseValue;
+        rampSamplesRemaining = 0;
+        interpolating = false;
+
+        outputValue = getOutputValue (smoothedValue);
+    }
+    else if (interpolating)
     {
         smoothedValue += interpolationStep;
         ++currentControlBlock;
@@ -153,13 +178,7 @@ void SAFEParameter::smoothValues()
             interpolating = false;
         }
 
-        float range = maxValue - minValue;
-        float smoothedScaledValue = range * pow (smoothedValue, (1 / skewFactor)) + minValue;
-
-        if (convertToGain)
-            outputValue = Decibels::decibelsToGain (smoothedScaledValue);
-        else
-            outputValue = smoothedScaledValue;
+        outputValue = getOutputValue (smoothedValue);
     }
     else
     {
@@ -190,6 +209,22 @@ void SAFEParameter::startInterpolating()
 
         initialised = true;
     }
+    else if (smoothingMode == sampleRateSmoothing)
+    {
+        if (interpolationBlockSize > 0 && smoothedValue != baseValue)
+        {
+            rampStep = (baseValue - smoothedValue) / interpolationBlockSize;
+            rampSamplesRemaining = interpolationBlockSize;
+
+            interpolating = true;
+        }
+        else
+        {
+            smoothedValue = baseValue;
+            interpolating = false;
+            smoothValues();
+        }
+    }
     else if (interpolationTime < 1000.0 / controlRate)
     {
         interpolating = false;
@@ -203,3 +238,135 @@ void SAFEParameter::startInterpolating()
         interpolating = ! (smoothedValue == baseValue);
     }
 }
+
+float SAFEParameter::getOutputValue (float newBaseValue) const
+{
+    float range = maxValue - minValue;
+    float newScaledValue = range * pow (newBaseValue, (1 / skewFactor)) + minValue;
+
+    if (convertToGain)
+        return Decibels::decibelsToGain (newScaledValue);
+    else
+        return newScaledValue;
+}
+
+//==========================================================================
+//      Per Sample Ramps
+//==========================================================================
+void SAFEParameter::setSmoothingMode (SmoothingMode newMode)
+{
+    smoothingMode = newMode;
+}
+
+SAFEParameter::SmoothingMode SAFEParameter::getSmoothingMode() const
+{
+    return smoothingMode;
+}
+
+void SAFEParameter::setMaximumRampLength (int newMaximumLength)
+{
+    maximumRampLength = jmax (0, newMaximumLength);
+    rampBuffer.allocate (jmax (1, maximumRampLength), true);
+}
+
+void SAFEParameter::setRampResolution (int newResolution)
+{
+    rampResolution = jmax (1, newResolution);
+}
+
+const float* SAFEParameter::renderRamp (int numSamples)
+{
+    if (! interpolating)
+    {
+        return nullptr;
+    }
+
+    jassert (numSamples <= maximumRampLength);
+    numSamples = jmin (numSamples, maximumRampLength);
+
+    float* ramp = rampBuffer;
+    float startValue = outputValue;
+    int sample = 0;
+
+    while (sample < numSamples)
+    {
+        // work out the exact value at the end of each segment and 
+        // draw a straight line to it
+        int segmentLength = jmin (rampResolution, numSamples - sample, rampSamplesRemaining);
+        rampSamplesRemaining -= segmentLength;
+
+        if (rampSamplesRemaining > 0)
+            smoothedValue += rampStep * segmentLength;
+        else
+            smoothedValue = baseValue;
+
+        float endValue = getOutputValue (smoothedValue);
+        float increment = (endValue - startValue) / segmentLength;
+
+        for (int i = 0; i < segmentLength - 1; ++i)
+        {
+            ramp [sample + i] = startValue + increment * (i + 1);
+        }
+
+        ramp [sample + segmentLength - 1] = endValue;
+
+        sample += segmentLength;
+        startValue = endValue;
+
+        if (rampSamplesRemaining <= 0)
+        {
+            // the value has arrived, hold it for the rest of the block
+            FloatVectorOperations::fill (ramp + sample, endValue, numSamples - sample);
+            interpolating = false;
+            break;
+        }
+    }
+
+    outputValue = startValue;
+
+    return ramp;
+}
+
+//==========================================================================
+//      Passing Values Between Threads
+//==========================================================================
+namespace
+{
+    union PackedParameterValues
+    {
+        int64 packed;
+        float values [2];
+    };
+}
+
+void SAFEParameter::publishValues (float newBaseValue, float newScaledValue)
+{
+    PackedParameterValues newValues;
+    newValues.values [0] = newBaseValue;
+    newValues.values [1] = newScaledValue;
+
+    targetValues = newValues.packed;
+    changePending = 1;
+
+    // values set before the parameter has been set up are applied straight away
+    if (! initialised)
+    {
+        updateValue();
+    }
+}
+
+float SAFEParameter::getTargetBaseValue() const
+{
+    PackedParameterValues currentValues;
+    currentValues.packed = targetValues.get();
+
+    return currentValues.values [0];
+}
+
+float SAFEParameter::getTargetScaledValue() const
+{
+    PackedParameterValues currentValues;
+    currentValues.packed = targetValues.get();
+
+    return currentValues.values [1];
+}
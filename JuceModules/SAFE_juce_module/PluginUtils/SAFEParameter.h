@@ -3,10 +3,22 @@
 
 /** 
  *  A class for handling SAFE plug-in parameters.
+ *
+ *  The setters and getters can be called from any thread. New values are 
+ *  published through a single atomic holding both the base and scaled value
+ *  and only take effect on the audio thread when updateValue() is called, 
+ *  so the smoothing state is only ever touched by the audio thread.
  */
 class SAFEParameter
 {
 public:
+    /** The ways in which a parameter can move towards a new value. */
+    enum SmoothingMode
+    {
+        controlRateSmoothing, /**< The value is stepped once per control block by smoothValues(). */
+        sampleRateSmoothing   /**< A ramp is rendered for each block by renderRamp(). */
+    };
+
     //==========================================================================
     //      Constructor and Destructor
     //==========================================================================
@@ -113,6 +125,16 @@ public:
      */
     void setInterpolationTime (double newInterpolationTime);
 
+    /** Apply the last value set to the parameter.
+     *
+     *  This should be called from the audio thread at the start of each block. 
+     *  It starts the interpolation towards a value set with setBaseValue() or 
+     *  setScaledValue() since the last call.
+     *
+     *  Returns true if there was a new value to apply.
+     */
+    bool updateValue();
+
     /** Returns true if the parameter value is not yet equal to the value it was set to. */
     bool isInterpolating() const;
 
@@ -120,11 +142,67 @@ public:
      *
      *  This should be called after each group of
      *  \f$ \frac{\text{sample rate}}{\text{control rate}} \f$ samples has been processed.
+     *  A parameter using sampleRateSmoothing jumps straight to the value it was set to.
      */
     void smoothValues();
 
+    //==========================================================================
+    //      Per Sample Ramps
+    //==========================================================================
+    /** Set how the parameter moves towards a new value.
+     *
+     *  This should be set before processing starts, switching mode half way
+     *  through an interpolation will make the parameter jump.
+     *
+     *  @param newMode  the smoothing mode to use
+     */
+    void setSmoothingMode (SmoothingMode newMode);
+
+    /** Returns the smoothing mode the parameter is using. */
+    SmoothingMode getSmoothingMode() const;
+
+    /** Set the longest ramp renderRamp() will be asked for.
+     *
+     *  This allocates the ramp buffer so should not be called from the audio thread.
+     *
+     *  @param newMaximumLength  the maximum number of samples in a ramp
+     */
+    void setMaximumRampLength (int newMaximumLength);
+
+    /** Set how often the ramp is evaluated exactly.
+     *
+     *  Between these points the ramp is linearly interpolated, which saves working
+     *  out the skew and decibel conversion for every sample. A resolution of 1 
+     *  evaluates every sample exactly.
+     *
+     *  @param newResolution  the number of samples between exact points on the ramp
+     */
+    void setRampResolution (int newResolution);
+
+    /** Render the next section of the parameter's ramp.
+     *
+     *  Moves the parameter on by numSamples samples and writes the value it takes
+     *  at each of them into the ramp buffer. The value reference is left holding the
+     *  value at the end of the ramp. 
+     *
+     *  Returns a pointer to the ramp, or nullptr if the parameter was not 
+     *  interpolating, in which case the value reference is constant for the block.
+     *
+     *  @param numSamples  the number of samples to render - this should not be
+     *                     more than the maximum ramp length
+     */
+    const float* renderRamp (int numSamples);
+
 private:
-    float baseValue, minValue, maxValue, defaultValue, skewFactor, scaledValue, gainValue;
+    float minValue, maxValue, defaultValue, skewFactor;
+
+    // the value most recently set, packed as (base, scaled) so the pair is
+    // always read and written in one go
+    Atomic <int64> targetValues;
+    Atomic <int> changePending;
+
+    // the target value as seen by the audio thread
+    float baseValue, scaledValue, gainValue;
     float smoothedValue;
 
     double sampleRate, controlRate, interpolationTime;
@@ -133,6 +211,12 @@ private:
     int controlBlockSize, interpolationBlockSize;
     int controlBlocksPerChange, currentControlBlock;
 
+    SmoothingMode smoothingMode;
+    HeapBlock <float> rampBuffer;
+    int maximumRampLength, rampResolution;
+    int rampSamplesRemaining;
+    float rampStep;
+
     bool interpolating, initialised;
     float& outputValue;
     
@@ -144,9 +228,36 @@ private:
 
     void updateBlockSizes();
 
+    void publishValues (float newBaseValue, float newScaledValue);
+    float getTargetBaseValue() const;
+    float getTargetScaledValue() const;
+
     void startInterpolating();
+    float getOutputValue (float newBaseValue) const;
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SAFEParameter)
 };
 
+//==========================================================================
+//      Parameter Layout Tables
+//==========================================================================
+/**
+ *  A description of a single SAFE plug-in parameter.
+ *
+ *  Plug-ins declare their parameters as a static array of these, in the same
+ *  order as their parameter index enum, and pass it to 
+ *  SAFEAudioProcessor::addParameters(). The members have the same meaning as
+ *  the arguments to the SAFEParameter constructor.
+ */
+struct SAFEParameterInfo
+{
+    const char* name;
+    float initialValue, minValue, maxValue;
+    const char* units;
+    float skewFactor;
+    bool convertDBToGainValue;
+    double interpolationTime;
+    float UIScaleFactor;
+};
+
 #endif  // __SAFEPARAMETER__
@@ -0,0 +1,250 @@
+//==========================================================================
+//      Constructor and Destructor
+//==========================================================================
+SAFEProcessTimer::SAFEProcessTimer()
+    : blockStartCycles (0),
+      budgetCyclesPerSample (0),
+      cyclesPerSecond (0),
+      sampleRate (0)
+{
+    clearCounters();
+}
+
+SAFEProcessTimer::~SAFEProcessTimer()
+{
+}
+
+//==========================================================================
+//      Setup
+//==========================================================================
+void SAFEProcessTimer::prepare (double sampleRateInit)
+{
+    // the cycle counter runs at the same rate for every instance
+    static const double measuredCyclesPerSecond = measureCyclesPerSecond();
+
+    cyclesPerSecond = measuredCyclesPerSecond;
+    sampleRate = sampleRateInit;
+    budgetCyclesPerSample = sampleRate > 0 ? cyclesPerSecond / sampleRate : 0;
+
+    // the audio thread isn't running yet so it is safe to clear things here
+    resetPending = 0;
+    clearCounters();
+}
+
+void SAFEProcessTimer::reset()
+{
+    resetPending = 1;
+}
+
+//==========================================================================
+//      Timing from the Audio Thread
+//==========================================================================
+void SAFEProcessTimer::endBlock (int numSamples) noexcept
+{
+   #if SAFE_ENABLE_PROCESS_TIMING
+    const int64 processBlockCycles = getCycleCount() - blockStartCycles;
+
+    if (resetPending.compareAndSetBool (0, 1))
+    {
+        clearCounters();
+    }
+
+    blockCycles [processBlockStage] = processBlockCycles;
+
+    for (int stage = 0; stage < numStages; ++stage)
+    {
+        const int64 cycles = blockCycles [stage];
+        AtomicStageCounters& counters = stages [stage];
+
+        ++counters.numBlocks;
+        counters.totalCycles += cycles;
+        ++counters.histogram [getBucket (cycles)];
+
+        if (cycles > maxCycles [stage])
+        {
+            maxCycles [stage] = cycles;
+            counters.maxCycles = cycles;
+        }
+
+        blockCycles [stage] = 0;
+    }
+
+    if (processBlockCycles > budgetCyclesPerSample * numSamples)
+    {
+        ++numDeadlineMisses;
+    }
+   #else
+    (void) numSamples;
+   #endif
+}
+
+//==========================================================================
+//      Reading the Counters
+//==========================================================================
+double SAFEProcessTimer::Snapshot::cyclesToMicroseconds (double cycles) const
+{
+    return cyclesPerSecond > 0 ? cycles * 1.0e6 / cyclesPerSecond : 0;
+}
+
+SAFEProcessTimer::Snapshot SAFEProcessTimer::getSnapshot() const
+{
+    Snapshot snapshot;
+
+    for (int stage = 0; stage < numStages; ++stage)
+    {
+        const AtomicStageCounters& counters = stages [stage];
+        StageCounters& copy = snapshot.stages [stage];
+
+        copy.numBlocks = counters.numBlocks.get();
+        copy.totalCycles = counters.totalCycles.get();
+        copy.maxCycles = counters.maxCycles.get();
+
+        for (int bucket = 0; bucket < numBuckets; ++bucket)
+        {
+            copy.histogram [bucket] = counters.histogram [bucket].get();
+        }
+    }
+
+    snapshot.numDeadlineMisses = numDeadlineMisses.get();
+    snapshot.cyclesPerSecond = cyclesPerSecond;
+    snapshot.sampleRate = sampleRate;
+
+    return snapshot;
+}
+
+Result SAFEProcessTimer::writeToFile (const File& file) const
+{
+    if (! file.replaceWithText (JSON::toString (toVar()) + "\n"))
+    {
+        return Result::fail ("Could not write " + file.getFullPathName());
+    }
+
+    return Result::ok();
+}
+
+var SAFEProcessTimer::toVar() const
+{
+    const Snapshot snapshot = getSnapshot();
+
+    DynamicObject* stageObjects = new DynamicObject();
+
+    for (int stage = 0; stage < numStages; ++stage)
+    {
+        const StageCounters& counters = snapshot.stages [stage];
+
+        // trim the empty buckets off the top of the histogram
+        int numUsedBuckets = numBuckets;
+
+        while (numUsedBuckets > 0 && counters.histogram [numUsedBuckets - 1] == 0)
+        {
+            --numUsedBuckets;
+        }
+
+        Array <var> histogram;
+
+        for (int bucket = 0; bucket < numUsedBuckets; ++bucket)
+        {
+            histogram.add (counters.histogram [bucket]);
+        }
+
+        const double meanCycles = counters.numBlocks > 0 ? (double) counters.totalCycles / counters.numBlocks : 0;
+
+        DynamicObject* stageObject = new DynamicObject();
+        stageObject->setProperty ("blocks", counters.numBlocks);
+        stageObject->setProperty ("totalCycles", counters.totalCycles);
+        stageObject->setProperty ("meanMicroseconds", snapshot.cyclesToMicroseconds (meanCycles));
+        stageObject->setProperty ("maxMicroseconds", snapshot.cyclesToMicroseconds ((double) counters.maxCycles));
+        stageObject->setProperty ("log2CyclesHistogram", histogram);
+
+        stageObjects->setProperty (getStageName ((Stage) stage), var (stageObject));
+    }
+
+    DynamicObject* timings = new DynamicObject();
+    timings->setProperty ("plugin", JucePlugin_Name);
+    timings->setProperty ("date", Time::getCurrentTime().formatted ("%Y-%m-%dT%H:%M:%S"));
+    timings->setProperty ("sampleRate", snapshot.sampleRate);
+    timings->setProperty ("cyclesPerSecond", snapshot.cyclesPerSecond);
+    timings->setProperty ("deadlineMisses", snapshot.numDeadlineMisses);
+    timings->setProperty ("stages", var (stageObjects));
+
+    return var (timings);
+}
+
+String SAFEProcessTimer::getStageName (Stage stage)
+{
+    switch (stage)
+    {
+        case processBlockStage:
+            return "processBlock";
+
+        case pluginProcessingStage:
+            return "pluginProcessing";
+
+        case parameterSmoothingStage:
+            return "parameterSmoothing";
+
+        case captureStage:
+            return "capture";
+
+        default:
+            return String::empty;
+    }
+}
+
+//==========================================================================
+//      Internal Bits
+//==========================================================================
+void SAFEProcessTimer::clearCounters() noexcept
+{
+    for (int stage = 0; stage < numStages; ++stage)
+    {
+        AtomicStageCounters& counters = stages [stage];
+
+        counters.numBlocks = 0;
+        counters.totalCycles = 0;
+        counters.maxCycles = 0;
+
+        for (int bucket = 0; bucket < numBuckets; ++bucket)
+        {
+            counters.histogram [bucket] = 0;
+        }
+
+        blockCycles [stage] = 0;
+        maxCycles [stage] = 0;
+    }
+
+    numDeadlineMisses = 0;
+}
+
+int SAFEProcessTimer::getBucket (int64 cycles) noexcept
+{
+    int bucket = 0;
+
+    while (cycles > 1 && bucket < numBuckets - 1)
+    {
+        cycles >>= 1;
+        ++bucket;
+    }
+
+    return bucket;
+}
+
+double SAFEProcessTimer::measureCyclesPerSecond()
+{
+   #if JUCE_INTEL && (JUCE_GCC || JUCE_MSVC)
+    // count cycles against the high resolution clock for a short while
+    const int64 startTicks = Time::getHighResolutionTicks();
+    const int64 startCycles = getCycleCount();
+
+    Thread::sleep (10);
+
+    const int64 endTicks = Time::getHighResolutionTicks();
+    const int64 endCycles = getCycleCount();
+
+    const double seconds = Time::highResolutionTicksToSeconds (endTicks - startTicks);
+
+    return seconds > 0 ? (endCycles - startCycles) / seconds : 0;
+   #else
+    return (double) Time::getHighResolutionTicksPerSecond();
+   #endif
+}
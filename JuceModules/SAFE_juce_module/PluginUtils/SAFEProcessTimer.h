@@ -0,0 +1,218 @@
+#ifndef __SAFEPROCESSTIMER__
+#define __SAFEPROCESSTIMER__
+
+/** Set this to 0 to compile the timing out of SAFEAudioProcessor::processBlock(). */
+#ifndef SAFE_ENABLE_PROCESS_TIMING
+ #define SAFE_ENABLE_PROCESS_TIMING 1
+#endif
+
+/**
+ *  Always on timing of the stages of a SAFEAudioProcessor's processBlock().
+ *
+ *  Each stage is timed with the CPU's cycle counter. The times are added up over a
+ *  block on the audio thread and published once at the end of it, into a log2 histogram
+ *  of cycles for each stage. Blocks which take longer than their real time budget are
+ *  counted as deadline misses.
+ *
+ *  Publishing a block is a handful of uncontended atomic adds to memory only this
+ *  instance uses, with no locks or allocation. Nothing else happens until someone
+ *  calls getSnapshot() or writeToFile(), so the counters can be left running in
+ *  release builds.
+ */
+class SAFEProcessTimer
+{
+public:
+    //==========================================================================
+    //      Stages and Histograms
+    //==========================================================================
+    /** The parts of processBlock() which are timed. */
+    enum Stage
+    {
+        processBlockStage, /**< The whole of processBlock(). */
+        pluginProcessingStage, /**< All the calls to pluginProcessing() in a block. */
+        parameterSmoothingStage, /**< Applying and smoothing parameter changes. */
+        captureStage, /**< Copying audio into the analysis recording buffers, the feature monitor and the spectrum analyser. */
+        numStages
+    };
+
+    /** The number of histogram buckets for each stage.
+     *
+     *  Bucket n counts the blocks which took between 2^n and 2^(n + 1) cycles, the last
+     *  bucket counts everything longer than that.
+     */
+    static const int numBuckets = 32;
+
+    /** The counters for one stage. */
+    struct StageCounters
+    {
+        int64 numBlocks; /**< The number of blocks timed. */
+        int64 totalCycles; /**< The total time taken. */
+        int64 maxCycles; /**< The time taken by the slowest block. */
+        int64 histogram [numBuckets]; /**< The number of blocks in each bucket. */
+    };
+
+    /** A copy of all the counters at one point in time. */
+    struct Snapshot
+    {
+        StageCounters stages [numStages]; /**< The counters for each stage. */
+        int64 numDeadlineMisses; /**< The number of blocks which took longer than real time. */
+        double cyclesPerSecond; /**< The rate of the cycle counter. */
+        double sampleRate; /**< The sample rate the plug-in is playing at. */
+
+        /** Convert a number of cycles to microseconds. */
+        double cyclesToMicroseconds (double cycles) const;
+    };
+
+    //==========================================================================
+    //      Constructor and Destructor
+    //==========================================================================
+    /** Create a new set of timers. */
+    SAFEProcessTimer();
+
+    /** Destructor */
+    ~SAFEProcessTimer();
+
+    //==========================================================================
+    //      Setup
+    //==========================================================================
+    /** Set the sample rate the block budgets are worked out from and reset the counters.
+     *
+     *  This should be called from prepareToPlay(). The first call also measures the
+     *  speed of the cycle counter, which takes around 10 milliseconds.
+     *
+     *  @param sampleRate  the sample rate the plug-in will be playing at
+     */
+    void prepare (double sampleRate);
+
+    /** Reset the counters.
+     *
+     *  This can be called from any thread. The audio thread clears the counters at the
+     *  end of its next block, so they won't reset while audio isn't playing.
+     */
+    void reset();
+
+    //==========================================================================
+    //      Timing from the Audio Thread
+    //==========================================================================
+    /** Returns the current value of the cycle counter.
+     *
+     *  On processors without one this falls back to Time::getHighResolutionTicks().
+     */
+    static inline int64 getCycleCount() noexcept
+    {
+       #if JUCE_INTEL && (JUCE_GCC || JUCE_MSVC)
+        return (int64) __rdtsc();
+       #else
+        return Time::getHighResolutionTicks();
+       #endif
+    }
+
+    /** Start timing a block.
+     *
+     *  Call this at the start of processBlock(). This and the other timing functions
+     *  should only be called from the audio thread.
+     */
+    inline void startBlock() noexcept
+    {
+       #if SAFE_ENABLE_PROCESS_TIMING
+        blockStartCycles = getCycleCount();
+       #endif
+    }
+
+    /** Add some time to a stage of the current block.
+     *
+     *  @param stage   the stage to add the time to
+     *  @param cycles  the number of cycles the stage took
+     */
+    inline void addTime (Stage stage, int64 cycles) noexcept
+    {
+        blockCycles [stage] += cycles;
+    }
+
+    /** Publish the times for the block which just finished.
+     *
+     *  Call this at the end of processBlock().
+     *
+     *  @param numSamples  the number of samples in the block
+     */
+    void endBlock (int numSamples) noexcept;
+
+    /** Adds the time from its construction to its destruction to a stage. */
+    class ScopedStage
+    {
+    public:
+       #if SAFE_ENABLE_PROCESS_TIMING
+        inline ScopedStage (SAFEProcessTimer& timerInit, Stage stageInit) noexcept
+            : timer (timerInit),
+              stage (stageInit),
+              start (getCycleCount())
+        {
+        }
+
+        inline ~ScopedStage() noexcept
+        {
+            timer.addTime (stage, getCycleCount() - start);
+        }
+
+    private:
+        SAFEProcessTimer& timer;
+        Stage stage;
+        int64 start;
+       #else
+        inline ScopedStage (SAFEProcessTimer&, Stage) noexcept {}
+       #endif
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedStage)
+    };
+
+    //==========================================================================
+    //      Reading the Counters
+    //==========================================================================
+    /** Returns a copy of the counters.
+     *
+     *  This can be called from any thread. The counters are read one at a time while
+     *  the audio thread is still writing them, so a stage's histogram may be a block
+     *  out from its total.
+     */
+    Snapshot getSnapshot() const;
+
+    /** Write the counters to a JSON file.
+     *
+     *  @param file  the file to write to, it will be replaced if it already exists
+     */
+    Result writeToFile (const File& file) const;
+
+    /** Returns the counters as an object ready to be written as JSON. */
+    var toVar() const;
+
+    /** Returns the name of a stage. */
+    static String getStageName (Stage stage);
+
+private:
+    struct AtomicStageCounters
+    {
+        Atomic <int64> numBlocks, totalCycles, maxCycles;
+        Atomic <int64> histogram [numBuckets];
+    };
+
+    AtomicStageCounters stages [numStages];
+    Atomic <int64> numDeadlineMisses;
+    Atomic <int> resetPending;
+
+    // only touched by the audio thread
+    int64 blockStartCycles;
+    int64 blockCycles [numStages];
+    int64 maxCycles [numStages];
+    double budgetCyclesPerSample;
+
+    double cyclesPerSecond, sampleRate;
+
+    void clearCounters() noexcept;
+
+    static int getBucket (int64 cycles) noexcept;
+    static double measureCyclesPerSecond();
+
+    JUCE_DECLARE_NON_COPYABLE (SAFEProcessTimer)
+};
+
+#endif // __SAFEPROCESSTIMER__
@@ -0,0 +1,187 @@
+//==========================================================================
+//      Constructor and Destructor
+//==========================================================================
+SAFESemanticData::SAFESemanticData()
+    : Thread ("SemanticDataLoader"),
+      loadRequested (1),
+      loadedEvent (true)
+{
+    File documentsDirectory (File::getSpecialLocation (File::userDocumentsDirectory));
+
+    File dataDirectory (documentsDirectory.getChildFile ("SAFEPluginData"));
+
+    if (! dataDirectory.isDirectory())
+    {
+        dataDirectory.createDirectory();
+    }
+
+    file = dataDirectory.getChildFile (JucePlugin_Name + String ("Data.xml"));
+
+    startThread();
+}
+
+SAFESemanticData::~SAFESemanticData()
+{
+    stopThread (4000);
+}
+
+File SAFESemanticData::getFile() const
+{
+    return file;
+}
+
+//==========================================================================
+//      Loading
+//==========================================================================
+bool SAFESemanticData::isLoaded() const
+{
+    return loadedEvent.wait (0);
+}
+
+void SAFESemanticData::waitUntilLoaded()
+{
+    loadedEvent.wait();
+}
+
+//==========================================================================
+//      Reading and Writing Entries
+//==========================================================================
+StringArray SAFESemanticData::getDescriptors()
+{
+    const ScopedLock sl (lock);
+
+    // pick up anything another process has saved
+    if (isLoaded() && hasChangedOnDisk())
+    {
+        loadRequested = 1;
+        notify();
+    }
+
+    return descriptors;
+}
+
+XmlElement* SAFESemanticData::createParameterSettings (const String& descriptor)
+{
+    waitUntilLoaded();
+
+    const ScopedLock sl (lock);
+
+    // go through XML elements and look for the first one with the descriptor we want
+    forEachXmlChildElement (*data, entry)
+    {
+        int numAttributes = entry->getNumAttributes();
+
+        for (int attribute = 0; attribute < numAttributes; ++attribute)
+        {
+            if (entry->getAttributeValue (attribute) == descriptor)
+            {
+                XmlElement* parametersElement = entry->getChildByName ("ParameterSettings");
+
+                return parametersElement != nullptr ? new XmlElement (*parametersElement) : nullptr;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+bool SAFESemanticData::addEntry (XmlElement* newEntry)
+{
+    ScopedPointer <XmlElement> entry (newEntry);
+
+    waitUntilLoaded();
+
+    const ScopedLock fl (fileLock);
+
+    // another process may have saved to the file since it was loaded
+    if (hasChangedOnDisk())
+    {
+        loadFile();
+    }
+
+    {
+        const ScopedLock sl (lock);
+
+        addDescriptors (*entry, descriptors);
+        data->addChildElement (entry.release());
+    }
+
+    // nothing else changes the data while we hold the file lock, so it is safe to read it here
+    bool written = data->writeToFile (file, "");
+
+    {
+        const ScopedLock sl (lock);
+        lastModificationTime = file.getLastModificationTime();
+    }
+
+    sendChangeMessage();
+
+    return written;
+}
+
+//==========================================================================
+//      Background Loading
+//==========================================================================
+void SAFESemanticData::run()
+{
+    while (! threadShouldExit())
+    {
+        if (loadRequested.compareAndSetBool (0, 1))
+        {
+            loadFile();
+            loadedEvent.signal();
+            sendChangeMessage();
+        }
+
+        wait (-1);
+    }
+}
+
+void SAFESemanticData::loadFile()
+{
+    const ScopedLock fl (fileLock);
+
+    ScopedPointer <XmlElement> newData;
+    StringArray newDescriptors;
+
+    if (file.exists())
+    {
+        XmlDocument semanticDataDocument (file);
+        newData = semanticDataDocument.getDocumentElement();
+    }
+
+    if (newData == nullptr)
+    {
+        String elementName (JucePlugin_Name + String ("Data"));
+        newData = new XmlElement (SAFEAudioProcessor::makeXmlString (elementName));
+
+        if (! file.exists())
+        {
+            newData->writeToFile (file, "");
+        }
+    }
+
+    forEachXmlChildElement (*newData, entry)
+    {
+        addDescriptors (*entry, newDescriptors);
+    }
+
+    const ScopedLock sl (lock);
+
+    data.swapWith (newData);
+    descriptors.swapWith (newDescriptors);
+    lastModificationTime = file.getLastModificationTime();
+}
+
+bool SAFESemanticData::hasChangedOnDisk() const
+{
+    return file.getLastModificationTime() != lastModificationTime;
+}
+
+void SAFESemanticData::addDescriptors (const XmlElement& entry, StringArray& descriptorList)
+{
+    for (int i = 0; i < entry.getNumAttributes(); ++i)
+    {
+        descriptorList.add (entry.getStringAttribute (String ("Descriptor") + String (i)));
+    }
+}
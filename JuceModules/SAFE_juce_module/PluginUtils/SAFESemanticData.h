@@ -0,0 +1,107 @@
+#ifndef __SAFESEMANTICDATA__
+#define __SAFESEMANTICDATA__
+
+/**
+ *  The local file of descriptors shared by every instance of a plug-in in the process.
+ *
+ *  Hold one of these with a SharedResourcePointer. The file is parsed once, on a
+ *  background thread, the first time an instance is created, so creating more
+ *  instances doesn't touch the file at all. Everything which saves or loads a
+ *  descriptor goes through here so the instances all see the same data.
+ *
+ *  A change message is sent once the file has been loaded and whenever an entry is
+ *  added. If another process writes to the file it is read again the next time it
+ *  is used.
+ */
+class SAFESemanticData : public ChangeBroadcaster,
+                         private Thread
+{
+public:
+    //==========================================================================
+    //      Constructor and Destructor
+    //==========================================================================
+    /** Create a new data file, use a SharedResourcePointer rather than making your own. */
+    SAFESemanticData();
+
+    /** Destructor */
+    ~SAFESemanticData();
+
+    /** Returns the file the descriptors are saved to.
+     *
+     *  This is in a directory called SAFEPluginData in the user's Documents directory.
+     */
+    File getFile() const;
+
+    //==========================================================================
+    //      Loading
+    //==========================================================================
+    /** Returns true once the file has been loaded. */
+    bool isLoaded() const;
+
+    /** Wait for the background thread to finish loading the file. */
+    void waitUntilLoaded();
+
+    //==========================================================================
+    //      Reading and Writing Entries
+    //==========================================================================
+    /** Returns every descriptor in the file.
+     *
+     *  This doesn't wait for the file to be loaded, until it is the list is empty.
+     */
+    StringArray getDescriptors();
+
+    /** Returns a copy of the parameter settings saved with a descriptor.
+     *
+     *  This waits for the file to be loaded. The caller is responsible for deleting
+     *  the element.
+     *
+     *  @param descriptor  the descriptor to look for
+     *
+     *  @return the ParameterSettings element of the first entry with the descriptor,
+     *          or nullptr if there isn't one
+     */
+    XmlElement* createParameterSettings (const String& descriptor);
+
+    /** Add an entry to the file and save it.
+     *
+     *  This waits for the file to be loaded.
+     *
+     *  @param newEntry  the entry to add, this will be deleted when it is no longer needed
+     *
+     *  @return true if the file was written
+     */
+    bool addEntry (XmlElement* newEntry);
+
+private:
+    //==========================================================================
+    //      Background Loading
+    //==========================================================================
+    void run() override;
+
+    /** Parse the file, replacing the current data. */
+    void loadFile();
+
+    /** Returns true if the file has been written to since it was last loaded or saved. */
+    bool hasChangedOnDisk() const;
+
+    /** Add the descriptors from an entry in the file to a list. */
+    static void addDescriptors (const XmlElement& entry, StringArray& descriptorList);
+
+    File file;
+
+    // held while the file is read or written, so only one thread changes the data at once
+    CriticalSection fileLock;
+
+    // held while the data is read or swapped for newly loaded data
+    CriticalSection lock;
+    ScopedPointer <XmlElement> data;
+    StringArray descriptors;
+    Time lastModificationTime;
+
+    Atomic <int> loadRequested;
+    WaitableEvent loadedEvent;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SAFESemanticData)
+};
+
+#endif // __SAFESEMANTICDATA__
@@ -0,0 +1,178 @@
+//==========================================================================
+//      Constructor and Destructor
+//==========================================================================
+SAFETrace::SAFETrace()
+{
+}
+
+SAFETrace::~SAFETrace()
+{
+}
+
+//==========================================================================
+//      Turning Tracing On
+//==========================================================================
+bool SAFETrace::isEnabled()
+{
+   #if SAFE_ENABLE_TRACING
+    return true;
+   #else
+    return SystemStats::getEnvironmentVariable ("SAFE_TRACE_DIRECTORY", String::empty).isNotEmpty();
+   #endif
+}
+
+File SAFETrace::getTraceDirectory()
+{
+    const String traceDirectory = SystemStats::getEnvironmentVariable ("SAFE_TRACE_DIRECTORY", String::empty);
+
+    if (traceDirectory.isNotEmpty())
+    {
+        return File::getCurrentWorkingDirectory().getChildFile (traceDirectory);
+    }
+
+    File documentsDirectory (File::getSpecialLocation (File::userDocumentsDirectory));
+
+    return documentsDirectory.getChildFile ("SAFEPluginData").getChildFile ("Traces");
+}
+
+//==========================================================================
+//      Adding Events
+//==========================================================================
+void SAFETrace::addEvent (const String& name, const String& category, int64 startTicks, int64 endTicks,
+                          Thread::ThreadID threadID, const String& threadName, const var& arguments)
+{
+    const ScopedLock scopedLock (lock);
+
+    // a complete event, with its start and duration in microseconds
+    DynamicObject* event = new DynamicObject();
+    event->setProperty ("name", name);
+    event->setProperty ("cat", category);
+    event->setProperty ("ph", "X");
+    event->setProperty ("ts", ticksToMicroseconds (startTicks));
+    event->setProperty ("dur", ticksToMicroseconds (endTicks - startTicks));
+    event->setProperty ("pid", 1);
+    event->setProperty ("tid", getThreadIndex (threadID, threadName));
+
+    if (! arguments.isVoid())
+    {
+        event->setProperty ("args", arguments);
+    }
+
+    events.add (var (event));
+}
+
+SAFETrace::ScopedEvent::ScopedEvent (SAFETrace* traceInit, const char* nameInit, const char* categoryInit)
+    : trace (traceInit),
+      name (nameInit),
+      category (categoryInit),
+      startTicks (trace != nullptr ? Time::getHighResolutionTicks() : 0)
+{
+}
+
+SAFETrace::ScopedEvent::~ScopedEvent()
+{
+    if (trace != nullptr)
+    {
+        // threads the host made have no JUCE Thread object to get a name from
+        Thread* currentThread = Thread::getCurrentThread();
+        MessageManager* messageManager = MessageManager::getInstanceWithoutCreating();
+        String threadName ("Host Thread");
+
+        if (currentThread != nullptr)
+        {
+            threadName = currentThread->getThreadName();
+        }
+        else if (messageManager != nullptr && messageManager->isThisTheMessageThread())
+        {
+            threadName = "Message Thread";
+        }
+
+        trace->addEvent (name, category, startTicks, Time::getHighResolutionTicks(), Thread::getCurrentThreadId(), threadName, arguments);
+    }
+}
+
+void SAFETrace::ScopedEvent::setArgument (const Identifier& argumentName, const var& value)
+{
+    if (trace != nullptr)
+    {
+        if (arguments.isVoid())
+        {
+            arguments = new DynamicObject();
+        }
+
+        arguments.getDynamicObject()->setProperty (argumentName, value);
+    }
+}
+
+//==========================================================================
+//      Writing the Trace
+//==========================================================================
+Result SAFETrace::writeToFile (const File& file) const
+{
+    const Result directoryCreated = file.getParentDirectory().createDirectory();
+
+    if (directoryCreated.failed())
+    {
+        return directoryCreated;
+    }
+
+    if (! file.replaceWithText (JSON::toString (toVar()) + "\n"))
+    {
+        return Result::fail ("Could not write " + file.getFullPathName());
+    }
+
+    return Result::ok();
+}
+
+var SAFETrace::toVar() const
+{
+    const ScopedLock scopedLock (lock);
+
+    Array <var> allEvents;
+
+    // metadata events so viewers show the threads' names
+    for (int i = 0; i < threadNames.size(); ++i)
+    {
+        DynamicObject* nameArgument = new DynamicObject();
+        nameArgument->setProperty ("name", threadNames [i]);
+
+        DynamicObject* threadNameEvent = new DynamicObject();
+        threadNameEvent->setProperty ("name", "thread_name");
+        threadNameEvent->setProperty ("ph", "M");
+        threadNameEvent->setProperty ("pid", 1);
+        threadNameEvent->setProperty ("tid", i);
+        threadNameEvent->setProperty ("args", var (nameArgument));
+
+        allEvents.add (var (threadNameEvent));
+    }
+
+    allEvents.addArray (events);
+
+    DynamicObject* trace = new DynamicObject();
+    trace->setProperty ("traceEvents", allEvents);
+    trace->setProperty ("displayTimeUnit", "ms");
+
+    return var (trace);
+}
+
+//==========================================================================
+//      Internal Bits
+//==========================================================================
+int SAFETrace::getThreadIndex (Thread::ThreadID threadID, const String& threadName)
+{
+    int index = threadIDs.indexOf (threadID);
+
+    if (index < 0)
+    {
+        index = threadIDs.size();
+        threadIDs.add (threadID);
+        threadNames.add (threadName);
+    }
+
+    return index;
+}
+
+double SAFETrace::ticksToMicroseconds (int64 ticks)
+{
+    return Time::highResolutionTicksToSeconds (ticks) * 1.0e6;
+}
@@ -0,0 +1,117 @@
+#ifndef __SAFETRACE__
+#define __SAFETRACE__
+
+/** Set this to 1 to trace every save, without needing the SAFE_TRACE_DIRECTORY
+ *  environment variable. */
+#ifndef SAFE_ENABLE_TRACING
+ #define SAFE_ENABLE_TRACING 0
+#endif
+
+/**
+ *  A trace of one save, in Chrome's trace event format.
+ *
+ *  Stages of the capture, analysis and save are added as complete events, which can
+ *  be nested and can come from any thread. The trace is written as JSON which can be
+ *  loaded into chrome://tracing or any viewer which reads the trace event format, to
+ *  see how long each stage took and which thread it ran on.
+ *
+ *  Tracing is turned on by setting the SAFE_TRACE_DIRECTORY environment variable to
+ *  the directory the traces should go in, or by building with SAFE_ENABLE_TRACING set
+ *  to 1, in which case they go in SAFEPluginData/Traces. When tracing is off no trace
+ *  is created and the ScopedEvents given a null trace do nothing.
+ */
+class SAFETrace
+{
+public:
+    //==========================================================================
+    //      Constructor and Destructor
+    //==========================================================================
+    /** Create a new, empty trace. */
+    SAFETrace();
+
+    /** Destructor */
+    ~SAFETrace();
+
+    //==========================================================================
+    //      Turning Tracing On
+    //==========================================================================
+    /** Returns true if saves should be traced. */
+    static bool isEnabled();
+
+    /** Returns the directory traces should be written to. */
+    static File getTraceDirectory();
+
+    //==========================================================================
+    //      Adding Events
+    //==========================================================================
+    /** Add an event which has already finished.
+     *
+     *  @param name        the name to show for the event
+     *  @param category    the category of the event, which viewers can filter by
+     *  @param startTicks  when the event started, from Time::getHighResolutionTicks()
+     *  @param endTicks    when the event finished, from Time::getHighResolutionTicks()
+     *  @param threadID    the thread the event ran on
+     *  @param threadName  a name for the thread, if it hasn't been named already
+     *  @param arguments   an object of extra values to show with the event, or a void var
+     */
+    void addEvent (const String& name, const String& category, int64 startTicks, int64 endTicks,
+                   Thread::ThreadID threadID, const String& threadName, const var& arguments = var::null);
+
+    /** Adds an event for the time from its construction to its destruction.
+     *
+     *  If the trace is null this does nothing, so events can be left in code which
+     *  only sometimes has a trace to add them to.
+     */
+    class ScopedEvent
+    {
+    public:
+        /** Start an event.
+         *
+         *  @param trace     the trace to add the event to, or nullptr
+         *  @param name      the name to show for the event
+         *  @param category  the category of the event
+         */
+        ScopedEvent (SAFETrace* trace, const char* name, const char* category);
+
+        /** Finish the event and add it to the trace. */
+        ~ScopedEvent();
+
+        /** Set an extra value to show with the event. */
+        void setArgument (const Identifier& argumentName, const var& value);
+
+    private:
+        SAFETrace* trace;
+        const char* name;
+        const char* category;
+        int64 startTicks;
+        var arguments;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedEvent)
+    };
+
+    //==========================================================================
+    //      Writing the Trace
+    //==========================================================================
+    /** Write the trace to a JSON file.
+     *
+     *  @param file  the file to write to, it will be replaced if it already exists
+     */
+    Result writeToFile (const File& file) const;
+
+    /** Returns the trace as an object in the trace event format. */
+    var toVar() const;
+
+private:
+    CriticalSection lock;
+    Array <var> events;
+    Array <Thread::ThreadID> threadIDs;
+    StringArray threadNames;
+
+    int getThreadIndex (Thread::ThreadID threadID, const String& threadName);
+
+    static double ticksToMicroseconds (int64 ticks);
+
+    JUCE_DECLARE_NON_COPYABLE (SAFETrace)
+};
+
+#endif // __SAFETRACE__
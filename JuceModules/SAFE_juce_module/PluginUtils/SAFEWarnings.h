@@ -13,7 +13,12 @@ enum WarningID
     DescriptorNotOnServer, /**< Can't load something that doesn't exist. */
     DescriptorNotInFile, /**< Can't load something that doesn't exist. */
     DescriptorBoxEmpty, /**< Can't load nothing. */
-    CannotReachServer /**< No connection to the interwebz. */
+    CannotReachServer, /**< No connection to the interwebz. */
+    TimingsSaved, /**< The process timings were written to a file. */
+    TimingsNotSaved, /**< The process timings couldn't be written. */
+    LongRecordingFailed, /**< A long recording couldn't be written to or read from disk. */
+    LongRecordingTooShort, /**< A long recording needs at least one analysis frame. */
+    AnalysisInterrupted /**< The host changed its settings while a recording was being analysed. */
 };
 
 #endif // __SAFEWARNINGS__
@@ -14,12 +14,27 @@
 
 #define ANALYSIS_FRAME_LENGTH 4096
 
+#ifndef SAFE_USE_SSE_INTRINSICS
+ #define SAFE_USE_SSE_INTRINSICS 1
+#endif
+
+#if ! JUCE_INTEL || (JUCE_MINGW && ! defined (__SSE2__))
+ #undef SAFE_USE_SSE_INTRINSICS
+ #define SAFE_USE_SSE_INTRINSICS 0
+#endif
+
+#if SAFE_USE_SSE_INTRINSICS
+ #include <emmintrin.h>
+#endif
+
 namespace juce
 {
 #include "LookAndFeel/SAFEImages.cpp"
+#include "LookAndFeel/SAFEImageCache.cpp"
 #include "LookAndFeel/SAFEColours.cpp"
 #include "LookAndFeel/SAFELookAndFeel.cpp"
 
+#include "UIComponents/CachedLayer.cpp"
 #include "UIComponents/SAFEButton.cpp"
 #include "UIComponents/SAFESlider.cpp"
 #include "UIComponents/XYSlider.cpp"
@@ -27,6 +42,7 @@ namespace juce
 #include "UIComponents/SAFEMetaDataScreen.cpp"
 #include "UIComponents/SAFEDescriptorLoadScreen.cpp"
 #include "UIComponents/SAFEInfoScreen.cpp"
+#include "UIComponents/AnimationClock.cpp"
 #include "UIComponents/LevelMeterTimer.cpp"
 #include "UIComponents/LevelMeter.cpp"
 #include "UIComponents/FunctionGraph.cpp"
@@ -37,6 +53,11 @@ namespace juce
 #include "PluginUtils/LibXtractHolder.cpp"
 #include "PluginUtils/SAFEFeatureExtractor.cpp"
 #include "PluginUtils/SAFEParameter.cpp"
+#include "PluginUtils/SAFEProcessTimer.cpp"
+#include "PluginUtils/SAFETrace.cpp"
+#include "PluginUtils/SAFECaptureFile.cpp"
+#include "PluginUtils/SAFEFeatureMonitor.cpp"
+#include "PluginUtils/SAFESemanticData.cpp"
 #include "PluginUtils/SAFEAudioProcessor.cpp"
 #include "PluginUtils/SAFEAudioProcessorEditor.cpp"
 
@@ -44,6 +65,9 @@ namespace juce
 #include "Filters/Resampler.cpp"
 #include "Filters/AllPassFilter.cpp"
 #include "Filters/QuadratureFilter.cpp"
+#include "Filters/Decimator.cpp"
 
 #include "Analysis/FundamentalTracker.cpp"
+#include "Analysis/BackgroundAnalyser.cpp"
+#include "Analysis/SpectrumAnalyser.cpp"
 }
@@ -9,6 +9,12 @@
 
 #include <complex>
 
+#if JUCE_INTEL && JUCE_MSVC
+    #include <intrin.h>
+#elif JUCE_INTEL && JUCE_GCC
+    #include <x86intrin.h>
+#endif
+
 #if JUCE_LINUX
     #include <curl/curl.h>
 #endif
@@ -17,9 +23,15 @@
 namespace juce
 {
 #include "LookAndFeel/SAFEImages.h"
+#include "LookAndFeel/SAFEImageCache.h"
 #include "LookAndFeel/SAFEColours.h"
 #include "LookAndFeel/SAFELookAndFeel.h"
 
+// FilterGraph can draw what this works out, SAFEFeatureMonitor is built on the same base
+#include "Analysis/BackgroundAnalyser.h"
+#include "Analysis/SpectrumAnalyser.h"
+
+#include "UIComponents/CachedLayer.h"
 #include "UIComponents/SAFEButton.h"
 #include "UIComponents/SAFESlider.h"
 #include "UIComponents/XYSlider.h"
@@ -27,6 +39,7 @@ namespace juce
 #include "UIComponents/SAFEMetaDataScreen.h"
 #include "UIComponents/SAFEDescriptorLoadScreen.h"
 #include "UIComponents/SAFEInfoScreen.h"
+#include "UIComponents/AnimationClock.h"
 #include "UIComponents/LevelMeterTimer.h"
 #include "UIComponents/LevelMeter.h"
 #include "UIComponents/FunctionGraph.h"
@@ -34,6 +47,9 @@ namespace juce
 #include "UIComponents/FilterInfo.h"
 #include "UIComponents/FilterGraph.h"
 
+// the analysis in SAFEAudioProcessor uses this
+#include "Filters/Decimator.h"
+
 #include "PluginUtils/SAFEWarnings.h"
 #include "PluginUtils/LibXtractHolder.h"
 
@@ -43,6 +59,11 @@ namespace juce
 
 #include "PluginUtils/SAFEFeatureExtractor.h"
 #include "PluginUtils/SAFEParameter.h"
+#include "PluginUtils/SAFEProcessTimer.h"
+#include "PluginUtils/SAFETrace.h"
+#include "PluginUtils/SAFECaptureFile.h"
+#include "PluginUtils/SAFEFeatureMonitor.h"
+#include "PluginUtils/SAFESemanticData.h"
 #include "PluginUtils/SAFEAudioProcessor.h"
 #include "PluginUtils/SAFEAudioProcessorEditor.h"
 
@@ -0,0 +1,129 @@
+//==========================================================================
+//      Constructor and Destructor
+//==========================================================================
+AnimationClock::AnimationClock()
+    : lastPollTime (0)
+{
+}
+
+AnimationClock::~AnimationClock()
+{
+    stopTimer();
+}
+
+//==========================================================================
+//      Clients
+//==========================================================================
+void AnimationClock::startAnimating (Client* client)
+{
+    jassert (MessageManager::getInstance()->isThisTheMessageThread());
+
+    clients.addIfNotAlreadyThere (client);
+    updateTimer();
+}
+
+void AnimationClock::stopAnimating (Client* client)
+{
+    clients.removeFirstMatchingValue (client);
+
+    // don't advance it if it is stopped part way through a frame
+    const int indexThisFrame = clientsThisFrame.indexOf (client);
+
+    if (indexThisFrame >= 0)
+    {
+        clientsThisFrame.set (indexThisFrame, nullptr);
+    }
+
+    updateTimer();
+}
+
+bool AnimationClock::isAnimating (Client* client) const
+{
+    return clients.contains (client);
+}
+
+//==========================================================================
+//      Pollers
+//==========================================================================
+void AnimationClock::startPolling (Poller* poller)
+{
+    jassert (MessageManager::getInstance()->isThisTheMessageThread());
+
+    pollers.addIfNotAlreadyThere (poller);
+    updateTimer();
+}
+
+void AnimationClock::stopPolling (Poller* poller)
+{
+    pollers.removeFirstMatchingValue (poller);
+
+    // don't poll it if it is stopped part way through a tick
+    const int indexThisTick = pollersThisTick.indexOf (poller);
+
+    if (indexThisTick >= 0)
+    {
+        pollersThisTick.set (indexThisTick, nullptr);
+    }
+
+    updateTimer();
+}
+
+//==========================================================================
+//      Timer Callback
+//==========================================================================
+void AnimationClock::timerCallback()
+{
+    const double timeNow = Time::getMillisecondCounterHiRes();
+
+    clientsThisFrame.clearQuick();
+    clientsThisFrame.addArray (clients);
+
+    for (int i = 0; i < clientsThisFrame.size(); ++i)
+    {
+        Client* client = clientsThisFrame [i];
+
+        if (client != nullptr && ! client->advanceAnimation (timeNow))
+        {
+            clients.removeFirstMatchingValue (client);
+        }
+    }
+
+    clientsThisFrame.clearQuick();
+
+    // allow a bit of slack so polls don't slip a whole frame late
+    if (pollers.size() > 0 && timeNow - lastPollTime >= pollInterval - frameInterval / 2)
+    {
+        lastPollTime = timeNow;
+
+        pollersThisTick.clearQuick();
+        pollersThisTick.addArray (pollers);
+
+        for (int i = 0; i < pollersThisTick.size(); ++i)
+        {
+            if (Poller* poller = pollersThisTick [i])
+            {
+                poller->pollForChanges();
+            }
+        }
+
+        pollersThisTick.clearQuick();
+    }
+
+    updateTimer();
+}
+
+void AnimationClock::updateTimer()
+{
+    const int interval = clients.size() > 0 ? frameInterval
+                       : pollers.size() > 0 ? pollInterval
+                       : 0;
+
+    if (interval == 0)
+    {
+        stopTimer();
+    }
+    else if (getTimerInterval() != interval)
+    {
+        startTimer (interval);
+    }
+}
@@ -0,0 +1,137 @@
+#ifndef __ANIMATIONCLOCK__
+#define __ANIMATIONCLOCK__
+
+/**
+ *  A single frame clock shared by everything in the process which animates.
+ *
+ *  Meters and editors hold one of these through a SharedResourcePointer, so however
+ *  many plug-ins are open there is only one timer on the message thread. On each
+ *  frame every client which is animating is advanced in one pass, so the repaints
+ *  they ask for are all dealt with together in the next paint.
+ *
+ *  Things which only need to check for changes a few times a second can be polled
+ *  by the clock instead. Pollers are called every pollInterval milliseconds, and
+ *  while nothing is animating the clock ticks at that slower rate. The clock stops
+ *  ticking as soon as there is nothing to animate or poll.
+ */
+class AnimationClock : private Timer
+{
+public:
+    //==========================================================================
+    //      Constructor and Destructor
+    //==========================================================================
+    /** Create a new clock, use a SharedResourcePointer rather than making your own. */
+    AnimationClock();
+
+    /** Destructor */
+    ~AnimationClock();
+
+    /** The time between frames in milliseconds. */
+    static const int frameInterval = 16;
+
+    /** The time between polls in milliseconds, every third frame. */
+    static const int pollInterval = 3 * frameInterval;
+
+    //==========================================================================
+    //      Clients
+    //==========================================================================
+    /**
+     *  Something which is advanced by an AnimationClock.
+     */
+    class Client
+    {
+    public:
+        /** Destructor */
+        virtual ~Client() {}
+
+        /** Move the animation on to a new frame.
+         *
+         *  This is called on the message thread. Return false once there is
+         *  nothing left to animate and it won't be called again until
+         *  startAnimating() is.
+         *
+         *  @param timeNow  the time of the frame from Time::getMillisecondCounterHiRes()
+         */
+        virtual bool advanceAnimation (double timeNow) = 0;
+    };
+
+    /** Advance a client on every frame until it says it has finished.
+     *
+     *  This starts the clock if it has stopped. Calling it for a client which is
+     *  already animating does nothing.
+     *
+     *  @param client  the client to animate
+     */
+    void startAnimating (Client* client);
+
+    /** Stop advancing a client.
+     *
+     *  This must be called before a client is deleted.
+     *
+     *  @param client  the client to stop animating
+     */
+    void stopAnimating (Client* client);
+
+    /** Returns true if a client is being advanced on every frame. */
+    bool isAnimating (Client* client) const;
+
+    //==========================================================================
+    //      Pollers
+    //==========================================================================
+    /**
+     *  Something which is polled by an AnimationClock.
+     */
+    class Poller
+    {
+    public:
+        /** Destructor */
+        virtual ~Poller() {}
+
+        /** Check for anything which has changed.
+         *
+         *  This is called on the message thread every pollInterval milliseconds
+         *  until stopPolling() is called. It can start clients animating.
+         */
+        virtual void pollForChanges() = 0;
+    };
+
+    /** Poll something until stopPolling() is called.
+     *
+     *  This starts the clock if it has stopped. Calling it for something which is
+     *  already being polled does nothing.
+     *
+     *  @param poller  the thing to poll
+     */
+    void startPolling (Poller* poller);
+
+    /** Stop polling something.
+     *
+     *  This must be called before a poller is deleted.
+     *
+     *  @param poller  the thing to stop polling
+     */
+    void stopPolling (Poller* poller);
+
+private:
+    //==========================================================================
+    //      Timer Callback
+    //==========================================================================
+    void timerCallback() override;
+
+    /** Tick at the frame rate while anything is animating, at the poll rate while
+     *  anything is being polled, and not at all otherwise. */
+    void updateTimer();
+
+    Array <Client*> clients;
+
+    // a copy of the clients taken at the start of each frame, so they can
+    // start and stop each other while they are advanced
+    Array <Client*> clientsThisFrame;
+
+    Array <Poller*> pollers, pollersThisTick;
+    double lastPollTime;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnimationClock)
+};
+
+#endif // __ANIMATIONCLOCK__
@@ -0,0 +1,77 @@
+//==========================================================================
+//      Constructor and Destructor
+//==========================================================================
+CachedLayer::CachedLayer()
+    : scale (1),
+      layerWidth (0),
+      layerHeight (0),
+      valid (false)
+{
+}
+
+CachedLayer::~CachedLayer()
+{
+}
+
+//==========================================================================
+//      Painting the Layer
+//==========================================================================
+void CachedLayer::invalidate()
+{
+    valid = false;
+}
+
+bool CachedLayer::needsPainting (Graphics& g, int width, int height)
+{
+    const float newScale = g.getInternalContext().getPhysicalPixelScaleFactor();
+
+    if (valid && width == layerWidth && height == layerHeight && std::abs (newScale - scale) < 0.01f)
+    {
+        return false;
+    }
+
+    scale = newScale;
+    layerWidth = width;
+    layerHeight = height;
+
+    const int imageWidth = jmax (1, (int) ceil (width * scale));
+    const int imageHeight = jmax (1, (int) ceil (height * scale));
+
+    if (image.getWidth() == imageWidth && image.getHeight() == imageHeight)
+    {
+        image.clear (image.getBounds());
+    }
+    else
+    {
+        image = Image (Image::ARGB, imageWidth, imageHeight, true);
+    }
+
+    valid = true;
+
+    return true;
+}
+
+Image& CachedLayer::getImage()
+{
+    return image;
+}
+
+AffineTransform CachedLayer::getTransform() const
+{
+    return AffineTransform::scale (scale);
+}
+
+//==========================================================================
+//      Drawing the Layer
+//==========================================================================
+void CachedLayer::draw (Graphics& g)
+{
+    if (scale == 1.0f)
+    {
+        g.drawImageAt (image, 0, 0);
+    }
+    else
+    {
+        g.drawImageTransformed (image, AffineTransform::scale (1.0f / scale));
+    }
+}
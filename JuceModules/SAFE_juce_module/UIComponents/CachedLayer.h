@@ -0,0 +1,77 @@
+#ifndef __CACHEDLAYER__
+#define __CACHEDLAYER__
+
+/**
+ *  An image of part of a component's painting which rarely changes.
+ *
+ *  Graphs paint their backgrounds, grids and labels into one of these so a repaint
+ *  only has to copy the layer and draw the traces which have moved on top. A layer is
+ *  painted again when it is invalidated, when the component changes size or when
+ *  it is drawn at a different scale, so it always matches the resolution of the
+ *  screen it is on.
+ *
+ *  @code
+ *  if (backgroundLayer.needsPainting (g, getWidth(), getHeight()))
+ *  {
+ *      Graphics layerGraphics (backgroundLayer.getImage());
+ *      layerGraphics.addTransform (backgroundLayer.getTransform());
+ *      paintGrid (layerGraphics);
+ *  }
+ *
+ *  backgroundLayer.draw (g);
+ *  @endcode
+ */
+class CachedLayer
+{
+public:
+    //==========================================================================
+    //      Constructor and Destructor
+    //==========================================================================
+    /** Create a new layer, it will be painted the first time it is drawn. */
+    CachedLayer();
+
+    /** Destructor */
+    ~CachedLayer();
+
+    //==========================================================================
+    //      Painting the Layer
+    //==========================================================================
+    /** Mark the layer as needing to be painted again. */
+    void invalidate();
+
+    /** Check whether the layer has to be painted before it is drawn.
+     *
+     *  If this returns true the image has been cleared, ready to be painted into.
+     *
+     *  @param g       the graphics context the layer is going to be drawn onto
+     *  @param width   the width of the component
+     *  @param height  the height of the component
+     */
+    bool needsPainting (Graphics& g, int width, int height);
+
+    /** Returns the image to paint the layer into. */
+    Image& getImage();
+
+    /** Returns the transform to paint the layer with, so it can be painted using
+     *  the component's coordinates. */
+    AffineTransform getTransform() const;
+
+    //==========================================================================
+    //      Drawing the Layer
+    //==========================================================================
+    /** Draw the layer onto the component.
+     *
+     *  @param g  the component's graphics context
+     */
+    void draw (Graphics& g);
+
+private:
+    Image image;
+    float scale;
+    int layerWidth, layerHeight;
+    bool valid;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CachedLayer)
+};
+
+#endif // __CACHEDLAYER__
@@ -74,9 +74,9 @@ DynamicProcessorGraph::~DynamicProcessorGraph()
 //==========================================================================
 //      Paint
 //==========================================================================
-void DynamicProcessorGraph::paint (Graphics& g)
+void DynamicProcessorGraph::paintGrid (Graphics& g)
 {
-    FunctionGraph::paint (g);
+    FunctionGraph::paintGrid (g);
 
     // get size info
     float width = (float) getWidth();
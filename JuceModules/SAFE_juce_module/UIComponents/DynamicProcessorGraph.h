@@ -20,9 +20,6 @@ public:
     //==========================================================================
     //      Paint
     //==========================================================================
-    /** Draw the component. */
-    void paint (Graphics&);
-
     /** Draw the component's border. */
     void paintOverChildren (Graphics&);
 
@@ -84,6 +81,9 @@ private:
         Dot dot;
     };
 
+    /** Draw the grid and the line where the output level equals the input level. */
+    void paintGrid (Graphics& g);
+
     DynamicsMeter meterArea;
 
     int xPos, yPos;
@@ -307,7 +307,17 @@ FilterGraph::FilterGraph (int numFiltersInit)
       traceColour (Colour (0xaa00ff00)),
       traceType (Magnitude),
       fs (44100),
-      numFilters (numFiltersInit)
+      numFilters (numFiltersInit),
+      responseFrequenciesValid (false),
+      numResponsePoints (0),
+      unitDelaySampleRate (0),
+      spectrumAnalyser (nullptr),
+      spectrumFrameRate (30),
+      spectrumMinDecibels (-90),
+      spectrumMaxDecibels (0),
+      lastSpectrumUpdate (0),
+      numSpectrumColumns (0),
+      spectrumColumnsSampleRate (0)
 {    
     setSize (500, 300);
 
@@ -323,6 +333,11 @@ FilterGraph::FilterGraph (int numFiltersInit)
 FilterGraph::~FilterGraph()
 {
     listenerArray.clear (false);
+
+    if (spectrumAnalyser != nullptr)
+    {
+        spectrumAnalyser->setActive (false);
+    }
 }
 
 //==========================================================================
@@ -376,41 +391,71 @@ void FilterGraph::paint (Graphics& g)
     float width = (float) getWidth();
     float height = (float) getHeight();
     
-    // paint the display background
-    g.setGradientFill (ColourGradient (Colour (0xff232338), width / 2, height / 2, Colour (0xff21222a), 2.5f, height / 2, true));
-    g.fillRoundedRectangle (2.5f, 2.5f, width - 5, height - 5, 10.000f);
+    // paint the display background, grid lines and labels
+    if (backgroundLayer.needsPainting (g, getWidth(), getHeight()))
+    {
+        Graphics layerGraphics (backgroundLayer.getImage());
+        layerGraphics.addTransform (backgroundLayer.getTransform());
+
+        layerGraphics.setGradientFill (ColourGradient (Colour (0xff232338), width / 2, height / 2, Colour (0xff21222a), 2.5f, height / 2, true));
+        layerGraphics.fillRoundedRectangle (2.5f, 2.5f, width - 5, height - 5, 10.000f);
+
+        paintGrid (layerGraphics);
+    }
+
+    backgroundLayer.draw (g);
+
+    // paint the spectrum behind the traces
+    if (spectrumAnalyser != nullptr && lastSpectrumUpdate > 0)
+    {
+        Graphics::ScopedSaveState saveState (g);
+
+        Path displayArea;
+        displayArea.addRoundedRectangle (2.5f, 2.5f, width - 5, height - 5, 10.000f);
+        g.reduceClipRegion (displayArea);
+
+        g.setColour (Colour (0x28ffffff));
+        g.fillPath (spectrumPaths [SpectrumAnalyser::unprocessedSignal]);
+
+        g.setColour (Colour (0x40ffffff));
+        g.strokePath (peakPath, PathStrokeType (1.0f));
+
+        g.setColour (Colour (0x90ffffff));
+        g.strokePath (spectrumPaths [SpectrumAnalyser::processedSignal], PathStrokeType (1.5f));
+    }
+
+    updateResponses();
 
     // paint single filter
     if (showSingleFilter)
     {
         singleFilterPath.clear();
 
+        const double* magnitudes = filterMagnitudes + filterToShow * numResponsePoints;
+        const double* phases = filterPhases + filterToShow * numResponsePoints;
+
         if (traceType == Magnitude)
         {
-            float traceMagnitude = (float) filterArray [filterToShow]->getResponse (lowFreq).magnitudeValue;
-            traceMagnitude = Decibels::gainToDecibels (traceMagnitude);
+            float traceMagnitude = Decibels::gainToDecibels ((float) magnitudes [0]);
             singleFilterPath.startNewSubPath (2.5f, gainToY (traceMagnitude));
 
-            for (float xPos = 3.5; xPos < (width - 2.5); xPos += 1)
+            for (int point = 1; point < numResponsePoints; ++point)
             {
-                float freq = xToFreq (xPos);
-                traceMagnitude = (float) filterArray [filterToShow]->getResponse (freq).magnitudeValue;
-                traceMagnitude = Decibels::gainToDecibels (traceMagnitude);
-                singleFilterPath.lineTo (xPos, gainToY (traceMagnitude));
+                traceMagnitude = Decibels::gainToDecibels ((float) magnitudes [point]);
+                singleFilterPath.lineTo (2.5f + point, gainToY (traceMagnitude));
             }
         }
 
         if (traceType == Phase)
         {
-            float tracePhase = (float) filterArray [filterToShow]->getResponse (lowFreq).phaseValue;
+            float tracePhase = (float) phases [0];
             singleFilterPath.startNewSubPath (2.5f, phaseToY (tracePhase / float_Pi));
             float previousPhase = tracePhase;
             float unwrapSummand = 0;
 
-            for (float xPos = 3.5; xPos < (width - 2.5); xPos += 1)
+            for (int point = 1; point < numResponsePoints; ++point)
             {
-                float freq = xToFreq (xPos);
-                tracePhase = (float) filterArray [filterToShow]->getResponse (freq).phaseValue;
+                tracePhase = (float) phases [point];
 
                 if (fabs (tracePhase - previousPhase) > 5)
                 {
@@ -419,7 +464,7 @@ void FilterGraph::paint (Graphics& g)
 
                 previousPhase = tracePhase;
 
-                singleFilterPath.lineTo (xPos, phaseToY ((tracePhase + unwrapSummand) / float_Pi));
+                singleFilterPath.lineTo (2.5f + point, phaseToY ((tracePhase + unwrapSummand) / float_Pi));
             }
         }
 
@@ -432,28 +477,24 @@ void FilterGraph::paint (Graphics& g)
     
     if (traceType == Magnitude)
     {
-        float traceMagnitude = getMagnitudeResponse (lowFreq);
-        tracePath.startNewSubPath (2.5f, gainToY (traceMagnitude));
+        tracePath.startNewSubPath (2.5f, gainToY (combinedMagnitudes [0]));
 
-        for (float xPos = 3.5; xPos < (width - 2.5); xPos += 1)
+        for (int point = 1; point < numResponsePoints; ++point)
         {
-            float freq = xToFreq (xPos);
-            traceMagnitude = getMagnitudeResponse (freq);
-            tracePath.lineTo (xPos, gainToY (traceMagnitude));
+            tracePath.lineTo (2.5f + point, gainToY (combinedMagnitudes [point]));
         }
     }
     
     if (traceType == Phase)
     {
-        float tracePhase = getPhaseResponse (lowFreq);
+        float tracePhase = combinedPhases [0];
         tracePath.startNewSubPath (2.5f, phaseToY (tracePhase / float_Pi));
         float previousPhase = tracePhase;
         float unwrapSummand = 0;
 
-        for (float xPos = 3.5; xPos < (width - 2.5); xPos += 1)
+        for (int point = 1; point < numResponsePoints; ++point)
         {
-            float freq = xToFreq (xPos);
-            tracePhase = getPhaseResponse (freq);
+            tracePhase = combinedPhases [point];
 
             if (fabs (tracePhase - previousPhase) > 5)
             {
@@ -462,14 +503,27 @@ void FilterGraph::paint (Graphics& g)
 
             previousPhase = tracePhase;
 
-            tracePath.lineTo (xPos, phaseToY ((tracePhase + unwrapSummand) / float_Pi));
+            tracePath.lineTo (2.5f + point, phaseToY ((tracePhase + unwrapSummand) / float_Pi));
         }
     }
     
     g.setColour (traceColour);
     g.strokePath (tracePath, PathStrokeType (3.0f));
     
-    // paint the display grid lines
+    if (showSingleFilter && ! externalShowSingleFilter)
+    {
+        g.setColour (Colours::white);
+        g.setFont (Font ("Arial Rounded MT", 12.0f, Font::plain));
+        g.drawText (String ("Scroll over a filter to control its Q"), 590, (int) gainToY (maxDecibels) - 13, 180, 12, Justification::left, false);
+    }
+}
+
+void FilterGraph::paintGrid (Graphics& g)
+{
+    // get size info
+    float width = (float) getWidth();
+    float height = (float) getHeight();
+
     g.setColour (Colour (0xaaffffff));
     String axisLabel;
     if (traceType == Magnitude)  axisLabel = String (maxDecibels, 1) + "dB";
@@ -483,12 +537,6 @@ void FilterGraph::paint (Graphics& g)
     g.drawText (axisLabel, 6, (int) gainToY (maxDecibels) - 13, 45, 12, Justification::centred, false);
     g.drawText (String ("-") + axisLabel, 6, (int) gainToY (- maxDecibels) + 1, 45, 12, Justification::centred, false);
     
-    if(showSingleFilter && ! externalShowSingleFilter)
-    {
-        g.setColour (Colours::white);
-        g.drawText (String ("Scroll over a filter to control its Q"), 590, (int) gainToY (maxDecibels) - 13, 180, 12, Justification::left, false);
-    }
-    
     gridPath.clear();
     for (int lineNum = 1; lineNum < numHorizontalLines + 1; ++lineNum)
     {
@@ -508,11 +556,6 @@ void FilterGraph::paint (Graphics& g)
     g.excludeClipRegion (Rectangle <int> (6, (int) gainToY (maxDecibels) - 13, 45, 12));
     g.excludeClipRegion (Rectangle <int> (6, (int) gainToY (- maxDecibels) + 1, 45, 12));
     
-    if(showSingleFilter && ! externalShowSingleFilter)
-    {
-        g.excludeClipRegion (Rectangle <int> (590, (int) gainToY (maxDecibels) - 13, 180, 12));
-    }
-    
     g.setColour (Colour (0x60ffffff));   
     g.strokePath (gridPath, PathStrokeType (1.0f));
 }
@@ -530,6 +573,9 @@ void FilterGraph::paintOverChildren (Graphics& g)
 
 void FilterGraph::resized()
 {
+    // the responses and spectrum columns are worked out again for the new width
+    responseFrequenciesValid = false;
+    spectrumColumnsSampleRate = 0;
 }
 
 //==========================================================================
@@ -538,6 +584,7 @@ void FilterGraph::resized()
 void FilterGraph::setNumHorizontalLines (int newValue)
 {
     numHorizontalLines = newValue;
+    backgroundLayer.invalidate();
     repaint();
 }
 
@@ -545,18 +592,23 @@ void FilterGraph::setFreqRange (float newLowFreq, float newHighFreq)
 {
     lowFreq = fabs (newLowFreq + 0.1f);
     highFreq = fabs (newHighFreq);
+    responseFrequenciesValid = false;
+    spectrumColumnsSampleRate = 0;
+    backgroundLayer.invalidate();
     repaint();
 }
 
 void FilterGraph::setMaxDecibels (float newMaxDecibels)
 {
     maxDecibels = newMaxDecibels;
+    backgroundLayer.invalidate();
     repaint();
 }
 
 void FilterGraph::setMaxPhase (float newMaxPhase)
 {
     maxPhase = newMaxPhase;
+    backgroundLayer.invalidate();
     repaint();
 }
 
@@ -569,6 +621,7 @@ void FilterGraph::setTraceColour (Colour newColour)
 void FilterGraph::setTraceType (TraceType newTraceType)
 {
     traceType = newTraceType;
+    backgroundLayer.invalidate();
     repaint();
 }
 
@@ -578,6 +631,7 @@ void FilterGraph::setTraceType (TraceType newTraceType)
 void FilterGraph::setFilterGain (int filterNum, double gain)
 {
     filterArray [filterNum]->setGain (gain);
+    changedFilters.setBit (filterNum);
     repaint();
 }
 
@@ -585,6 +639,7 @@ void FilterGraph::setFilter (int filterNum, double sampleRate, IIRCoefficients n
 {
     filterArray [filterNum]->setSampleRate (sampleRate);
     filterArray [filterNum]->setCoefficients (newCoefficients);
+    changedFilters.setBit (filterNum);
     
     repaint();
 }
@@ -593,6 +648,7 @@ void FilterGraph::setFilter (int filterNum, double sampleRate, Array <double> nu
 {
     filterArray [filterNum]->setSampleRate (sampleRate);
     filterArray [filterNum]->setCoefficients (numCoeffs, denCoeffs);
+    changedFilters.setBit (filterNum);
     
     repaint();
 }
@@ -645,6 +701,348 @@ void FilterGraph::setControlColour (int filterNum, Colour newColour)
     control->setColour (newColour);
 }
 
+//==========================================================================
+//      Cached Responses
+//==========================================================================
+void FilterGraph::updateResponseFrequencies()
+{
+    float width = (float) getWidth();
+
+    // the same points the traces have always been drawn through
+    numResponsePoints = jmax (1, (int) ceil (width - 5.0f));
+    responseFrequencies.allocate (numResponsePoints, false);
+
+    for (int point = 0; point < numResponsePoints; ++point)
+    {
+        responseFrequencies [point] = point == 0 ? lowFreq : xToFreq (2.5f + point);
+    }
+
+    unitDelayReal.allocate (numResponsePoints, false);
+    unitDelayImag.allocate (numResponsePoints, false);
+    unitDelaySampleRate = 0;
+
+    filterMagnitudes.allocate (jmax (1, numFilters * numResponsePoints), true);
+    filterPhases.allocate (jmax (1, numFilters * numResponsePoints), true);
+    combinedMagnitudes.allocate (numResponsePoints, true);
+    combinedPhases.allocate (numResponsePoints, true);
+
+    changedFilters.setRange (0, numFilters, true);
+    responseFrequenciesValid = true;
+}
+
+void FilterGraph::updateResponses()
+{
+    if (! responseFrequenciesValid)
+    {
+        updateResponseFrequencies();
+    }
+
+    if (changedFilters.isZero())
+    {
+        return;
+    }
+
+    for (int n = 0; n < numFilters; ++n)
+    {
+        if (changedFilters [n])
+        {
+            const FilterInfo* filter = filterArray [n];
+
+            // the filters normally share a sample rate so this is rarely worked out again
+            if (filter->getSampleRate() != unitDelaySampleRate)
+            {
+                unitDelaySampleRate = filter->getSampleRate();
+                FilterInfo::makeUnitDelayTable (responseFrequencies, unitDelaySampleRate, unitDelayReal, unitDelayImag, numResponsePoints);
+            }
+
+            filter->getResponses (unitDelayReal, unitDelayImag, filterMagnitudes + n * numResponsePoints, filterPhases + n * numResponsePoints, numResponsePoints);
+        }
+    }
+
+    changedFilters.clear();
+
+    for (int point = 0; point < numResponsePoints; ++point)
+    {
+        double magnitude = 1;
+        double phase = 0;
+
+        for (int n = 0; n < numFilters; ++n)
+        {
+            magnitude *= filterMagnitudes [n * numResponsePoints + point];
+            phase += filterPhases [n * numResponsePoints + point];
+        }
+
+        combinedMagnitudes [point] = numFilters > 0 ? Decibels::gainToDecibels ((float) magnitude) : 0;
+        combinedPhases [point] = (float) phase;
+    }
+}
+
+//==========================================================================
+//      Spectrum Overlay
+//==========================================================================
+void FilterGraph::setSpectrumAnalyser (SpectrumAnalyser* newAnalyser)
+{
+    if (spectrumAnalyser != nullptr)
+    {
+        spectrumAnalyser->setActive (false);
+    }
+
+    spectrumAnalyser = newAnalyser;
+    lastSpectrumUpdate = 0;
+    spectrumColumnsSampleRate = 0;
+
+    if (spectrumAnalyser != nullptr)
+    {
+        spectrumLevels.allocate (SpectrumAnalyser::numBins, true);
+        spectrumAnalyser->setUpdateRate (spectrumFrameRate);
+    }
+
+    updateSpectrumState();
+    repaint();
+}
+
+void FilterGraph::setSpectrumFrameRate (int newFrameRate)
+{
+    spectrumFrameRate = jlimit (5, 30, newFrameRate);
+
+    if (spectrumAnalyser != nullptr)
+    {
+        spectrumAnalyser->setUpdateRate (spectrumFrameRate);
+    }
+
+    updateSpectrumState();
+}
+
+void FilterGraph::setSpectrumRange (float newMinDecibels, float newMaxDecibels)
+{
+    spectrumMinDecibels = newMinDecibels;
+    spectrumMaxDecibels = newMaxDecibels;
+    spectrumColumnsSampleRate = 0;
+    repaint();
+}
+
+void FilterGraph::visibilityChanged()
+{
+    updateSpectrumState();
+}
+
+void FilterGraph::parentHierarchyChanged()
+{
+    updateSpectrumState();
+}
+
+void FilterGraph::timerCallback()
+{
+    updateSpectrumState();
+
+    if (spectrumAnalyser == nullptr || ! spectrumAnalyser->isActive())
+    {
+        return;
+    }
+
+    const int updateCount = spectrumAnalyser->getUpdateCount();
+
+    // only redraw when there is something new to draw
+    if (updateCount != lastSpectrumUpdate && updateCount > 0)
+    {
+        lastSpectrumUpdate = updateCount;
+        updateSpectrumPaths();
+        repaint();
+    }
+}
+
+void FilterGraph::updateSpectrumState()
+{
+    if (spectrumAnalyser == nullptr)
+    {
+        stopTimer();
+        return;
+    }
+
+    // there is no callback when the window is minimised, so while the graph is
+    // hidden the timer carries on slowly to notice when it comes back
+    const bool showing = isShowing();
+    spectrumAnalyser->setActive (showing);
+
+    const int interval = showing ? 1000 / spectrumFrameRate : 250;
+
+    if (getTimerInterval() != interval)
+    {
+        startTimer (interval);
+    }
+}
+
+void FilterGraph::updateSpectrumColumns()
+{
+    float width = (float) getWidth();
+    const double sampleRate = spectrumAnalyser->getSampleRate();
+
+    // one column for each point on the response trace
+    numSpectrumColumns = jmax (0, (int) (width - 5.0f) + 1);
+    spectrumColumnsSampleRate = sampleRate;
+
+    columnBinEdges.allocate (numSpectrumColumns + 1, true);
+
+    for (int column = 0; column <= numSpectrumColumns; ++column)
+    {
+        const float freq = xToFreq (2.0f + column);
+        columnBinEdges [column] = (float) (freq * SpectrumAnalyser::fftSize / sampleRate);
+    }
+
+    const int numLevels = SpectrumAnalyser::numSignals * numSpectrumColumns;
+
+    smoothedLevels.allocate (jmax (1, numLevels), true);
+    peakLevels.allocate (jmax (1, numSpectrumColumns), true);
+    peakHoldFrames.allocate (jmax (1, numSpectrumColumns), true);
+
+    for (int i = 0; i < numLevels; ++i)
+    {
+        smoothedLevels [i] = spectrumMinDecibels;
+    }
+
+    for (int column = 0; column < numSpectrumColumns; ++column)
+    {
+        peakLevels [column] = spectrumMinDecibels;
+    }
+}
+
+void FilterGraph::updateSpectrumPaths()
+{
+    if (spectrumAnalyser->getSampleRate() != spectrumColumnsSampleRate)
+    {
+        updateSpectrumColumns();
+    }
+
+    float height = (float) getHeight();
+    const int lastBin = SpectrumAnalyser::numBins - 1;
+
+    // levels rise straight away and fall back over a quarter of a second, peaks
+    // are held for a second and then fall at 20dB a second
+    const float releaseCoefficient = 1.0f - exp (-4.0f / spectrumFrameRate);
+    const int peakHoldLength = spectrumFrameRate;
+    const float peakFallPerFrame = 20.0f / spectrumFrameRate;
+
+    for (int signal = 0; signal < SpectrumAnalyser::numSignals; ++signal)
+    {
+        Path& path = spectrumPaths [signal];
+        path.clear();
+
+        if (! spectrumAnalyser->getLatestSpectrum ((SpectrumAnalyser::Signal) signal, spectrumLevels))
+        {
+            continue;
+        }
+
+        float* smoothed = smoothedLevels + signal * numSpectrumColumns;
+
+        for (int column = 0; column < numSpectrumColumns; ++column)
+        {
+            const float lowBin = columnBinEdges [column];
+            const float highBin = columnBinEdges [column + 1];
+            float level = spectrumMinDecibels;
+
+            if (highBin - lowBin < 1.0f)
+            {
+                // narrower than a bin, so interpolate between the nearest two
+                const float centreBin = jmin ((lowBin + highBin) / 2, (float) lastBin);
+                const int bin = jmin ((int) centreBin, lastBin - 1);
+                const float proportion = centreBin - bin;
+
+                level = spectrumLevels [bin] + proportion * (spectrumLevels [bin + 1] - spectrumLevels [bin]);
+            }
+            else
+            {
+                // wider than a bin, so take the loudest one in it
+                const int firstBin = jmin ((int) ceil (lowBin), lastBin);
+                const int endBin = jmin ((int) floor (highBin), lastBin);
+
+                level = spectrumLevels [firstBin];
+
+                for (int bin = firstBin + 1; bin <= endBin; ++bin)
+                {
+                    level = jmax (level, spectrumLevels [bin]);
+                }
+            }
+
+            if (level >= smoothed [column])
+            {
+                smoothed [column] = level;
+            }
+            else
+            {
+                smoothed [column] += (level - smoothed [column]) * releaseCoefficient;
+            }
+
+            if (signal == SpectrumAnalyser::processedSignal)
+            {
+                if (smoothed [column] >= peakLevels [column])
+                {
+                    peakLevels [column] = smoothed [column];
+                    peakHoldFrames [column] = peakHoldLength;
+                }
+                else if (peakHoldFrames [column] > 0)
+                {
+                    --peakHoldFrames [column];
+                }
+                else
+                {
+                    peakLevels [column] -= peakFallPerFrame;
+                }
+            }
+
+            const float xPos = 2.5f + column;
+            const float yPos = spectrumLevelToY (smoothed [column]);
+
+            if (column == 0)
+            {
+                path.startNewSubPath (xPos, yPos);
+            }
+            else
+            {
+                path.lineTo (xPos, yPos);
+            }
+        }
+    }
+
+    // close the input spectrum along the bottom so it can be filled
+    Path& unprocessedPath = spectrumPaths [SpectrumAnalyser::unprocessedSignal];
+
+    if (! unprocessedPath.isEmpty())
+    {
+        unprocessedPath.lineTo (2.5f + numSpectrumColumns - 1, height);
+        unprocessedPath.lineTo (2.5f, height);
+        unprocessedPath.closeSubPath();
+    }
+
+    peakPath.clear();
+
+    if (! spectrumPaths [SpectrumAnalyser::processedSignal].isEmpty())
+    {
+        for (int column = 0; column < numSpectrumColumns; ++column)
+        {
+            const float xPos = 2.5f + column;
+            const float yPos = spectrumLevelToY (peakLevels [column]);
+
+            if (column == 0)
+            {
+                peakPath.startNewSubPath (xPos, yPos);
+            }
+            else
+            {
+                peakPath.lineTo (xPos, yPos);
+            }
+        }
+    }
+}
+
+float FilterGraph::spectrumLevelToY (float level)
+{
+    float height = (float) getHeight();
+    const float proportion = (level - spectrumMinDecibels) / (spectrumMaxDecibels - spectrumMinDecibels);
+
+    // quiet levels sit just below the bottom of the display
+    return jlimit (2.5f, height + 1.0f, (height - 2.5f) - proportion * (height - 5.0f));
+}
+
 //==========================================================================
 //      Utility Functions
 //==========================================================================
@@ -3,9 +3,13 @@
 
 /**
  *  A component to control an EQ using dots on a graph of the frequency response.
+ *
+ *  The graph can also draw the spectrum of the audio before and after the EQ behind
+ *  the response, see setSpectrumAnalyser().
  */
 class FilterGraph : public Component,
-                    public SettableTooltipClient
+                    public SettableTooltipClient,
+                    private Timer
 {
 private:
     //==========================================================================
@@ -284,6 +288,41 @@ public:
      */
     void setControlColour (int filterNum, Colour newColour);
 
+    //==========================================================================
+    //      Spectrum Overlay
+    //==========================================================================
+    /** Draw the spectrum of the audio before and after processing behind the response.
+     *
+     *  The analyser's levels are binned into one value for each pixel across the graph,
+     *  using the same frequency scale as the response. The graph switches the analyser
+     *  on while it is showing and off while it is hidden, so nothing is analysed that
+     *  can't be seen.
+     *
+     *  @param newAnalyser  the analyser to draw, or nullptr to remove the overlay
+     */
+    void setSpectrumAnalyser (SpectrumAnalyser* newAnalyser);
+
+    /** Set how many times a second the overlay is redrawn.
+     *
+     *  The analyser is updated at the same rate.
+     *
+     *  @param newFrameRate  the number of frames per second, this is limited to 5 - 30
+     */
+    void setSpectrumFrameRate (int newFrameRate);
+
+    /** Set the range of levels the overlay covers.
+     *
+     *  @param newMinDecibels  the level at the bottom of the graph
+     *  @param newMaxDecibels  the level at the top of the graph
+     */
+    void setSpectrumRange (float newMinDecibels, float newMaxDecibels);
+
+    /** Switches the analyser on or off when the graph is shown or hidden. */
+    void visibilityChanged();
+
+    /** Switches the analyser on or off when the graph is added to or removed from a window. */
+    void parentHierarchyChanged();
+
     //==========================================================================
     //      Utility Functions
     //==========================================================================
@@ -393,6 +432,71 @@ private:
     
     Path gridPath, tracePath, singleFilterPath;
 
+    /** Draw the grid lines and axis labels. */
+    void paintGrid (Graphics& g);
+
+    // the parts of the graph which only change when its size or ranges do
+    CachedLayer backgroundLayer;
+
+    //==========================================================================
+    //      Cached Responses
+    //==========================================================================
+    /** Work out the frequency at each point on the traces. */
+    void updateResponseFrequencies();
+
+    /** Work out the response of any filter which has changed since the last paint. */
+    void updateResponses();
+
+    // one point for each pixel along the traces
+    bool responseFrequenciesValid;
+    int numResponsePoints;
+    HeapBlock <double> responseFrequencies;
+
+    // e^(-jw) at each point
+    double unitDelaySampleRate;
+    HeapBlock <double> unitDelayReal, unitDelayImag;
+
+    // the response of each filter at each point, one filter after another
+    HeapBlock <double> filterMagnitudes, filterPhases;
+    BigInteger changedFilters;
+
+    // the combined response at each point, in decibels and radians
+    HeapBlock <float> combinedMagnitudes, combinedPhases;
+
+    //==========================================================================
+    //      Spectrum Overlay
+    //==========================================================================
+    void timerCallback();
+
+    /** Switch the analyser on if the graph is showing and off if it isn't. */
+    void updateSpectrumState();
+
+    /** Work out which FFT bins fall in each pixel column of the graph. */
+    void updateSpectrumColumns();
+
+    /** Read the latest spectra and turn them into paths. */
+    void updateSpectrumPaths();
+
+    float spectrumLevelToY (float level);
+
+    SpectrumAnalyser* spectrumAnalyser;
+    int spectrumFrameRate;
+    float spectrumMinDecibels, spectrumMaxDecibels;
+    int lastSpectrumUpdate;
+
+    HeapBlock <float> spectrumLevels;
+
+    // the fractional FFT bin at the left edge of each column, and one past the last
+    HeapBlock <float> columnBinEdges;
+    int numSpectrumColumns;
+    double spectrumColumnsSampleRate;
+
+    // the smoothed level of each signal in each column, and the held peaks of the output
+    HeapBlock <float> smoothedLevels, peakLevels;
+    HeapBlock <int> peakHoldFrames;
+
+    Path spectrumPaths [SpectrumAnalyser::numSignals], peakPath;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FilterGraph)
 };
 
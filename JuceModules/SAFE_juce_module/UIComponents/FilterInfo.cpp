@@ -37,6 +37,11 @@ void FilterInfo::setSampleRate (double sampleRate)
     fs = sampleRate;
 }
 
+double FilterInfo::getSampleRate() const
+{
+    return fs;
+}
+
 void FilterInfo::setGain (double newGain)
 {
     gain = newGain;
@@ -109,3 +114,103 @@ FilterResponse FilterInfo::getResponse (double inputFrequency) const
     
     return FilterResponse (abs (transferFunction) * gain, arg (transferFunction));
 }
+
+void FilterInfo::getResponses (const double* unitDelayReal, const double* unitDelayImag, double* magnitudes, double* phases, int numFrequencies) const
+{
+    jassert (numNumeratorCoeffs > 0 && numDenominatorCoeffs > 0);
+
+    const double* num = numeratorCoeffs.begin();
+    const double* den = denominatorCoeffs.begin();
+    int i = 0;
+
+   #if SAFE_USE_SSE_INTRINSICS
+    // two frequencies at a time, the phase is left until afterwards as there is
+    // no vector atan2
+    for (; i < numFrequencies - 1; i += 2)
+    {
+        const __m128d wReal = _mm_loadu_pd (unitDelayReal + i);
+        const __m128d wImag = _mm_loadu_pd (unitDelayImag + i);
+
+        __m128d numReal = _mm_set1_pd (num [numNumeratorCoeffs - 1]);
+        __m128d numImag = _mm_setzero_pd();
+
+        for (int order = numNumeratorCoeffs - 2; order >= 0; --order)
+        {
+            const __m128d real = _mm_add_pd (_mm_sub_pd (_mm_mul_pd (numReal, wReal), _mm_mul_pd (numImag, wImag)), _mm_set1_pd (num [order]));
+            numImag = _mm_add_pd (_mm_mul_pd (numReal, wImag), _mm_mul_pd (numImag, wReal));
+            numReal = real;
+        }
+
+        __m128d denReal = _mm_set1_pd (den [numDenominatorCoeffs - 1]);
+        __m128d denImag = _mm_setzero_pd();
+
+        for (int order = numDenominatorCoeffs - 2; order >= 0; --order)
+        {
+            const __m128d real = _mm_add_pd (_mm_sub_pd (_mm_mul_pd (denReal, wReal), _mm_mul_pd (denImag, wImag)), _mm_set1_pd (den [order]));
+            denImag = _mm_add_pd (_mm_mul_pd (denReal, wImag), _mm_mul_pd (denImag, wReal));
+            denReal = real;
+        }
+
+        const __m128d numPower = _mm_add_pd (_mm_mul_pd (numReal, numReal), _mm_mul_pd (numImag, numImag));
+        const __m128d denPower = _mm_add_pd (_mm_mul_pd (denReal, denReal), _mm_mul_pd (denImag, denImag));
+
+        _mm_storeu_pd (magnitudes + i, _mm_mul_pd (_mm_sqrt_pd (_mm_div_pd (numPower, denPower)), _mm_set1_pd (gain)));
+
+        if (phases != nullptr)
+        {
+            // the phase of num / den is the phase of num * conj (den)
+            double real [2], imag [2];
+            _mm_storeu_pd (real, _mm_add_pd (_mm_mul_pd (numReal, denReal), _mm_mul_pd (numImag, denImag)));
+            _mm_storeu_pd (imag, _mm_sub_pd (_mm_mul_pd (numImag, denReal), _mm_mul_pd (numReal, denImag)));
+
+            phases [i] = atan2 (imag [0], real [0]);
+            phases [i + 1] = atan2 (imag [1], real [1]);
+        }
+    }
+   #endif
+
+    for (; i < numFrequencies; ++i)
+    {
+        const double wReal = unitDelayReal [i];
+        const double wImag = unitDelayImag [i];
+
+        double numReal = num [numNumeratorCoeffs - 1], numImag = 0;
+
+        for (int order = numNumeratorCoeffs - 2; order >= 0; --order)
+        {
+            const double real = numReal * wReal - numImag * wImag + num [order];
+            numImag = numReal * wImag + numImag * wReal;
+            numReal = real;
+        }
+
+        double denReal = den [numDenominatorCoeffs - 1], denImag = 0;
+
+        for (int order = numDenominatorCoeffs - 2; order >= 0; --order)
+        {
+            const double real = denReal * wReal - denImag * wImag + den [order];
+            denImag = denReal * wImag + denImag * wReal;
+            denReal = real;
+        }
+
+        const double numPower = numReal * numReal + numImag * numImag;
+        const double denPower = denReal * denReal + denImag * denImag;
+
+        magnitudes [i] = sqrt (numPower / denPower) * gain;
+
+        if (phases != nullptr)
+        {
+            phases [i] = atan2 (numImag * denReal - numReal * denImag, numReal * denReal + numImag * denImag);
+        }
+    }
+}
+
+void FilterInfo::makeUnitDelayTable (const double* frequencies, double sampleRate, double* unitDelayReal, double* unitDelayImag, int numFrequencies)
+{
+    for (int i = 0; i < numFrequencies; ++i)
+    {
+        const double w = 2 * double_Pi * frequencies [i] / sampleRate;
+
+        unitDelayReal [i] = cos (w);
+        unitDelayImag [i] = - sin (w);
+    }
+}
@@ -47,6 +47,9 @@ public:
      */
     void setSampleRate (double sampleRate);
 
+    /** Returns the sample rate the filter was designed to run at. */
+    double getSampleRate() const;
+
     /** Set the gain to be applied to the filter response.
      *
      *  @param newGain  the new gain value
@@ -81,6 +84,31 @@ public:
      *  @param inputFrequency  the frequency to get the response of the filter at
      */
     FilterResponse getResponse (double inputFrequency) const;
+
+    /** Get the filter's response at a number of frequencies at once.
+     *
+     *  The transfer function is evaluated by Horner's method from a table of e^(-jw)
+     *  at each frequency, which can be made once with makeUnitDelayTable() and used
+     *  for every filter at the same sample rate. This is much quicker than calling
+     *  getResponse() for each frequency.
+     *
+     *  @param unitDelayReal   the real part of e^(-jw) at each frequency
+     *  @param unitDelayImag   the imaginary part of e^(-jw) at each frequency
+     *  @param magnitudes      an array to put the magnitude at each frequency in
+     *  @param phases          an array to put the phase at each frequency in, this can be nullptr
+     *  @param numFrequencies  the number of frequencies in the table
+     */
+    void getResponses (const double* unitDelayReal, const double* unitDelayImag, double* magnitudes, double* phases, int numFrequencies) const;
+
+    /** Work out e^(-jw) at a number of frequencies for getResponses().
+     *
+     *  @param frequencies     the frequencies to use
+     *  @param sampleRate      the sample rate of the filters the table will be used with
+     *  @param unitDelayReal   an array to put the real parts in
+     *  @param unitDelayImag   an array to put the imaginary parts in
+     *  @param numFrequencies  the number of frequencies
+     */
+    static void makeUnitDelayTable (const double* frequencies, double sampleRate, double* unitDelayReal, double* unitDelayImag, int numFrequencies);
     
 private:
     double fs;
@@ -33,11 +33,20 @@ void FunctionGraph::paint (Graphics& g)
     float width = (float) getWidth();
     float height = (float) getHeight();
     
-    g.fillAll (backgroundColour);
+    // paint the display background, grid lines and labels
+    if (backgroundLayer.needsPainting (g, getWidth(), getHeight()))
+    {
+        Graphics layerGraphics (backgroundLayer.getImage());
+        layerGraphics.addTransform (backgroundLayer.getTransform());
+
+        layerGraphics.fillAll (backgroundColour);
+        layerGraphics.setGradientFill (ColourGradient (Colour (0xff232338), width / 2, height / 2, Colour (0xff21222a), 2.5f, height / 2, true));
+        layerGraphics.fillRoundedRectangle (2.5f + axisLabelWidth, 2.5f, width - 5 - axisLabelWidth, height - 5 - axisLabelWidth, 10.000f);
 
-    // paint the display background
-    g.setGradientFill (ColourGradient (Colour (0xff232338), width / 2, height / 2, Colour (0xff21222a), 2.5f, height / 2, true));
-    g.fillRoundedRectangle (2.5f + axisLabelWidth, 2.5f, width - 5 - axisLabelWidth, height - 5 - axisLabelWidth, 10.000f);
+        paintGrid (layerGraphics);
+    }
+
+    backgroundLayer.draw (g);
 
     // paint the trace
     tracePath.clear();
@@ -63,6 +72,17 @@ void FunctionGraph::paint (Graphics& g)
         g.restoreState();
     }
 
+    // draw the boarder
+    g.setColour (Colours::black);
+    g.drawRoundedRectangle (2.5f + axisLabelWidth, 2.5f, width - 5 - axisLabelWidth, height - 5 -axisLabelWidth, 10.000f, 5.000f);
+}
+
+void FunctionGraph::paintGrid (Graphics& g)
+{
+    // get size info
+    float width = (float) getWidth();
+    float height = (float) getHeight();
+
     // paint the display grid lines
     gridPath.clear();
 
@@ -95,10 +115,6 @@ void FunctionGraph::paint (Graphics& g)
     g.setColour (Colour (0x60ffffff));   
     g.strokePath (gridPath, PathStrokeType (1.0f));
     g.restoreState();
-
-    // draw the boarder
-    g.setColour (Colours::black);
-    g.drawRoundedRectangle (2.5f + axisLabelWidth, 2.5f, width - 5 - axisLabelWidth, height - 5 -axisLabelWidth, 10.000f, 5.000f);
 }
 
 void FunctionGraph::resized()
@@ -121,6 +137,7 @@ void FunctionGraph::resized()
 void FunctionGraph::setLineSeparation (float newValue)
 {
     lineSeparation = newValue;
+    backgroundLayer.invalidate();
     repaint();
 }
 
@@ -128,6 +145,7 @@ void FunctionGraph::setXAxisRange (float newLowX, float newHighX)
 {
     lowX = newLowX;
     highX = newHighX;
+    backgroundLayer.invalidate();
     repaint();
 
     float width = (float) getWidth();
@@ -146,6 +164,7 @@ void FunctionGraph::setYAxisRange (float newLowY, float newHighY)
 {
     lowY = newLowY;
     highY = newHighY;
+    backgroundLayer.invalidate();
     repaint();
 }
 
@@ -158,6 +177,7 @@ void FunctionGraph::setTraceColour (Colour newColour)
 void FunctionGraph::setBackgroundColour (Colour newColour)
 {
     backgroundColour = newColour;
+    backgroundLayer.invalidate();
     repaint();
 }
 
@@ -103,6 +103,14 @@ public:
     void setOutputValues (Array <float> newOutputValues);
 
 protected:
+    /** Draw the grid lines and axis labels behind the trace.
+     *
+     *  These are painted into a cached layer along with the background, so this
+     *  isn't called on every repaint, only when the size or axis ranges change.
+     *  Graphs which inherit from this can override it to add their own static parts.
+     */
+    virtual void paintGrid (Graphics& g);
+
     int axisLabelWidth;
 
     Array <float> inputValues;
@@ -118,6 +126,8 @@ private:
 
     Path gridPath, tracePath;
 
+    CachedLayer backgroundLayer;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FunctionGraph)
 };
 
@@ -2,9 +2,14 @@
 //      Constructor and Destructor
 //==========================================================================
 LevelMeter::LevelMeter()
-    : LevelMeterTimer (1)
+    : LevelMeterTimer (1),
+      isVertical (true),
+      lastPosition (-1)
 {
     setMeterDecayTime (1000);
+
+    // the whole meter is filled so nothing behind it needs repainting
+    setOpaque (true);
 }
 
 LevelMeter::~LevelMeter()
@@ -19,15 +24,6 @@ void LevelMeter::paint (Graphics& g)
     int height = getHeight();
     int width = getWidth();
 
-    if (height >= width)
-    {
-        isVertical = true;
-    }
-    if (height < width)
-    {
-        isVertical = false;
-    }
-
     g.fillAll (Colours::black);
 
     int position = (int) gainToPosition ((float) getMeterLevel (0));
@@ -44,6 +40,12 @@ void LevelMeter::paint (Graphics& g)
     }
 }
 
+void LevelMeter::resized()
+{
+    isVertical = getHeight() >= getWidth();
+    lastPosition = -1;
+}
+
 //==========================================================================
 //      Utility Functions
 //==========================================================================
@@ -105,7 +107,7 @@ float LevelMeter::gainToPosition (float gain)
     }
     else
     {
-        return (1 - proportionOfDimension) / getWidth();
+        return (1 - proportionOfDimension) * getWidth();
     }
 }
 
@@ -119,5 +121,27 @@ void LevelMeter::setLevel (float level)
 
 void LevelMeter::meterLevelChanged()
 {
-    repaint();
+    const int position = (int) gainToPosition ((float) getMeterLevel (0));
+
+    if (lastPosition < 0)
+    {
+        repaint();
+    }
+    else if (position != lastPosition)
+    {
+        // only the strip between the old and new levels changes colour
+        const int start = jmin (position, lastPosition);
+        const int size = jmax (position, lastPosition) - start + 1;
+
+        if (isVertical)
+        {
+            repaint (0, start, getWidth(), size);
+        }
+        else
+        {
+            repaint (start, 0, size, getHeight());
+        }
+    }
+
+    lastPosition = position;
 }
@@ -25,6 +25,9 @@ public:
     /** Draw the component. */
     void paint (Graphics&);
 
+    /** Function called when the size of the meter is changed. */
+    void resized();
+
     //==========================================================================
     //      Utility Functions
     //==========================================================================
@@ -50,6 +53,8 @@ public:
     void setLevel (float level);
 
     /** Callback called whenever the meter updates.
+     *
+     *  Only the part of the meter between the old and new levels is repainted.
      *
      *  As in many places this class should privately inherit from LevelMeterTimer
      *  I may get round to changing it all at some point. For the mean time just don't
@@ -59,6 +64,9 @@ public:
 
 private:
     bool isVertical;
+
+    // the position the meter was last drawn at, or -1 if the whole meter needs drawing
+    int lastPosition;
 };
 
 #endif // __LEVELMETER__
@@ -3,10 +3,7 @@
 //==========================================================================
 LevelMeterTimer::LevelMeterTimer (int numMeters)
     : riseTime (20),
-      decayTime (100),
-      numRiseSteps (2),
-      numDecaySteps (10),
-      numSteps (10)
+      decayTime (100)
 {
     if (numMeters < 1)
     {
@@ -18,13 +15,14 @@ LevelMeterTimer::LevelMeterTimer (int numMeters)
         targetLevels.add (-100);
         currentLevels.add (-100);
         previousLevels.add (-100);
-        stepSizes.add (-100);
-        timerCounters.add (-100);
+        startTimes.add (0);
+        durations.add (0);
     }
 }
 
 LevelMeterTimer::~LevelMeterTimer()
 {
+    animationClock->stopAnimating (this);
 }
 
 //==========================================================================
@@ -35,22 +33,18 @@ void LevelMeterTimer::setMeterLevel (int index, double newLevel)
     previousLevels.set (index, currentLevels [index]);
     targetLevels.set (index, newLevel);
 
-    double levelRange = targetLevels [index] - previousLevels [index];
-    
-    stepSizes.set (index, levelRange / numDecaySteps);
-
-    if (levelRange <= 0)
+    if (newLevel <= previousLevels [index])
     {
-        numSteps = numDecaySteps;
+        durations.set (index, decayTime);
     }
     else
     {
-        numSteps = numRiseSteps;
-    }  
+        durations.set (index, riseTime);
+    }
 
-    timerCounters.set (index, 0);
+    startTimes.set (index, Time::getMillisecondCounterHiRes());
 
-    startTimer (index, 10);
+    animationClock->startAnimating (this);
 }
 
 double LevelMeterTimer::getMeterLevel (int index)
@@ -69,42 +63,51 @@ double LevelMeterTimer::getMeterTargetLevel (int index)
 void LevelMeterTimer::setMeterRiseTime (int riseInMilliseconds)
 {
     riseTime = abs (riseInMilliseconds);
-
-    numRiseSteps = (int) floor (riseTime / 10);
-
-    if (numRiseSteps < 1)
-    {
-        numRiseSteps = 1;
-    }
 }
 
 void LevelMeterTimer::setMeterDecayTime (int decayInMilliseconds)
 {
     decayTime = abs (decayInMilliseconds);
-
-    numDecaySteps = (int) floor (decayTime / 10);
-
-    if (numDecaySteps < 1)
-    {
-        numDecaySteps = 1;
-    }
 }
 
 //==========================================================================
-//      Timer Callback
+//      Meter Updates
 //==========================================================================
-void LevelMeterTimer::timerCallback (int index)
+bool LevelMeterTimer::advanceAnimation (double timeNow)
 {
-    if (timerCounters [index] < numSteps)
+    bool levelChanged = false, stillMoving = false;
+
+    for (int index = 0; index < currentLevels.size(); ++index)
     {
-        currentLevels.set (index, currentLevels [index] + stepSizes [index]);
-        timerCounters.set (index, timerCounters [index] + 1);
+        const double target = targetLevels [index];
+
+        if (currentLevels [index] == target)
+        {
+            continue;
+        }
+
+        // the meter moves in a straight line from where it was to its target, the
+        // level may have been set after the frame started so don't go backwards
+        const double elapsed = jmax (0.0, timeNow - startTimes [index]);
+
+        if (elapsed < durations [index])
+        {
+            const double previous = previousLevels [index];
+            currentLevels.set (index, previous + (target - previous) * elapsed / durations [index]);
+            stillMoving = true;
+        }
+        else
+        {
+            currentLevels.set (index, target);
+        }
+
+        levelChanged = true;
     }
-    else
+
+    if (levelChanged)
     {
-        currentLevels.set (index, targetLevels [index]);
-        stopTimer (index);
+        meterLevelChanged();
     }
 
-    meterLevelChanged();
+    return stillMoving;
 }
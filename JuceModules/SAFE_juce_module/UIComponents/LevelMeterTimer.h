@@ -5,10 +5,12 @@
  *  A base class for metering components.
  *
  *  This class provides functionality for graphical meters with configurable
- *  rise and decay time.
+ *  rise and decay time. The meters are moved towards their new levels by the
+ *  process wide AnimationClock, so all the meters which are open move in one
+ *  pass each frame and nothing runs once they have reached their levels.
  */
 
-class LevelMeterTimer : public MultiTimer
+class LevelMeterTimer : private AnimationClock::Client
 {
 public:
     //==========================================================================
@@ -64,30 +66,28 @@ public:
     void setMeterDecayTime (int decayInMilliseconds);
 
     //==========================================================================
-    //      Timer Callback
+    //      Meter Updates
     //==========================================================================
-    /** The timer callback which updates the meter levels.
-     *
-     *  This function should not be called. This class really should privately
-     *  inherit from MultiTimer but I haven't got round to changing that yet.
-     */
-    void timerCallback (int index);
-
     /** A callback function that is called whenever the value of the meter has been updated.
      *
      *  Classes which inherit from LevelMeterTimer should implement this to
-     *  update their graphics when the meter changes level.
+     *  update their graphics when the meter changes level. It is called at most
+     *  once a frame, however many of the meters have moved.
      */
     virtual void meterLevelChanged() = 0;
 
 private:
+    /** Move the meters towards their target levels. */
+    bool advanceAnimation (double timeNow) override;
+
+    SharedResourcePointer <AnimationClock> animationClock;
+
     Array <double> targetLevels, currentLevels, previousLevels;
 
-    int riseTime, decayTime;
-    int numRiseSteps, numDecaySteps, numSteps;
-    Array <double> stepSizes;
+    // when each meter started moving and how long it takes to get there, in milliseconds
+    Array <double> startTimes, durations;
 
-    Array <int> timerCounters;
+    int riseTime, decayTime;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LevelMeterTimer)
 };
@@ -56,19 +56,21 @@ public:
      */
     void setMode (ButtonMode newMode);
 
+    //==========================================================================
+    //      Progress
+    //==========================================================================
+    /** Show a progress bar along the bottom of the button.
+     *
+     *  @param newProgress  how far through something the plug-in is, from 0 to 1,
+     *                      or a negative value to hide the bar
+     */
+    void setProgress (float newProgress);
+
 private:
     ButtonMode currentMode;
+    float progress;
 
-    // images for the various modes and conditions
-    Image recordImage, recordMouseOverImage, recordMouseDownImage;
-    Image recordingImage;
-    Image saveImage, saveMouseOverImage, saveMouseDownImage;
-    Image loadImage, loadMouseOverImage, loadMouseDownImage;
-    Image metaDataImage, metaDataMouseOverImage, metaDataMouseDownImage;
-    Image localFileImage, localFileMouseOverImage, localFileMouseDownImage;
-    Image globalFileImage, globalFileMouseOverImage, globalFileMouseDownImage;
-    Image infoImage, infoMouseOverImage;
-    Image infoWarningImage, infoWarningMouseOverImage;
+    SharedResourcePointer <SAFEImageCache> images;
 
     void drawRefreshSymbol (Graphics& g);
     void drawCloseSymbol (Graphics& g);
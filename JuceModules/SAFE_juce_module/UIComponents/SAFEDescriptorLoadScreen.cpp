@@ -75,10 +75,10 @@ void SAFEDescriptorLoadScreen::listBoxItemDoubleClicked (int row, const MouseEve
 //==========================================================================
 //      Get Descriptors
 //==========================================================================
-void SAFEDescriptorLoadScreen::updateDescriptors (bool fromServer, const XmlElement* localSemanticDataElement)
+void SAFEDescriptorLoadScreen::updateDescriptors (bool fromServer, const StringArray& newLocalDescriptors)
 {
     getDataFromServer = fromServer;
-    localSemanticData = localSemanticDataElement;
+    localDescriptors = newLocalDescriptors;
 
     allDescriptors.clear();
 
@@ -91,15 +91,9 @@ void SAFEDescriptorLoadScreen::updateDescriptors (bool fromServer, const XmlElem
         loadableDescriptors = loadableDescriptors.removeCharacters ("()[]{}<>");
         allDescriptors.addTokens (loadableDescriptors, true);
     }
-    else if (localSemanticDataElement)
+    else
     {
-        forEachXmlChildElement (*localSemanticDataElement, entry)
-        {
-            for (int i = 0; i < entry->getNumAttributes(); ++i)
-            {
-                allDescriptors.add (entry->getStringAttribute (String ("Descriptor") + String (i)));
-            }
-        }
+        allDescriptors = localDescriptors;
     }
     
     allDescriptors.removeEmptyStrings();
@@ -126,7 +120,7 @@ void SAFEDescriptorLoadScreen::buttonClicked (Button *buttonThatWasClicked)
 {
     if (buttonThatWasClicked == &refreshButton)
     {
-        updateDescriptors (getDataFromServer, localSemanticData);
+        updateDescriptors (getDataFromServer, localDescriptors);
     }
 }
 
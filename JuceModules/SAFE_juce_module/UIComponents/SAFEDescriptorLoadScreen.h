@@ -40,10 +40,9 @@ public:
      *  @param fromServer                if true the descriptor list will be populated
      *                                   by the descriptors on the server otherwise the
      *                                   local descriptor file will be used
-     *  @param localSemanticDataElement  a pointer to the XMLElement from the local descriptor 
-     *                                   file
+     *  @param newLocalDescriptors       the descriptors in the local descriptor file
      */
-    void updateDescriptors (bool fromServer, const XmlElement* localSemanticDataElement);
+    void updateDescriptors (bool fromServer, const StringArray& newLocalDescriptors);
 
     /** Returns the currently selected descriptor. */
     String getSelectedDescriptor();
@@ -85,7 +84,7 @@ private:
     String previousSearchTerm;
 
     bool getDataFromServer;
-    const XmlElement *localSemanticData;
+    StringArray localDescriptors;
 
     //==========================================================================
     //      Descriptor Search
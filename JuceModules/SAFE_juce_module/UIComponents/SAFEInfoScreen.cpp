@@ -7,9 +7,6 @@
 SAFEInfo::SAFEInfo()
 {
     setSize (330, 1686);
-
-    currentImage = ImageCache::getFromMemory (SAFEImages::infopanecurrent_png, SAFEImages::infopanecurrent_pngSize);
-    updateImage = ImageCache::getFromMemory (SAFEImages::infopaneupdate_png, SAFEImages::infopaneupdate_pngSize);
 }
 
 SAFEInfo::~SAFEInfo()
@@ -21,24 +18,14 @@ SAFEInfo::~SAFEInfo()
 //==========================================================================
 void SAFEInfo::paint (Graphics& g)
 {
-    Image imageToDraw;
-
     if (JucePlugin_Version < version)
     {
-        imageToDraw = updateImage;
+        images->drawImage (g, SAFEImages::infopaneupdate_png, SAFEImages::infopaneupdate_pngSize, getLocalBounds());
     }
     else
     {
-        imageToDraw = currentImage;
+        images->drawImage (g, SAFEImages::infopanecurrent_png, SAFEImages::infopanecurrent_pngSize, getLocalBounds());
     }
-
-    int width = getWidth();
-    int height = getHeight();
-
-    int imageWidth = imageToDraw.getWidth();
-    int imageHeight = imageToDraw.getHeight();
-
-    g.drawImage (imageToDraw, 0, 0, width, height, 0, 0, imageWidth, imageHeight);
 }
 
 //==========================================================================
@@ -38,7 +38,8 @@ public:
     void setMostRecentVersion (float versionNumber);
 
 private:
-    Image currentImage, updateImage;
+    // the instructions are only decoded once somebody opens them
+    SharedResourcePointer <SAFEImageCache> images;
 
     float version;
 };
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2012 Jamie Bullock
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+/* allocation_counter.c: counts heap allocations made by the benchmark */
+
+#include <stdlib.h>
+
+#include "allocation_counter.h"
+
+static int counting = 0;
+static unsigned long allocations = 0;
+
+#ifdef __GLIBC__
+
+/* The benchmark's own malloc() takes precedence over the C library's, for
+ * the library as well as the program, so every allocation made while a
+ * feature is running passes through here on its way to glibc */
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t count, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+extern void __libc_free(void *ptr);
+
+void *malloc(size_t size)
+{
+    if(counting)
+        ++allocations;
+
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size)
+{
+    if(counting)
+        ++allocations;
+
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+    if(counting)
+        ++allocations;
+
+    return __libc_realloc(ptr, size);
+}
+
+void free(void *ptr)
+{
+    __libc_free(ptr);
+}
+
+int allocation_counter_is_available(void)
+{
+    return 1;
+}
+
+#else
+
+int allocation_counter_is_available(void)
+{
+    return 0;
+}
+
+#endif
+
+void allocation_counter_start(void)
+{
+    allocations = 0;
+    counting = 1;
+}
+
+unsigned long allocation_counter_stop(void)
+{
+    counting = 0;
+
+    return allocations;
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2012 Jamie Bullock
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+/** \file allocation_counter.h: counts heap allocations made by the benchmark */
+
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \brief Returns non-zero if allocations can be counted on this platform
+ *
+ * Counting works by replacing malloc(), calloc() and realloc() with versions
+ * that forward to the C library, which is only done with glibc.
+ */
+int allocation_counter_is_available(void);
+
+/** \brief Reset the count to zero and start counting allocations */
+void allocation_counter_start(void);
+
+/** \brief Stop counting and return the number of allocations since allocation_counter_start() */
+unsigned long allocation_counter_stop(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,1113 @@
+/*
+ * Copyright (C) 2012 Jamie Bullock
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+/*
+ * benchmark: times every function in the xtract[] array, and the sequence of
+ * calls SAFEFeatureExtractor::analyseFrame() makes for each analysis frame,
+ * over a range of frame sizes.
+ *
+ * Results can be appended to a CSV file and compared with the last run in
+ * it, so the effect of changes to the library can be tracked over time.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "xtract/libxtract.h"
+#include "allocation_counter.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846264338327
+#endif
+
+using namespace std;
+
+#define SAMPLERATE 44100
+#define TONE_FREQUENCY 220.0
+#define MFCC_FREQ_BANDS 13
+#define MFCC_FREQ_MIN 20
+#define MFCC_FREQ_MAX 20000
+#define LPC_ORDER 20
+#define LPCC_LENGTH 30
+#define SUBBAND_COUNT 32
+#define MIN_FRAME_SIZE 64
+#define MAX_FRAME_SIZE 65536
+
+static const char *feature_names[XTRACT_FEATURES] =
+{
+    "mean",
+    "variance",
+    "standard_deviation",
+    "average_deviation",
+    "skewness",
+    "kurtosis",
+    "spectral_mean",
+    "spectral_variance",
+    "spectral_standard_deviation",
+    "spectral_skewness",
+    "spectral_kurtosis",
+    "spectral_centroid",
+    "irregularity_k",
+    "irregularity_j",
+    "tristimulus_1",
+    "tristimulus_2",
+    "tristimulus_3",
+    "smoothness",
+    "spread",
+    "zcr",
+    "rolloff",
+    "loudness",
+    "flatness",
+    "flatness_db",
+    "tonality",
+    "crest",
+    "noisiness",
+    "rms_amplitude",
+    "spectral_inharmonicity",
+    "power",
+    "odd_even_ratio",
+    "sharpness",
+    "spectral_slope",
+    "lowest_value",
+    "highest_value",
+    "sum",
+    "nonzero_count",
+    "hps",
+    "f0",
+    "failsafe_f0",
+    "wavelet_f0",
+    "midicent",
+    "lnorm",
+    "flux",
+    "attack_time",
+    "decay_time",
+    "difference_vector",
+    "autocorrelation",
+    "amdf",
+    "asdf",
+    "bark_coefficients",
+    "peak_spectrum",
+    "spectrum",
+    "autocorrelation_fft",
+    "mfcc",
+    "dct",
+    "harmonic_spectrum",
+    "lpc",
+    "lpcc",
+    "subbands",
+    "windowed",
+    "smoothed"
+};
+
+/* ------------------------------------------------------------------------- */
+
+typedef struct options_
+{
+    vector<int> frame_sizes;
+    double min_seconds;
+    double samplerate;
+    string output_file;
+    string baseline_file;
+    string label;
+}
+options;
+
+/* Everything needed to call any feature on one frame, derived from the same
+ * test signal in the same way analyseFrame() derives it */
+typedef struct frame_inputs_
+{
+    int N;
+    double samplerate;
+
+    vector<double> audio;
+    vector<double> spectrum;
+    vector<double> peaks;
+    vector<double> harmonics;
+    vector<double> difference;
+    vector<double> autocorrelation;
+    vector<double> lpc;
+    vector<double> barks;
+    vector<double> result;
+
+    /* the pipeline's own working vectors, so it doesn't allocate */
+    vector<double> pipeline_spectrum;
+    vector<double> pipeline_peaks;
+    vector<double> pipeline_harmonics;
+
+    double mean;
+    double variance;
+    double standard_deviation;
+    double centroid;
+    double spectral_variance;
+    double spectral_standard_deviation;
+    double spectral_mean;
+    double highest_value;
+    double flatness;
+    double flatness_db;
+    double f0;
+    double num_harmonics;
+    double num_partials;
+
+    double *window;
+    int bark_limits[XTRACT_BARK_BANDS];
+    xtract_mel_filter mel_filters;
+    int subband_args[4];
+    int lpcc_length;
+
+    /* argument arrays for features that take more than one value */
+    double args[XTRACT_FEATURES][4];
+}
+frame_inputs;
+
+typedef struct feature_call_
+{
+    const double *data;
+    int N;
+    const void *argv;
+}
+feature_call;
+
+typedef struct measurement_
+{
+    double ns_per_call;
+    double allocations_per_call;
+    int rv;
+}
+measurement;
+
+/* When enabled, the time spent in each feature during the pipeline, summed
+ * over every call to it */
+typedef struct pipeline_profile_
+{
+    bool enabled;
+    double seconds[XTRACT_FEATURES];
+    int calls[XTRACT_FEATURES];
+}
+pipeline_profile;
+
+typedef map<string, double> baseline;
+
+/* ------------------------------------------------------------------------- */
+
+void print_usage(void)
+{
+    cout << "Usage: benchmark [options]\n\n"
+         << "Times every LibXtract feature, and the analyseFrame() pipeline used by\n"
+         << "SAFEFeatureExtractor, for a range of frame sizes.\n\n"
+         << "Options:\n"
+         << "  -s <list>     comma separated frame sizes, powers of two (default: 512,1024,...,16384)\n"
+         << "  -t <seconds>  minimum time to spend on each measurement (default: 0.1)\n"
+         << "  -r <rate>     sample rate of the test signal (default: 44100)\n"
+         << "  -o <file>     append the results to a CSV file\n"
+         << "  -c <file>     compare the results with the last run in a CSV file\n"
+         << "  -l <label>    label to store with the results, e.g. a commit hash\n"
+         << "  -h            show this message\n";
+}
+
+bool is_power_of_two(int n)
+{
+    return n > 0 && (n & (n - 1)) == 0;
+}
+
+bool parse_frame_sizes(const string &list, vector<int> &frame_sizes)
+{
+    stringstream stream(list);
+    string item;
+
+    frame_sizes.clear();
+
+    while(getline(stream, item, ','))
+    {
+        int N = atoi(item.c_str());
+
+        if(!is_power_of_two(N) || N < MIN_FRAME_SIZE || N > MAX_FRAME_SIZE)
+        {
+            return false;
+        }
+
+        frame_sizes.push_back(N);
+    }
+
+    return !frame_sizes.empty();
+}
+
+bool parse_options(int argc, char *argv[], options &opts)
+{
+    for(int N = 512; N <= 16384; N <<= 1)
+    {
+        opts.frame_sizes.push_back(N);
+    }
+
+    opts.min_seconds = 0.1;
+    opts.samplerate = SAMPLERATE;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        string arg = argv[i];
+
+        if(i + 1 >= argc)
+        {
+            cerr << "Error: " << arg << " needs a value" << endl;
+            return false;
+        }
+
+        string value = argv[++i];
+
+        if(arg == "-s")
+        {
+            if(!parse_frame_sizes(value, opts.frame_sizes))
+            {
+                cerr << "Error: frame sizes must be powers of two from "
+                     << MIN_FRAME_SIZE << " to " << MAX_FRAME_SIZE << endl;
+                return false;
+            }
+        }
+        else if(arg == "-t")
+        {
+            opts.min_seconds = atof(value.c_str());
+
+            if(opts.min_seconds <= 0.0)
+            {
+                cerr << "Error: -t must be more than zero" << endl;
+                return false;
+            }
+        }
+        else if(arg == "-r")
+        {
+            opts.samplerate = atof(value.c_str());
+
+            if(opts.samplerate <= 0.0)
+            {
+                cerr << "Error: -r must be more than zero" << endl;
+                return false;
+            }
+        }
+        else if(arg == "-o")
+        {
+            opts.output_file = value;
+        }
+        else if(arg == "-c")
+        {
+            opts.baseline_file = value;
+        }
+        else if(arg == "-l")
+        {
+            /* keep the label from breaking up the CSV columns */
+            replace(value.begin(), value.end(), ',', ' ');
+            opts.label = value;
+        }
+        else
+        {
+            cerr << "Error: unknown option " << arg << endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* ------------------------------------------------------------------------- */
+
+/* A tone with a handful of harmonics, a slow tremolo and a little noise. The
+ * noise comes from a fixed LCG so every platform sees the same signal */
+void make_test_signal(vector<double> &signal, int length, double samplerate)
+{
+    unsigned int seed = 0x5afe;
+
+    signal.resize(length);
+
+    for(int n = 0; n < length; ++n)
+    {
+        double t = n / samplerate;
+        double tone = 0.0;
+
+        for(int h = 1; h <= 8; ++h)
+        {
+            tone += sin(2.0 * M_PI * TONE_FREQUENCY * h * t) / h;
+        }
+
+        seed = seed * 1664525u + 1013904223u;
+        double noise = (seed >> 8) / (double)(1 << 24) * 2.0 - 1.0;
+
+        signal[n] = 0.4 * (0.8 + 0.2 * sin(2.0 * M_PI * 3.0 * t)) * tone + 0.01 * noise;
+    }
+}
+
+void prepare_inputs(frame_inputs &in, const vector<double> &signal, int N, double samplerate)
+{
+    const int M = N >> 1;
+    double argd[4] = {samplerate / N, XTRACT_MAGNITUDE_SPECTRUM, 0.0, 0.0};
+
+    in.N = N;
+    in.samplerate = samplerate;
+
+    in.audio.assign(signal.begin(), signal.begin() + N);
+    in.spectrum.assign(N, 0.0);
+    in.peaks.assign(N, 0.0);
+    in.harmonics.assign(N, 0.0);
+    in.difference.assign(M, 0.0);
+    in.autocorrelation.assign(N, 0.0);
+    in.lpc.assign(LPC_ORDER * 2, 0.0);
+    in.barks.assign(XTRACT_BARK_BANDS, 0.0);
+    in.result.assign(N * 2 + 64, 0.0);
+    in.pipeline_spectrum.assign(N, 0.0);
+    in.pipeline_peaks.assign(N, 0.0);
+    in.pipeline_harmonics.assign(N, 0.0);
+
+    /* the same set up the plug-ins do in LibXtractHolder and SAFEFeatureExtractor::initialise() */
+    xtract_init_fft(N, XTRACT_SPECTRUM);
+    xtract_init_fft(N, XTRACT_AUTOCORRELATION_FFT);
+    xtract_init_bark(N, samplerate, in.bark_limits);
+
+    in.mel_filters.n_filters = MFCC_FREQ_BANDS;
+    in.mel_filters.filters = new double *[MFCC_FREQ_BANDS];
+
+    for(int k = 0; k < MFCC_FREQ_BANDS; ++k)
+    {
+        in.mel_filters.filters[k] = new double[N];
+    }
+
+    xtract_init_mfcc(M, samplerate / 2, XTRACT_EQUAL_GAIN, MFCC_FREQ_MIN, MFCC_FREQ_MAX,
+                     in.mel_filters.n_filters, in.mel_filters.filters);
+
+    in.window = xtract_init_window(N, XTRACT_HANN);
+
+    in.subband_args[0] = XTRACT_SUM;
+    in.subband_args[1] = SUBBAND_COUNT;
+    in.subband_args[2] = XTRACT_LINEAR_SUBBANDS;
+    in.subband_args[3] = 0;
+    in.lpcc_length = LPCC_LENGTH;
+
+    /* the intermediate vectors and values other features are fed with */
+    double *audio = &in.audio[0];
+    double *spectrum = &in.spectrum[0];
+
+    xtract_spectrum(audio, N, argd, spectrum);
+
+    xtract_mean(audio, N, NULL, &in.mean);
+    xtract_variance(audio, N, &in.mean, &in.variance);
+    xtract_standard_deviation(audio, N, &in.variance, &in.standard_deviation);
+
+    xtract_spectral_centroid(spectrum, N, NULL, &in.centroid);
+    xtract_spectral_variance(spectrum, N, &in.centroid, &in.spectral_variance);
+    xtract_spectral_standard_deviation(spectrum, N, &in.spectral_variance, &in.spectral_standard_deviation);
+    xtract_mean(spectrum, M, NULL, &in.spectral_mean);
+    xtract_highest_value(spectrum, M, NULL, &in.highest_value);
+    xtract_flatness(spectrum, M, NULL, &in.flatness);
+    xtract_flatness_db(NULL, 0, &in.flatness, &in.flatness_db);
+
+    if(xtract_wavelet_f0(audio, N, &samplerate, &in.f0) != XTRACT_SUCCESS)
+    {
+        in.f0 = TONE_FREQUENCY;
+    }
+
+    argd[1] = 10.0;
+    xtract_peak_spectrum(spectrum, M, argd, &in.peaks[0]);
+
+    argd[0] = in.f0;
+    argd[1] = 0.2;
+    xtract_harmonic_spectrum(&in.peaks[0], N, argd, &in.harmonics[0]);
+
+    xtract_nonzero_count(&in.harmonics[0], M, NULL, &in.num_harmonics);
+    xtract_nonzero_count(&in.peaks[0], M, NULL, &in.num_partials);
+
+    xtract_bark_coefficients(spectrum, M, in.bark_limits, &in.barks[0]);
+    xtract_difference_vector(spectrum, N, NULL, &in.difference[0]);
+    xtract_autocorrelation(audio, N, NULL, &in.autocorrelation[0]);
+    xtract_lpc(&in.autocorrelation[0], LPC_ORDER + 1, NULL, &in.lpc[0]);
+}
+
+void free_inputs(frame_inputs &in)
+{
+    for(int k = 0; k < in.mel_filters.n_filters; ++k)
+    {
+        delete[] in.mel_filters.filters[k];
+    }
+
+    delete[] in.mel_filters.filters;
+
+    xtract_free_window(in.window);
+    xtract_free_fft();
+}
+
+/* The data, length and arguments each feature is called with. Lengths follow
+ * the conventions in analyseFrame(), e.g. N / 2 for features that only look
+ * at the magnitudes of a spectrum */
+feature_call get_feature_call(frame_inputs &in, int feature)
+{
+    const int N = in.N;
+    const int M = N >> 1;
+    double *args = in.args[feature];
+    feature_call call = {&in.audio[0], N, NULL};
+
+    switch(feature)
+    {
+        case XTRACT_VARIANCE:
+        case XTRACT_AVERAGE_DEVIATION:
+            call.argv = &in.mean;
+            break;
+        case XTRACT_STANDARD_DEVIATION:
+            call.argv = &in.variance;
+            break;
+        case XTRACT_SKEWNESS:
+        case XTRACT_KURTOSIS:
+            args[0] = in.mean;
+            args[1] = in.standard_deviation;
+            call.argv = args;
+            break;
+        case XTRACT_SPECTRAL_MEAN:
+        case XTRACT_SPECTRAL_CENTROID:
+        case XTRACT_SPECTRAL_SLOPE:
+        case XTRACT_HPS:
+        case XTRACT_DIFFERENCE_VECTOR:
+            call.data = &in.spectrum[0];
+            break;
+        case XTRACT_SPECTRAL_VARIANCE:
+        case XTRACT_SPREAD:
+            call.data = &in.spectrum[0];
+            call.argv = &in.centroid;
+            break;
+        case XTRACT_SPECTRAL_STANDARD_DEVIATION:
+            call.data = &in.spectrum[0];
+            call.argv = &in.spectral_variance;
+            break;
+        case XTRACT_SPECTRAL_SKEWNESS:
+        case XTRACT_SPECTRAL_KURTOSIS:
+            args[0] = in.centroid;
+            args[1] = in.spectral_standard_deviation;
+            call.data = &in.spectrum[0];
+            call.argv = args;
+            break;
+        case XTRACT_IRREGULARITY_K:
+        case XTRACT_IRREGULARITY_J:
+        case XTRACT_SMOOTHNESS:
+        case XTRACT_FLATNESS:
+        case XTRACT_HIGHEST_VALUE:
+        case XTRACT_SUM:
+            call.data = &in.spectrum[0];
+            call.N = M;
+            break;
+        case XTRACT_LOWEST_VALUE:
+            args[0] = 0.0;
+            call.data = &in.spectrum[0];
+            call.N = M;
+            call.argv = args;
+            break;
+        case XTRACT_ROLLOFF:
+            args[0] = in.samplerate / N;
+            args[1] = 45.0;
+            call.data = &in.spectrum[0];
+            call.N = M;
+            call.argv = args;
+            break;
+        case XTRACT_TRISTIMULUS_1:
+        case XTRACT_TRISTIMULUS_2:
+        case XTRACT_TRISTIMULUS_3:
+        case XTRACT_ODD_EVEN_RATIO:
+            call.data = &in.harmonics[0];
+            call.argv = &in.f0;
+            break;
+        case XTRACT_SPECTRAL_INHARMONICITY:
+            call.data = &in.peaks[0];
+            call.argv = &in.f0;
+            break;
+        case XTRACT_NONZERO_COUNT:
+            call.data = &in.peaks[0];
+            call.N = M;
+            break;
+        case XTRACT_LOUDNESS:
+        case XTRACT_SHARPNESS:
+            call.data = &in.barks[0];
+            call.N = XTRACT_BARK_BANDS - 1;
+            break;
+        case XTRACT_FLATNESS_DB:
+            call.data = NULL;
+            call.N = 0;
+            call.argv = &in.flatness;
+            break;
+        case XTRACT_TONALITY:
+            call.data = NULL;
+            call.N = 0;
+            call.argv = &in.flatness_db;
+            break;
+        case XTRACT_CREST:
+            args[0] = in.highest_value;
+            args[1] = in.spectral_mean;
+            call.data = NULL;
+            call.N = 0;
+            call.argv = args;
+            break;
+        case XTRACT_NOISINESS:
+            args[0] = in.num_harmonics;
+            args[1] = in.num_partials;
+            call.data = NULL;
+            call.N = 0;
+            call.argv = args;
+            break;
+        case XTRACT_F0:
+        case XTRACT_FAILSAFE_F0:
+        case XTRACT_WAVELET_F0:
+            call.argv = &in.samplerate;
+            break;
+        case XTRACT_MIDICENT:
+            call.data = NULL;
+            call.N = 0;
+            call.argv = &in.f0;
+            break;
+        case XTRACT_LNORM:
+            args[0] = 2.0;
+            args[1] = XTRACT_NO_LNORM_FILTER;
+            args[2] = 0.0;
+            call.data = &in.spectrum[0];
+            call.N = M;
+            call.argv = args;
+            break;
+        case XTRACT_FLUX:
+            args[0] = 1.0;
+            args[1] = XTRACT_POSITIVE_SLOPE;
+            args[2] = 0.0;
+            call.data = &in.difference[0];
+            call.N = M;
+            call.argv = args;
+            break;
+        case XTRACT_BARK_COEFFICIENTS:
+            call.data = &in.spectrum[0];
+            call.N = M;
+            call.argv = in.bark_limits;
+            break;
+        case XTRACT_PEAK_SPECTRUM:
+            args[0] = in.samplerate / N;
+            args[1] = 10.0;
+            call.data = &in.spectrum[0];
+            call.N = M;
+            call.argv = args;
+            break;
+        case XTRACT_SPECTRUM:
+            args[0] = in.samplerate / N;
+            args[1] = XTRACT_MAGNITUDE_SPECTRUM;
+            args[2] = 0.0;
+            args[3] = 0.0;
+            call.argv = args;
+            break;
+        case XTRACT_MFCC:
+            call.data = &in.spectrum[0];
+            call.N = M;
+            call.argv = &in.mel_filters;
+            break;
+        case XTRACT_HARMONIC_SPECTRUM:
+            args[0] = in.f0;
+            args[1] = 0.2;
+            call.data = &in.peaks[0];
+            call.argv = args;
+            break;
+        case XTRACT_LPC:
+            call.data = &in.autocorrelation[0];
+            call.N = LPC_ORDER + 1;
+            break;
+        case XTRACT_LPCC:
+            /* lpcc() skips data[0], so start one before the LPC coefficients */
+            call.data = &in.lpc[LPC_ORDER - 1];
+            call.N = LPC_ORDER + 1;
+            call.argv = &in.lpcc_length;
+            break;
+        case XTRACT_SUBBANDS:
+            call.data = &in.spectrum[0];
+            call.N = M;
+            call.argv = in.subband_args;
+            break;
+        case XTRACT_WINDOWED:
+            call.argv = in.window;
+            break;
+        case XTRACT_SMOOTHED:
+            args[0] = 0.5;
+            call.data = &in.spectrum[0];
+            call.N = M;
+            call.argv = args;
+            break;
+        default:
+            /* time domain features that take no arguments */
+            break;
+    }
+
+    return call;
+}
+
+/* ------------------------------------------------------------------------- */
+
+template <typename Function>
+double time_batch(Function &function, long calls)
+{
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    for(long n = 0; n < calls; ++n)
+    {
+        function();
+    }
+
+    chrono::steady_clock::time_point end = chrono::steady_clock::now();
+
+    return chrono::duration<double>(end - start).count();
+}
+
+/* Calls a function in batches, doubling the batch size until a batch takes a
+ * measurable time, until at least min_seconds have passed. The time reported
+ * is from the fastest batch, which is the least disturbed by the rest of the
+ * system and so the most repeatable from run to run */
+template <typename Function>
+measurement measure(Function function, double min_seconds)
+{
+    measurement m;
+    double elapsed = 0.0;
+    double fastest = DBL_MAX;
+    long calls = 0;
+    long batch = 1;
+
+    /* the first call is not counted, in case it sets anything up */
+    m.rv = function();
+
+    allocation_counter_start();
+
+    while(elapsed < min_seconds)
+    {
+        double seconds = time_batch(function, batch);
+
+        fastest = min(fastest, seconds / batch);
+        elapsed += seconds;
+        calls += batch;
+
+        if(seconds < min_seconds / 20.0)
+        {
+            batch <<= 1;
+        }
+    }
+
+    m.allocations_per_call = allocation_counter_stop() / (double)calls;
+    m.ns_per_call = fastest * 1.0e9;
+
+    return m;
+}
+
+/* ------------------------------------------------------------------------- */
+
+int pipeline_call(pipeline_profile *profile, int feature, const double *data, const int N, const void *argv, double *result)
+{
+    if(profile == NULL || !profile->enabled)
+    {
+        return xtract[feature](data, N, argv, result);
+    }
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    int rv = xtract[feature](data, N, argv, result);
+    chrono::steady_clock::time_point end = chrono::steady_clock::now();
+
+    profile->seconds[feature] += chrono::duration<double>(end - start).count();
+    ++profile->calls[feature];
+
+    return rv;
+}
+
+/* Makes the same calls, in the same order and with the same arguments, as
+ * SAFEFeatureExtractor::analyseFrame() does for one frame with every feature
+ * requested, and has to be kept in step with it */
+void extract_all_features(frame_inputs &in, pipeline_profile *profile)
+{
+    vector<double> &spectrum = in.pipeline_spectrum;
+    vector<double> &peak_spectrum = in.pipeline_peaks;
+    vector<double> &harmonic_spectrum = in.pipeline_harmonics;
+    double bark_coefficients[XTRACT_BARK_BANDS], mfccs[MFCC_FREQ_BANDS];
+
+    const int numSamples = in.N;
+    double fs = in.samplerate;
+    double *sampleData = &in.audio[0];
+
+    double mean, variance, standard_deviation, rms_amplitude, zero_crossing_rate;
+    double centroid, spectral_variance, spectral_standard_deviation, skewness, kurtosis;
+    double irregularity_j, irregularity_k, fundamental, smoothness, rolloff, flatness;
+    double log_flatness, tonality, crest, spectral_slope;
+    double tristimulus_1, tristimulus_2, tristimulus_3, inharmonicity;
+    double num_harmonics, num_partials, noisiness, parity_ratio;
+
+    // time domain features
+    pipeline_call(profile, XTRACT_MEAN, sampleData, numSamples, NULL, &mean);
+    pipeline_call(profile, XTRACT_VARIANCE, sampleData, numSamples, &mean, &variance);
+    pipeline_call(profile, XTRACT_STANDARD_DEVIATION, sampleData, numSamples, &variance, &standard_deviation);
+    pipeline_call(profile, XTRACT_RMS_AMPLITUDE, sampleData, numSamples, NULL, &rms_amplitude);
+    pipeline_call(profile, XTRACT_ZCR, sampleData, numSamples, NULL, &zero_crossing_rate);
+
+    // spectral features
+    double argumentArray[4] = {fs / numSamples, XTRACT_MAGNITUDE_SPECTRUM, 0, 0};
+    pipeline_call(profile, XTRACT_SPECTRUM, sampleData, numSamples, argumentArray, &spectrum[0]);
+    pipeline_call(profile, XTRACT_SPECTRAL_CENTROID, &spectrum[0], numSamples, NULL, &centroid);
+    pipeline_call(profile, XTRACT_SPECTRAL_VARIANCE, &spectrum[0], numSamples, &centroid, &spectral_variance);
+    pipeline_call(profile, XTRACT_SPECTRAL_STANDARD_DEVIATION, &spectrum[0], numSamples, &spectral_variance, &spectral_standard_deviation);
+    argumentArray[0] = centroid;
+    argumentArray[1] = spectral_standard_deviation;
+    pipeline_call(profile, XTRACT_SPECTRAL_SKEWNESS, &spectrum[0], numSamples, argumentArray, &skewness);
+    pipeline_call(profile, XTRACT_SPECTRAL_KURTOSIS, &spectrum[0], numSamples, argumentArray, &kurtosis);
+    pipeline_call(profile, XTRACT_IRREGULARITY_J, &spectrum[0], numSamples / 2, NULL, &irregularity_j);
+    pipeline_call(profile, XTRACT_IRREGULARITY_K, &spectrum[0], numSamples / 2, NULL, &irregularity_k);
+    pipeline_call(profile, XTRACT_WAVELET_F0, sampleData, numSamples, &fs, &fundamental);
+    pipeline_call(profile, XTRACT_SMOOTHNESS, &spectrum[0], numSamples / 2, NULL, &smoothness);
+    argumentArray[0] = fs / numSamples;
+    argumentArray[1] = 45;
+    pipeline_call(profile, XTRACT_ROLLOFF, &spectrum[0], numSamples / 2, argumentArray, &rolloff);
+    pipeline_call(profile, XTRACT_FLATNESS, &spectrum[0], numSamples / 2, NULL, &flatness);
+    pipeline_call(profile, XTRACT_FLATNESS_DB, NULL, 0, &flatness, &log_flatness);
+    pipeline_call(profile, XTRACT_TONALITY, NULL, 0, &log_flatness, &tonality);
+    pipeline_call(profile, XTRACT_HIGHEST_VALUE, &spectrum[0], numSamples / 2, NULL, argumentArray);
+    pipeline_call(profile, XTRACT_MEAN, &spectrum[0], numSamples / 2, NULL, argumentArray + 1);
+    pipeline_call(profile, XTRACT_CREST, NULL, 0, argumentArray, &crest);
+    pipeline_call(profile, XTRACT_SPECTRAL_SLOPE, &spectrum[0], numSamples, NULL, &spectral_slope);
+
+    // peak spectrum features
+    argumentArray[0] = fs / numSamples;
+    argumentArray[1] = 10;
+    pipeline_call(profile, XTRACT_PEAK_SPECTRUM, &spectrum[0], numSamples / 2, argumentArray, &peak_spectrum[0]);
+    pipeline_call(profile, XTRACT_SPECTRAL_CENTROID, &peak_spectrum[0], numSamples, NULL, &centroid);
+    pipeline_call(profile, XTRACT_SPECTRAL_VARIANCE, &peak_spectrum[0], numSamples, &centroid, &spectral_variance);
+    pipeline_call(profile, XTRACT_SPECTRAL_STANDARD_DEVIATION, &peak_spectrum[0], numSamples, &spectral_variance, &spectral_standard_deviation);
+    argumentArray[0] = centroid;
+    argumentArray[1] = spectral_standard_deviation;
+    pipeline_call(profile, XTRACT_SPECTRAL_SKEWNESS, &peak_spectrum[0], numSamples, argumentArray, &skewness);
+    pipeline_call(profile, XTRACT_SPECTRAL_KURTOSIS, &peak_spectrum[0], numSamples, argumentArray, &kurtosis);
+    pipeline_call(profile, XTRACT_IRREGULARITY_J, &peak_spectrum[0], numSamples / 2, NULL, &irregularity_j);
+    pipeline_call(profile, XTRACT_IRREGULARITY_K, &peak_spectrum[0], numSamples / 2, NULL, &irregularity_k);
+    pipeline_call(profile, XTRACT_TRISTIMULUS_1, &peak_spectrum[0], numSamples, &fundamental, &tristimulus_1);
+    pipeline_call(profile, XTRACT_TRISTIMULUS_2, &peak_spectrum[0], numSamples, &fundamental, &tristimulus_2);
+    pipeline_call(profile, XTRACT_TRISTIMULUS_3, &peak_spectrum[0], numSamples, &fundamental, &tristimulus_3);
+    pipeline_call(profile, XTRACT_SPECTRAL_INHARMONICITY, &peak_spectrum[0], numSamples, &fundamental, &inharmonicity);
+
+    // harmonic spectrum features
+    argumentArray[0] = fundamental;
+    argumentArray[1] = 0.2;
+    pipeline_call(profile, XTRACT_HARMONIC_SPECTRUM, &peak_spectrum[0], numSamples, argumentArray, &harmonic_spectrum[0]);
+    pipeline_call(profile, XTRACT_SPECTRAL_CENTROID, &harmonic_spectrum[0], numSamples, NULL, &centroid);
+    pipeline_call(profile, XTRACT_SPECTRAL_VARIANCE, &harmonic_spectrum[0], numSamples, &centroid, &spectral_variance);
+    pipeline_call(profile, XTRACT_SPECTRAL_STANDARD_DEVIATION, &harmonic_spectrum[0], numSamples, &spectral_variance, &spectral_standard_deviation);
+    argumentArray[0] = centroid;
+    argumentArray[1] = spectral_standard_deviation;
+    pipeline_call(profile, XTRACT_SPECTRAL_SKEWNESS, &harmonic_spectrum[0], numSamples, argumentArray, &skewness);
+    pipeline_call(profile, XTRACT_SPECTRAL_KURTOSIS, &harmonic_spectrum[0], numSamples, argumentArray, &kurtosis);
+    pipeline_call(profile, XTRACT_IRREGULARITY_J, &harmonic_spectrum[0], numSamples / 2, NULL, &irregularity_j);
+    pipeline_call(profile, XTRACT_IRREGULARITY_K, &harmonic_spectrum[0], numSamples / 2, NULL, &irregularity_k);
+    pipeline_call(profile, XTRACT_TRISTIMULUS_1, &harmonic_spectrum[0], numSamples, &fundamental, &tristimulus_1);
+    pipeline_call(profile, XTRACT_TRISTIMULUS_2, &harmonic_spectrum[0], numSamples, &fundamental, &tristimulus_2);
+    pipeline_call(profile, XTRACT_TRISTIMULUS_3, &harmonic_spectrum[0], numSamples, &fundamental, &tristimulus_3);
+    pipeline_call(profile, XTRACT_NONZERO_COUNT, &harmonic_spectrum[0], numSamples / 2, NULL, &num_harmonics);
+    pipeline_call(profile, XTRACT_NONZERO_COUNT, &peak_spectrum[0], numSamples / 2, NULL, &num_partials);
+    argumentArray[0] = num_harmonics;
+    argumentArray[1] = num_partials;
+    pipeline_call(profile, XTRACT_NOISINESS, NULL, 0, argumentArray, &noisiness);
+    pipeline_call(profile, XTRACT_ODD_EVEN_RATIO, &harmonic_spectrum[0], numSamples, &fundamental, &parity_ratio);
+
+    // bark features
+    pipeline_call(profile, XTRACT_BARK_COEFFICIENTS, &spectrum[0], numSamples / 2, in.bark_limits, bark_coefficients);
+
+    // mfcc features
+    pipeline_call(profile, XTRACT_MFCC, &spectrum[0], numSamples / 2, &in.mel_filters, mfccs);
+}
+
+/* ------------------------------------------------------------------------- */
+
+string get_baseline_key(int N, const string &function)
+{
+    stringstream key;
+    key << N << ":" << function;
+
+    return key.str();
+}
+
+/* Reads the nanoseconds per call from the last run in a results file */
+bool load_baseline(const string &path, baseline &results, string &run)
+{
+    ifstream file(path.c_str());
+    string line;
+    vector< vector<string> > rows;
+
+    if(!file.is_open())
+    {
+        return false;
+    }
+
+    while(getline(file, line))
+    {
+        vector<string> columns;
+        stringstream stream(line);
+        string column;
+
+        while(getline(stream, column, ','))
+        {
+            columns.push_back(column);
+        }
+
+        /* run, label, frame_size, function, ns_per_call, allocations_per_call */
+        if(columns.size() == 6 && columns[0] != "run")
+        {
+            rows.push_back(columns);
+        }
+    }
+
+    if(rows.empty())
+    {
+        return false;
+    }
+
+    run = rows.back()[0];
+
+    for(size_t r = 0; r < rows.size(); ++r)
+    {
+        if(rows[r][0] == run)
+        {
+            results[get_baseline_key(atoi(rows[r][2].c_str()), rows[r][3])] = atof(rows[r][4].c_str());
+        }
+    }
+
+    return true;
+}
+
+string get_change(const baseline &results, int N, const string &function, double ns_per_call)
+{
+    baseline::const_iterator previous = results.find(get_baseline_key(N, function));
+
+    if(previous == results.end() || previous->second <= 0.0)
+    {
+        return "-";
+    }
+
+    char change[32];
+    snprintf(change, sizeof(change), "%+.1f%%", (ns_per_call / previous->second - 1.0) * 100.0);
+
+    return change;
+}
+
+/* ------------------------------------------------------------------------- */
+
+bool compare_by_cost(const pair<int, measurement> &a, const pair<int, measurement> &b)
+{
+    return a.second.ns_per_call > b.second.ns_per_call;
+}
+
+int main(int argc, char *argv[])
+{
+    options opts;
+    baseline previous;
+    string previous_run;
+    vector<double> signal;
+    ofstream output;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        if(strcmp(argv[i], "-h") == 0)
+        {
+            print_usage();
+            return EXIT_SUCCESS;
+        }
+    }
+
+    if(!parse_options(argc, argv, opts))
+    {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+
+    if(!opts.baseline_file.empty())
+    {
+        if(!load_baseline(opts.baseline_file, previous, previous_run))
+        {
+            cerr << "Error: no results found in " << opts.baseline_file << endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    /* the run is identified by when it started */
+    char run[32];
+    time_t now = time(NULL);
+    strftime(run, sizeof(run), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+
+    if(!opts.output_file.empty())
+    {
+        bool needs_header = true;
+
+        {
+            ifstream existing(opts.output_file.c_str());
+            needs_header = !existing.is_open() || existing.peek() == ifstream::traits_type::eof();
+        }
+
+        output.open(opts.output_file.c_str(), ios::out | ios::app);
+
+        if(!output.is_open())
+        {
+            cerr << "Error: could not open " << opts.output_file << endl;
+            return EXIT_FAILURE;
+        }
+
+        output << fixed << setprecision(3);
+
+        if(needs_header)
+        {
+            output << "run,label,frame_size,function,ns_per_call,allocations_per_call" << endl;
+        }
+    }
+
+    make_test_signal(signal, *max_element(opts.frame_sizes.begin(), opts.frame_sizes.end()), opts.samplerate);
+    xtract_init_wavelet_f0_state();
+
+    cout << "LibXtract benchmark, " << opts.samplerate << " Hz, run " << run;
+
+    if(!opts.label.empty())
+    {
+        cout << " (" << opts.label << ")";
+    }
+
+    cout << endl;
+
+    if(!previous_run.empty())
+    {
+        cout << "Comparing with the run from " << previous_run << endl;
+    }
+
+    if(!allocation_counter_is_available())
+    {
+        cout << "Allocations can't be counted on this platform" << endl;
+    }
+
+    for(size_t s = 0; s < opts.frame_sizes.size(); ++s)
+    {
+        const int N = opts.frame_sizes[s];
+        frame_inputs in;
+        vector< pair<int, measurement> > results;
+        vector<string> not_implemented;
+
+        cerr << "Frame size " << N << "..." << endl;
+
+        prepare_inputs(in, signal, N, opts.samplerate);
+
+        for(int feature = 0; feature < XTRACT_FEATURES; ++feature)
+        {
+            feature_call call = get_feature_call(in, feature);
+            double *result = &in.result[0];
+
+            measurement m = measure([&]() { return xtract[feature](call.data, call.N, call.argv, result); },
+                                    opts.min_seconds);
+
+            if(m.rv == XTRACT_FEATURE_NOT_IMPLEMENTED)
+            {
+                not_implemented.push_back(feature_names[feature]);
+            }
+            else
+            {
+                results.push_back(make_pair(feature, m));
+            }
+        }
+
+        /* time the whole pipeline, then run it again timing each call to see
+         * where the time goes */
+        measurement pipeline = measure([&]() { extract_all_features(in, NULL); return XTRACT_SUCCESS; },
+                                       opts.min_seconds);
+
+        pipeline_profile profile;
+        memset(&profile, 0, sizeof(profile));
+        profile.enabled = true;
+
+        double profiled_seconds = 0.0;
+
+        while(profiled_seconds < opts.min_seconds)
+        {
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            extract_all_features(in, &profile);
+            profiled_seconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        }
+
+        double profiled_total = 0.0;
+
+        for(int feature = 0; feature < XTRACT_FEATURES; ++feature)
+        {
+            profiled_total += profile.seconds[feature];
+        }
+
+        sort(results.begin(), results.end(), compare_by_cost);
+
+        printf("\nFrame size %d\n", N);
+        printf("analyseFrame() pipeline: %.1f us per frame, %.1f allocations per frame, %s on baseline\n\n",
+               pipeline.ns_per_call / 1000.0, pipeline.allocations_per_call,
+               get_change(previous, N, "pipeline", pipeline.ns_per_call).c_str());
+        printf("%4s  %-28s %14s %12s %9s %9s\n", "rank", "function", "ns/call", "allocs/call", "pipeline", "baseline");
+
+        for(size_t r = 0; r < results.size(); ++r)
+        {
+            const int feature = results[r].first;
+            const measurement &m = results[r].second;
+            char share[16] = "-";
+
+            if(profile.calls[feature] > 0 && profiled_total > 0.0)
+            {
+                snprintf(share, sizeof(share), "%.1f%%", profile.seconds[feature] / profiled_total * 100.0);
+            }
+
+            printf("%4d  %-28s %14.1f %12.1f %9s %9s\n", (int)r + 1, feature_names[feature], m.ns_per_call,
+                   m.allocations_per_call, share, get_change(previous, N, feature_names[feature], m.ns_per_call).c_str());
+
+            if(output.is_open())
+            {
+                output << run << "," << opts.label << "," << N << "," << feature_names[feature] << ","
+                       << m.ns_per_call << "," << m.allocations_per_call << "\n";
+            }
+        }
+
+        if(!not_implemented.empty())
+        {
+            printf("\nNot implemented:");
+
+            for(size_t n = 0; n < not_implemented.size(); ++n)
+            {
+                printf(" %s", not_implemented[n].c_str());
+            }
+
+            printf("\n");
+        }
+
+        if(output.is_open())
+        {
+            output << run << "," << opts.label << "," << N << ",pipeline,"
+                   << pipeline.ns_per_call << "," << pipeline.allocations_per_call << endl;
+        }
+
+        free_inputs(in);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -300,7 +300,8 @@ int xtract_autocorrelation_fft(const double *data, const int N, const void *argv
     rdft(M, 1, rfft, ooura_data_autocorrelation_fft.ooura_ip, 
             ooura_data_autocorrelation_fft.ooura_w);
 
-    for(n = 2; n < M; ++n)
+    /* a[0] - DC, a[1] - nyquist, then M / 2 - 1 complex bins */
+    for(n = 1; n < M >> 1; ++n)
     {
         rfft[n*2] = XTRACT_SQ(rfft[n*2]) + XTRACT_SQ(rfft[n*2+1]);
         rfft[n*2+1] = 0.0;
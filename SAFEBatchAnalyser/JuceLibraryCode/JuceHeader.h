@@ -0,0 +1,44 @@
+/*
+
+    IMPORTANT! This file is auto-generated each time you save your
+    project - if you alter its contents, your changes may be overwritten!
+
+    This is the header file that your files should include in order to get all the
+    JUCE library headers. You should avoid including the JUCE headers directly in
+    your own source files, because that wouldn't pick up the correct configuration
+    options for your app.
+
+*/
+
+#ifndef __APPHEADERFILE_K4TQBA__
+#define __APPHEADERFILE_K4TQBA__
+
+#include "AppConfig.h"
+#include "modules/juce_audio_basics/juce_audio_basics.h"
+#include "modules/juce_audio_processors/juce_audio_processors.h"
+#include "modules/juce_core/juce_core.h"
+#include "modules/juce_cryptography/juce_cryptography.h"
+#include "modules/juce_data_structures/juce_data_structures.h"
+#include "modules/juce_events/juce_events.h"
+#include "modules/juce_graphics/juce_graphics.h"
+#include "modules/juce_gui_basics/juce_gui_basics.h"
+#include "modules/juce_gui_extra/juce_gui_extra.h"
+#include "modules/juce_opengl/juce_opengl.h"
+#include "modules/SAFE_juce_module/SAFE_juce_module.h"
+
+#if ! DONT_SET_USING_JUCE_NAMESPACE
+ // If your code uses a lot of JUCE classes, then this will obviously save you
+ // a lot of typing, but can be disabled by setting DONT_SET_USING_JUCE_NAMESPACE.
+ using namespace juce;
+#endif
+
+#if ! JUCE_DONT_DECLARE_PROJECTINFO
+namespace ProjectInfo
+{
+    const char* const  projectName    = "SAFEBatchAnalyser";
+    const char* const  versionString  = "1.32";
+    const int          versionNumber  = 0x12000;
+}
+#endif
+
+#endif   // __APPHEADERFILE_K4TQBA__
@@ -0,0 +1,5 @@
+// This is an auto-generated file to redirect any included
+// module headers to the correct external folder.
+
+#include "../../../../JuceModules/SAFE_juce_module/SAFE_juce_module.h"
+
@@ -0,0 +1,367 @@
+/*
+  ==============================================================================
+
+    AudioFileFrameReader.cpp
+
+  ==============================================================================
+*/
+
+#include "AudioFileFrameReader.h"
+
+//==============================================================================
+namespace
+{
+    bool chunkNameIs (const char* chunkName, const char* name)
+    {
+        return memcmp (chunkName, name, 4) == 0;
+    }
+
+    // AIFF stores its sample rate as an 80 bit extended precision float
+    double extendedToDouble (const uint8* bytes)
+    {
+        const int exponent = ((bytes [0] & 0x7f) << 8) | bytes [1];
+        const uint64 mantissa = ByteOrder::bigEndianInt64 (bytes + 2);
+
+        if (exponent == 0 && mantissa == 0)
+        {
+            return 0;
+        }
+
+        const double value = std::ldexp ((double) mantissa, exponent - 16383 - 63);
+
+        return (bytes [0] & 0x80) ? -value : value;
+    }
+}
+
+//==============================================================================
+AudioFileFrameReader::AudioFileFrameReader (const File& file)
+    : stream (file),
+      sampleRate (0),
+      numChannels (0),
+      bitsPerSample (0),
+      bytesPerSample (0),
+      bytesPerFrame (0),
+      isFloatingPoint (false),
+      isLittleEndian (true),
+      isUnsigned (false),
+      dataStart (0),
+      lengthInSamples (0),
+      samplesRead (0),
+      rawDataSize (0)
+{
+    if (stream.failedToOpen())
+    {
+        errorMessage = "Could not open file: " + stream.getStatus().getErrorMessage();
+        return;
+    }
+
+    char header [12];
+
+    if (stream.read (header, 12) != 12)
+    {
+        errorMessage = "File is too short to be an audio file";
+        return;
+    }
+
+    bool headerOk = false;
+
+    if (chunkNameIs (header, "RIFF") && chunkNameIs (header + 8, "WAVE"))
+    {
+        headerOk = readWavHeader();
+    }
+    else if (chunkNameIs (header, "FORM") && chunkNameIs (header + 8, "AIFF"))
+    {
+        headerOk = readAiffHeader (false);
+    }
+    else if (chunkNameIs (header, "FORM") && chunkNameIs (header + 8, "AIFC"))
+    {
+        headerOk = readAiffHeader (true);
+    }
+    else
+    {
+        errorMessage = "Not a WAV or AIFF file";
+    }
+
+    if (headerOk && checkFormat())
+    {
+        stream.setPosition (dataStart);
+    }
+}
+
+AudioFileFrameReader::~AudioFileFrameReader()
+{
+}
+
+//==============================================================================
+bool AudioFileFrameReader::openedOk() const
+{
+    return errorMessage.isEmpty();
+}
+
+const String& AudioFileFrameReader::getErrorMessage() const
+{
+    return errorMessage;
+}
+
+double AudioFileFrameReader::getSampleRate() const
+{
+    return sampleRate;
+}
+
+int AudioFileFrameReader::getNumChannels() const
+{
+    return numChannels;
+}
+
+int64 AudioFileFrameReader::getLengthInSamples() const
+{
+    return lengthInSamples;
+}
+
+//==============================================================================
+bool AudioFileFrameReader::readFrame (double* const* destChannels, int numSamples)
+{
+    if (! openedOk() || samplesRead + numSamples > lengthInSamples)
+    {
+        return false;
+    }
+
+    const int numBytes = numSamples * bytesPerFrame;
+
+    if (numBytes > rawDataSize)
+    {
+        rawData.allocate (numBytes, false);
+        rawDataSize = numBytes;
+    }
+
+    if (stream.read (rawData, numBytes) != numBytes)
+    {
+        lengthInSamples = samplesRead;
+        return false;
+    }
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        const char* source = rawData + channel * bytesPerSample;
+        double* dest = destChannels [channel];
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            dest [i] = convertSample (source);
+            source += bytesPerFrame;
+        }
+    }
+
+    samplesRead += numSamples;
+
+    return true;
+}
+
+//==============================================================================
+bool AudioFileFrameReader::readWavHeader()
+{
+    bool foundFormat = false;
+
+    while (! stream.isExhausted())
+    {
+        char chunkName [4];
+        stream.read (chunkName, 4);
+        const int64 chunkSize = (uint32) stream.readInt();
+        const int64 chunkEnd = stream.getPosition() + chunkSize + (chunkSize & 1);
+
+        if (chunkNameIs (chunkName, "fmt "))
+        {
+            int format = (uint16) stream.readShort();
+            numChannels = stream.readShort();
+            sampleRate = (uint32) stream.readInt();
+            stream.skipNextBytes (6); // bytes per second and block align
+            bitsPerSample = stream.readShort();
+
+            if (format == 0xfffe && chunkSize >= 40)
+            {
+                // the real format is at the start of the sub format GUID
+                stream.skipNextBytes (8);
+                format = (uint16) stream.readShort();
+            }
+
+            if (format != 1 && format != 3)
+            {
+                errorMessage = "Unsupported WAV encoding (only PCM and floating point are supported)";
+                return false;
+            }
+
+            isFloatingPoint = format == 3;
+            isLittleEndian = true;
+            isUnsigned = bitsPerSample == 8;
+            foundFormat = true;
+        }
+        else if (chunkNameIs (chunkName, "data"))
+        {
+            if (! foundFormat)
+            {
+                errorMessage = "WAV file has no format chunk before its data";
+                return false;
+            }
+
+            dataStart = stream.getPosition();
+
+            // files which are still being written can have a data size of zero or -1
+            int64 dataLength = chunkSize;
+
+            if (dataLength == 0 || dataLength == 0xffffffff)
+            {
+                dataLength = stream.getTotalLength() - dataStart;
+            }
+
+            lengthInSamples = jmin (dataLength, stream.getTotalLength() - dataStart);
+            return true;
+        }
+
+        stream.setPosition (chunkEnd);
+    }
+
+    errorMessage = "WAV file has no data chunk";
+    return false;
+}
+
+bool AudioFileFrameReader::readAiffHeader (bool isAifc)
+{
+    bool foundCommon = false, foundData = false;
+    int64 dataLength = 0;
+
+    while (! stream.isExhausted())
+    {
+        char chunkName [4];
+        stream.read (chunkName, 4);
+        const int64 chunkSize = (uint32) stream.readIntBigEndian();
+        const int64 chunkEnd = stream.getPosition() + chunkSize + (chunkSize & 1);
+
+        if (chunkNameIs (chunkName, "COMM"))
+        {
+            numChannels = stream.readShortBigEndian();
+            stream.skipNextBytes (4); // number of frames, we use the size of the sound data instead
+            bitsPerSample = stream.readShortBigEndian();
+
+            uint8 rate [10];
+            stream.read (rate, 10);
+            sampleRate = extendedToDouble (rate);
+
+            isFloatingPoint = false;
+            isLittleEndian = false;
+            isUnsigned = false;
+
+            if (isAifc)
+            {
+                char compression [4];
+                stream.read (compression, 4);
+
+                if (chunkNameIs (compression, "sowt"))
+                {
+                    isLittleEndian = true;
+                }
+                else if (chunkNameIs (compression, "fl32") || chunkNameIs (compression, "FL32")
+                          || chunkNameIs (compression, "fl64") || chunkNameIs (compression, "FL64"))
+                {
+                    isFloatingPoint = true;
+                }
+                else if (! (chunkNameIs (compression, "NONE") || chunkNameIs (compression, "twos")))
+                {
+                    errorMessage = "Unsupported AIFC compression type: " + String (compression, 4);
+                    return false;
+                }
+            }
+
+            foundCommon = true;
+        }
+        else if (chunkNameIs (chunkName, "SSND"))
+        {
+            const int64 offset = (uint32) stream.readIntBigEndian();
+            stream.skipNextBytes (4); // block size
+
+            dataStart = stream.getPosition() + offset;
+            dataLength = chunkSize - 8 - offset;
+            foundData = true;
+        }
+
+        stream.setPosition (chunkEnd);
+    }
+
+    if (! foundCommon)
+    {
+        errorMessage = "AIFF file has no common chunk";
+        return false;
+    }
+
+    if (! foundData)
+    {
+        errorMessage = "AIFF file has no sound data chunk";
+        return false;
+    }
+
+    lengthInSamples = jmin (dataLength, stream.getTotalLength() - dataStart);
+    return true;
+}
+
+bool AudioFileFrameReader::checkFormat()
+{
+    const bool supportedBitDepth = isFloatingPoint ? (bitsPerSample == 32 || bitsPerSample == 64)
+                                                   : (bitsPerSample == 8 || bitsPerSample == 16
+                                                      || bitsPerSample == 24 || bitsPerSample == 32);
+
+    if (! supportedBitDepth)
+    {
+        errorMessage = "Unsupported bit depth: " + String (bitsPerSample);
+        return false;
+    }
+
+    if (numChannels <= 0 || sampleRate <= 0)
+    {
+        errorMessage = "Invalid channel count or sample rate";
+        return false;
+    }
+
+    bytesPerSample = bitsPerSample / 8;
+    bytesPerFrame = bytesPerSample * numChannels;
+    lengthInSamples /= bytesPerFrame;
+
+    return true;
+}
+
+//==============================================================================
+double AudioFileFrameReader::convertSample (const char* data) const noexcept
+{
+    if (isFloatingPoint)
+    {
+        if (bitsPerSample == 32)
+        {
+            union { uint32 asInt; float asFloat; } sample;
+            sample.asInt = isLittleEndian ? ByteOrder::littleEndianInt (data) : ByteOrder::bigEndianInt (data);
+            return sample.asFloat;
+        }
+        else
+        {
+            union { uint64 asInt; double asDouble; } sample;
+            sample.asInt = isLittleEndian ? ByteOrder::littleEndianInt64 (data) : ByteOrder::bigEndianInt64 (data);
+            return sample.asDouble;
+        }
+    }
+
+    switch (bitsPerSample)
+    {
+        case 8:
+            return isUnsigned ? ((uint8) data [0] - 128) / 128.0
+                              : (int8) data [0] / 128.0;
+
+        case 16:
+            return (int16) (isLittleEndian ? ByteOrder::littleEndianShort (data)
+                                           : ByteOrder::bigEndianShort (data)) / 32768.0;
+
+        case 24:
+            return (isLittleEndian ? ByteOrder::littleEndian24Bit (data)
+                                   : ByteOrder::bigEndian24Bit (data)) / 8388608.0;
+
+        default:
+            return (int32) (isLittleEndian ? ByteOrder::littleEndianInt (data)
+                                           : ByteOrder::bigEndianInt (data)) / 2147483648.0;
+    }
+}
@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+
+    AudioFileFrameReader.h
+
+    Reads uncompressed WAV and AIFF files from disk one analysis frame at a
+    time, so files of any length can be analysed without loading them into
+    memory.
+
+  ==============================================================================
+*/
+
+#ifndef AUDIOFILEFRAMEREADER_H_INCLUDED
+#define AUDIOFILEFRAMEREADER_H_INCLUDED
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+//==============================================================================
+/**
+    A reader for uncompressed WAV and AIFF files.
+
+    Integer PCM data of 8, 16, 24 or 32 bits and floating point data of 32 or
+    64 bits is supported, including WAVE_FORMAT_EXTENSIBLE files and AIFC files
+    using the 'NONE', 'sowt', 'fl32' and 'fl64' encodings.
+*/
+class AudioFileFrameReader
+{
+public:
+    //==============================================================================
+    /** Opens a file and reads its header.
+
+        Check openedOk() before trying to read any samples.
+    */
+    AudioFileFrameReader (const File& file);
+
+    /** Destructor. */
+    ~AudioFileFrameReader();
+
+    //==============================================================================
+    /** Returns true if the file was opened and its format is supported. */
+    bool openedOk() const;
+
+    /** Returns a description of what went wrong if openedOk() is false. */
+    const String& getErrorMessage() const;
+
+    /** Returns the sample rate of the file. */
+    double getSampleRate() const;
+
+    /** Returns the number of channels in the file. */
+    int getNumChannels() const;
+
+    /** Returns the number of samples in each channel of the file. */
+    int64 getLengthInSamples() const;
+
+    //==============================================================================
+    /** Reads the next frame of samples from the file.
+
+        The samples are split into separate channels and converted to the
+        range -1 to 1.
+
+        Returns false if there are not enough samples left in the file to fill
+        a whole frame, in which case nothing is written to the channels.
+
+        @param destChannels  an array of getNumChannels() pointers to write the samples to
+        @param numSamples    the number of samples to read into each channel
+    */
+    bool readFrame (double* const* destChannels, int numSamples);
+
+private:
+    //==============================================================================
+    FileInputStream stream;
+    String errorMessage;
+
+    double sampleRate;
+    int numChannels, bitsPerSample, bytesPerSample, bytesPerFrame;
+    bool isFloatingPoint, isLittleEndian, isUnsigned;
+
+    int64 dataStart, lengthInSamples, samplesRead;
+    HeapBlock <char> rawData;
+    int rawDataSize;
+
+    bool readWavHeader();
+    bool readAiffHeader (bool isAifc);
+    bool checkFormat();
+
+    double convertSample (const char* data) const noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE (AudioFileFrameReader)
+};
+
+
+#endif  // AUDIOFILEFRAMEREADER_H_INCLUDED
@@ -0,0 +1,191 @@
+/*
+  ==============================================================================
+
+    FeatureFileWriter.cpp
+
+  ==============================================================================
+*/
+
+#include "FeatureFileWriter.h"
+
+//==============================================================================
+bool FeatureFileWriter::getFormatFromName (const String& name, Format& format)
+{
+    const String lowerCaseName (name.toLowerCase());
+
+    if (lowerCaseName == "xml")
+    {
+        format = xmlFormat;
+    }
+    else if (lowerCaseName == "csv")
+    {
+        format = csvFormat;
+    }
+    else if (lowerCaseName == "npy")
+    {
+        format = npyFormat;
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+String FeatureFileWriter::getFileExtension (Format format)
+{
+    switch (format)
+    {
+        case csvFormat:
+            return ".csv";
+
+        case npyFormat:
+            return ".npy";
+
+        default:
+            return ".xml";
+    }
+}
+
+//==============================================================================
+Result FeatureFileWriter::write (const OwnedArray <SAFEFeatureExtractor>& extractors, Format format,
+                                 const File& sourceFile, double sampleRate, int frameLength,
+                                 const File& outputFile)
+{
+    const Result directoryCreated = outputFile.getParentDirectory().createDirectory();
+
+    if (directoryCreated.failed())
+    {
+        return directoryCreated;
+    }
+
+    TemporaryFile tempFile (outputFile);
+    bool writtenOk = false;
+
+    switch (format)
+    {
+        case xmlFormat:
+            writtenOk = writeXml (extractors, sourceFile, sampleRate, frameLength, tempFile.getFile());
+            break;
+
+        case csvFormat:
+            writtenOk = writeCsv (extractors, tempFile.getFile());
+            break;
+
+        case npyFormat:
+            writtenOk = writeNpy (extractors, tempFile.getFile());
+            break;
+    }
+
+    if (! writtenOk || ! tempFile.overwriteTargetFileWithTemporary())
+    {
+        return Result::fail ("Could not write " + outputFile.getFullPathName());
+    }
+
+    return Result::ok();
+}
+
+//==============================================================================
+bool FeatureFileWriter::writeXml (const OwnedArray <SAFEFeatureExtractor>& extractors, const File& sourceFile,
+                                  double sampleRate, int frameLength, const File& outputFile)
+{
+    XmlElement descriptors ("AudioFeatures");
+    descriptors.setAttribute ("File", sourceFile.getFileName());
+    descriptors.setAttribute ("SampleRate", sampleRate);
+    descriptors.setAttribute ("FrameLength", frameLength);
+
+    for (int channel = 0; channel < extractors.size(); ++channel)
+    {
+        XmlElement* channelElement = descriptors.createNewChildElement ("Channel" + String (channel));
+        extractors [channel]->addToXml (channelElement);
+    }
+
+    return descriptors.writeToFile (outputFile, "");
+}
+
+bool FeatureFileWriter::writeCsv (const OwnedArray <SAFEFeatureExtractor>& extractors, const File& outputFile)
+{
+    FileOutputStream output (outputFile);
+
+    if (output.failedToOpen())
+    {
+        return false;
+    }
+
+    const StringArray featureNames (SAFEFeatureExtractor::getFeatureNames (extractors.size() > 0 ? extractors [0]->getFeatureSet()
+                                                                                                   : SAFEFeatureExtractor::getFullFeatureSet()));
+
+    output << "Channel,Frame," << featureNames.joinIntoString (",") << "\n";
+
+    for (int channel = 0; channel < extractors.size(); ++channel)
+    {
+        const SAFEFeatureExtractor& extractor = *extractors [channel];
+
+        for (int frame = 0; frame < extractor.getNumAnalysisFrames(); ++frame)
+        {
+            const Array <double> features (extractor.getFeatureArray (frame));
+
+            output << channel << "," << frame;
+
+            for (int feature = 0; feature < features.size(); ++feature)
+            {
+                output << "," << String (features [feature], 10);
+            }
+
+            output << "\n";
+        }
+    }
+
+    output.flush();
+
+    return output.getStatus().wasOk();
+}
+
+bool FeatureFileWriter::writeNpy (const OwnedArray <SAFEFeatureExtractor>& extractors, const File& outputFile)
+{
+    FileOutputStream output (outputFile);
+
+    if (output.failedToOpen())
+    {
+        return false;
+    }
+
+    const int numChannels = extractors.size();
+    const int numFrames = numChannels > 0 ? extractors [0]->getNumAnalysisFrames() : 0;
+    const int numFeatures = numChannels > 0 ? SAFEFeatureExtractor::getFeatureNames (extractors [0]->getFeatureSet()).size() : 0;
+
+   #if JUCE_LITTLE_ENDIAN
+    const char* const dataType = "<f8";
+   #else
+    const char* const dataType = ">f8";
+   #endif
+
+    String header = String ("{'descr': '") + dataType + "', 'fortran_order': False, 'shape': ("
+                      + String (numChannels) + ", " + String (numFrames) + ", " + String (numFeatures) + "), }";
+
+    // the magic string, version and header length take 10 bytes and the
+    // whole header, ending in a new line, must be a multiple of 64 bytes long
+    const int preambleLength = 10;
+    const int paddedLength = ((preambleLength + header.length() + 1 + 63) / 64) * 64;
+    header = header.paddedRight (' ', paddedLength - preambleLength - 1) + "\n";
+
+    output.write ("\x93NUMPY", 6);
+    output.writeByte (1);
+    output.writeByte (0);
+    output.writeShort ((short) header.length());
+    output.write (header.toRawUTF8(), header.length());
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        for (int frame = 0; frame < numFrames; ++frame)
+        {
+            Array <double> features (extractors [channel]->getFeatureArray (frame));
+            output.write (features.getRawDataPointer(), features.size() * sizeof (double));
+        }
+    }
+
+    output.flush();
+
+    return output.getStatus().wasOk();
+}
@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+    FeatureFileWriter.h
+
+    Writes the features from a set of SAFEFeatureExtractors, one per audio
+    channel, to an XML, CSV or NumPy file.
+
+  ==============================================================================
+*/
+
+#ifndef FEATUREFILEWRITER_H_INCLUDED
+#define FEATUREFILEWRITER_H_INCLUDED
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+//==============================================================================
+/**
+    Static functions for writing extracted features to disk.
+*/
+class FeatureFileWriter
+{
+public:
+    //==============================================================================
+    /** The file formats features can be written in. */
+    enum Format
+    {
+        xmlFormat,
+        csvFormat,
+        npyFormat
+    };
+
+    /** Finds the format with a given name ("xml", "csv" or "npy").
+
+        Returns false if the name is not recognised.
+    */
+    static bool getFormatFromName (const String& name, Format& format);
+
+    /** Returns the file extension used for a format, including the dot. */
+    static String getFileExtension (Format format);
+
+    //==============================================================================
+    /** Writes the features from a set of extractors to a file.
+
+        - XML files use the same layout as the descriptor data the plug-ins
+          send to the server, with one Channel element per extractor.
+        - CSV files have one row per channel and frame, headed by the feature
+          names.
+        - NPY files hold a single array of doubles with the shape
+          (channels, frames, features). The feature names are not stored so
+          use getFeatureNames() with the extractors' feature set, or the names
+          file written by the batch analyser, to label them.
+
+        The file is written to a temporary file first and then moved into
+        place, so an interrupted run never leaves a truncated file behind.
+
+        @param extractors  one feature extractor per channel
+        @param format      the format to write the features in
+        @param sourceFile  the audio file the features were extracted from
+        @param sampleRate  the sample rate of the audio file
+        @param frameLength the number of samples in each analysis frame
+        @param outputFile  the file to write to - any existing file is replaced
+    */
+    static Result write (const OwnedArray <SAFEFeatureExtractor>& extractors, Format format,
+                         const File& sourceFile, double sampleRate, int frameLength,
+                         const File& outputFile);
+
+private:
+    //==============================================================================
+    static bool writeXml (const OwnedArray <SAFEFeatureExtractor>& extractors, const File& sourceFile,
+                          double sampleRate, int frameLength, const File& outputFile);
+
+    static bool writeCsv (const OwnedArray <SAFEFeatureExtractor>& extractors, const File& outputFile);
+
+    static bool writeNpy (const OwnedArray <SAFEFeatureExtractor>& extractors, const File& outputFile);
+
+    FeatureFileWriter();
+};
+
+
+#endif  // FEATUREFILEWRITER_H_INCLUDED
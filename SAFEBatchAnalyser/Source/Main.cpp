@@ -0,0 +1,487 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+
+    A command line tool which runs the SAFE feature extractor over WAV and
+    AIFF files offline.
+
+    libXtract keeps its FFT and pitch tracker state in globals, so files are
+    analysed in parallel by running this program again in worker mode, one
+    process per file, rather than on threads.
+
+  ==============================================================================
+*/
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "AudioFileFrameReader.h"
+#include "FeatureFileWriter.h"
+
+//==============================================================================
+namespace
+{
+    const char* const audioFileWildcards = "*.wav;*.wave;*.aif;*.aiff;*.aifc";
+    const char* const workerFlag = "--worker";
+    const int defaultFrameLength = 4096;
+
+    //==============================================================================
+    struct Options
+    {
+        Options()
+            : format (FeatureFileWriter::xmlFormat),
+              frameLength (defaultFrameLength),
+              numJobs (SystemStats::getNumCpus()),
+              featureSet (SAFEFeatureExtractor::getFullFeatureSet())
+        {
+        }
+
+        Array <File> inputs;
+        File outputDirectory;
+        FeatureFileWriter::Format format;
+        int frameLength;
+        int numJobs;
+        BigInteger featureSet;
+    };
+
+    /** Sorts files by path so the jobs run in a predictable order. */
+    struct FileSorter
+    {
+        static int compareElements (const File& first, const File& second)
+        {
+            return first.getFullPathName().compareNatural (second.getFullPathName());
+        }
+    };
+
+    /** An audio file to analyse and where to put its features. */
+    struct Job
+    {
+        File input, output;
+    };
+
+    //==============================================================================
+    void printUsage()
+    {
+        std::cout << JucePlugin_Name " " << String (JucePlugin_Version).toStdString() << "\n\n"
+                  << "Extracts the SAFE audio features from WAV and AIFF files.\n\n"
+                  << "Usage: " JucePlugin_Name " [options] <file or directory> ...\n\n"
+                  << "Options:\n"
+                  << "  -o, --output <dir>        where to write the feature files (default: next to each audio file)\n"
+                  << "  -f, --format <format>     xml, csv or npy (default: xml)\n"
+                  << "  -l, --frame-length <n>    samples per analysis frame, a power of two (default: "
+                  << defaultFrameLength << ")\n"
+                  << "  -j, --jobs <n>            number of files to analyse at once (default: number of cores)\n"
+                  << "  -F, --features <names>    comma separated features to extract, e.g. MFCC,Spectral_Centroid\n"
+                  << "                            (default: all of them)\n"
+                  << "  -h, --help                show this message\n\n"
+                  << "Directories are searched recursively for files matching " << audioFileWildcards << "\n";
+    }
+
+    /** Splits a comma separated list of feature names. */
+    StringArray getFeatureNameList (const String& names)
+    {
+        StringArray list;
+        list.addTokens (names, ",", "");
+        list.trim();
+        list.removeEmptyStrings();
+
+        return list;
+    }
+
+    Result parseOptions (const StringArray& args, Options& options)
+    {
+        for (int i = 0; i < args.size(); ++i)
+        {
+            const String& arg = args [i];
+            const bool hasValue = i + 1 < args.size();
+
+            if (arg == "-o" || arg == "--output")
+            {
+                if (! hasValue)
+                {
+                    return Result::fail (arg + " needs a directory");
+                }
+
+                options.outputDirectory = File::getCurrentWorkingDirectory().getChildFile (args [++i]);
+            }
+            else if (arg == "-f" || arg == "--format")
+            {
+                if (! hasValue || ! FeatureFileWriter::getFormatFromName (args [++i], options.format))
+                {
+                    return Result::fail (arg + " must be one of xml, csv or npy");
+                }
+            }
+            else if (arg == "-l" || arg == "--frame-length")
+            {
+                options.frameLength = hasValue ? args [++i].getIntValue() : 0;
+
+                if (options.frameLength < 64 || ! isPowerOfTwo (options.frameLength))
+                {
+                    return Result::fail (arg + " must be a power of two of at least 64");
+                }
+            }
+            else if (arg == "-j" || arg == "--jobs")
+            {
+                options.numJobs = hasValue ? args [++i].getIntValue() : 0;
+
+                if (options.numJobs < 1)
+                {
+                    return Result::fail (arg + " must be at least 1");
+                }
+            }
+            else if (arg == "-F" || arg == "--features")
+            {
+                if (! hasValue || ! SAFEFeatureExtractor::getFeatureSetFromNames (getFeatureNameList (args [++i]), options.featureSet)
+                               || options.featureSet.isZero())
+                {
+                    return Result::fail (arg + " must be a list of feature names");
+                }
+            }
+            else if (arg.startsWith ("-"))
+            {
+                return Result::fail ("Unknown option: " + arg);
+            }
+            else
+            {
+                const File input (File::getCurrentWorkingDirectory().getChildFile (arg));
+
+                if (! input.exists())
+                {
+                    return Result::fail ("No such file or directory: " + arg);
+                }
+
+                options.inputs.add (input);
+            }
+        }
+
+        if (options.inputs.size() == 0)
+        {
+            return Result::fail ("No input files given");
+        }
+
+        return Result::ok();
+    }
+
+    //==============================================================================
+    /** Works out which files to analyse, keeping the directory structure of
+        the inputs under the output directory. */
+    Array <Job> findJobs (const Options& options)
+    {
+        Array <Job> jobs;
+        const String extension = FeatureFileWriter::getFileExtension (options.format);
+
+        for (int i = 0; i < options.inputs.size(); ++i)
+        {
+            const File& input = options.inputs.getReference (i);
+            Array <File> audioFiles;
+            File root;
+
+            if (input.isDirectory())
+            {
+                input.findChildFiles (audioFiles, File::findFiles, true, audioFileWildcards);
+                FileSorter sorter;
+                audioFiles.sort (sorter);
+                root = input;
+            }
+            else
+            {
+                audioFiles.add (input);
+                root = input.getParentDirectory();
+            }
+
+            for (int j = 0; j < audioFiles.size(); ++j)
+            {
+                Job job;
+                job.input = audioFiles [j];
+
+                const File inputDirectory = job.input.getParentDirectory();
+                File outputDirectory = inputDirectory;
+
+                if (options.outputDirectory != File::nonexistent)
+                {
+                    outputDirectory = inputDirectory == root ? options.outputDirectory
+                                                             : options.outputDirectory.getChildFile (inputDirectory.getRelativePathFrom (root));
+                }
+
+                job.output = outputDirectory.getChildFile (job.input.getFileNameWithoutExtension() + extension);
+                jobs.add (job);
+            }
+        }
+
+        return jobs;
+    }
+
+    //==============================================================================
+    /** Analyses a single audio file and writes its features to disk.
+
+        The file is streamed one frame at a time. Frames do not overlap and any
+        samples after the last whole frame are ignored, as in the plug-ins.
+    */
+    Result analyseFile (const File& input, const File& output, FeatureFileWriter::Format format,
+                        int frameLength, const BigInteger& featureSet, double& audioSeconds)
+    {
+        AudioFileFrameReader reader (input);
+
+        if (! reader.openedOk())
+        {
+            return Result::fail (reader.getErrorMessage());
+        }
+
+        const int numChannels = reader.getNumChannels();
+        const int numFrames = (int) (reader.getLengthInSamples() / frameLength);
+
+        if (numFrames == 0)
+        {
+            return Result::fail ("File is shorter than one analysis frame");
+        }
+
+        OwnedArray <SAFEFeatureExtractor> extractors;
+        HeapBlock <double> sampleData ((size_t) numChannels * frameLength);
+        HeapBlock <double*> channels (numChannels);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            SAFEFeatureExtractor* extractor = extractors.add (new SAFEFeatureExtractor());
+            extractor->initialise (numFrames, frameLength, reader.getSampleRate());
+            extractor->setFeatureSet (featureSet);
+
+            channels [channel] = sampleData + channel * frameLength;
+        }
+
+        for (int frame = 0; frame < numFrames; ++frame)
+        {
+            if (! reader.readFrame (channels, frameLength))
+            {
+                return Result::fail ("Could not read frame " + String (frame));
+            }
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                extractors [channel]->analyseFrame (channels [channel], frameLength, frame);
+            }
+        }
+
+        audioSeconds = reader.getLengthInSamples() / reader.getSampleRate();
+
+        return FeatureFileWriter::write (extractors, format, input, reader.getSampleRate(), frameLength, output);
+    }
+
+    //==============================================================================
+    /** Entry point for a worker process.
+
+        The result is reported on stdout so the parent does not have to rely
+        on the exit code of its children.
+    */
+    int runWorker (const StringArray& args)
+    {
+        FeatureFileWriter::Format format;
+
+        if (args.size() != 6 || ! FeatureFileWriter::getFormatFromName (args [3], format))
+        {
+            std::cout << "ERROR: bad worker arguments" << std::endl;
+            return 1;
+        }
+
+        // the feature set is passed as a hexadecimal bit mask
+        BigInteger featureSet;
+        featureSet.parseString (args [5], 16);
+
+        double audioSeconds = 0;
+        const Result result = analyseFile (File (args [1]), File (args [2]), format, args [4].getIntValue(), featureSet, audioSeconds);
+
+        if (result.failed())
+        {
+            std::cout << "ERROR: " << result.getErrorMessage() << std::endl;
+            return 1;
+        }
+
+        std::cout << "OK " << audioSeconds << std::endl;
+        return 0;
+    }
+
+    //==============================================================================
+    /** Reads the status line a worker printed. */
+    Result parseWorkerOutput (const String& output, double& audioSeconds)
+    {
+        const String lastLine = StringArray::fromLines (output.trim()).strings.getLast();
+
+        if (lastLine.startsWith ("OK "))
+        {
+            audioSeconds = lastLine.substring (3).getDoubleValue();
+            return Result::ok();
+        }
+
+        if (lastLine.startsWith ("ERROR: "))
+        {
+            return Result::fail (lastLine.substring (7));
+        }
+
+        return Result::fail ("Worker process failed");
+    }
+
+    void reportJob (const Job& job, const Result& result, double audioSeconds,
+                    int numFinished, int numJobs, int& numFailed, double& totalAudioSeconds)
+    {
+        std::cout << "[" << numFinished << "/" << numJobs << "] " << job.input.getFullPathName();
+
+        if (result.wasOk())
+        {
+            totalAudioSeconds += audioSeconds;
+            std::cout << " -> " << job.output.getFullPathName() << std::endl;
+        }
+        else
+        {
+            ++numFailed;
+            std::cout << ": " << result.getErrorMessage() << std::endl;
+        }
+    }
+
+    //==============================================================================
+    /** Runs the jobs, keeping up to numProcesses workers going at once.
+        Returns the number of jobs which failed. */
+    int runJobs (const Array <Job>& jobs, const Options& options)
+    {
+        const String formatName = FeatureFileWriter::getFileExtension (options.format).substring (1);
+        const File executable = File::getSpecialLocation (File::currentExecutableFile);
+
+        const uint32 startTime = Time::getMillisecondCounter();
+        double totalAudioSeconds = 0;
+        int numFailed = 0, numFinished = 0, nextJob = 0;
+
+        if (options.numJobs == 1)
+        {
+            for (; nextJob < jobs.size(); ++nextJob)
+            {
+                const Job& job = jobs.getReference (nextJob);
+                double audioSeconds = 0;
+
+                const Result result = analyseFile (job.input, job.output, options.format, options.frameLength,
+                                                   options.featureSet, audioSeconds);
+                reportJob (job, result, audioSeconds, ++numFinished, jobs.size(), numFailed, totalAudioSeconds);
+            }
+        }
+        else
+        {
+            OwnedArray <ChildProcess> workers;
+            Array <int> workerJobs;
+
+            while (numFinished < jobs.size())
+            {
+                while (workers.size() < options.numJobs && nextJob < jobs.size())
+                {
+                    const Job& job = jobs.getReference (nextJob);
+
+                    StringArray command;
+                    command.add (executable.getFullPathName());
+                    command.add (workerFlag);
+                    command.add (job.input.getFullPathName());
+                    command.add (job.output.getFullPathName());
+                    command.add (formatName);
+                    command.add (String (options.frameLength));
+                    command.add (options.featureSet.toString (16));
+
+                    ChildProcess* worker = new ChildProcess();
+
+                    if (worker->start (command, ChildProcess::wantStdOut))
+                    {
+                        workers.add (worker);
+                        workerJobs.add (nextJob);
+                    }
+                    else
+                    {
+                        delete worker;
+                        reportJob (job, Result::fail ("Could not start worker process"), 0,
+                                   ++numFinished, jobs.size(), numFailed, totalAudioSeconds);
+                    }
+
+                    ++nextJob;
+                }
+
+                bool anyFinished = false;
+
+                for (int i = workers.size(); --i >= 0;)
+                {
+                    if (! workers [i]->isRunning())
+                    {
+                        double audioSeconds = 0;
+                        const Result result = parseWorkerOutput (workers [i]->readAllProcessOutput(), audioSeconds);
+
+                        reportJob (jobs.getReference (workerJobs [i]), result, audioSeconds,
+                                   ++numFinished, jobs.size(), numFailed, totalAudioSeconds);
+
+                        workers.remove (i);
+                        workerJobs.remove (i);
+                        anyFinished = true;
+                    }
+                }
+
+                if (! anyFinished)
+                {
+                    Thread::sleep (10);
+                }
+            }
+        }
+
+        const double elapsedSeconds = jmax (0.001, (Time::getMillisecondCounter() - startTime) / 1000.0);
+
+        std::cout << "\nAnalysed " << (jobs.size() - numFailed) << " of " << jobs.size() << " files, "
+                  << String (totalAudioSeconds, 1) << " s of audio in " << String (elapsedSeconds, 1) << " s ("
+                  << String (totalAudioSeconds / elapsedSeconds, 1) << "x real time)" << std::endl;
+
+        return numFailed;
+    }
+
+    /** The npy format has no room for names, so they go in a text file alongside. */
+    void writeFeatureNames (const Options& options)
+    {
+        if (options.format == FeatureFileWriter::npyFormat && options.outputDirectory != File::nonexistent)
+        {
+            options.outputDirectory.createDirectory();
+            options.outputDirectory.getChildFile ("FeatureNames.txt")
+                                   .replaceWithText (SAFEFeatureExtractor::getFeatureNames (options.featureSet).joinIntoString ("\n") + "\n");
+        }
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    StringArray args;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        args.add (CharPointer_UTF8 (argv [i]));
+    }
+
+    if (args [0] == workerFlag)
+    {
+        return runWorker (args);
+    }
+
+    if (args.size() == 0 || args.contains ("-h") || args.contains ("--help"))
+    {
+        printUsage();
+        return args.size() == 0 ? 1 : 0;
+    }
+
+    Options options;
+    const Result parsed = parseOptions (args, options);
+
+    if (parsed.failed())
+    {
+        std::cerr << "Error: " << parsed.getErrorMessage() << "\n\n";
+        printUsage();
+        return 1;
+    }
+
+    const Array <Job> jobs = findJobs (options);
+
+    if (jobs.size() == 0)
+    {
+        std::cerr << "No audio files found" << std::endl;
+        return 1;
+    }
+
+    writeFeatureNames (options);
+
+    return runJobs (jobs, options) == 0 ? 0 : 1;
+}
@@ -0,0 +1,56 @@
+/*
+  ==============================================================================
+
+    BenchmarkPlugins.h
+
+    The SAFE plug-ins which can be benchmarked.
+
+    Each plug-in's sources are compiled into this program by a file in the
+    Plugins folder, with createPluginFilter() renamed so they don't clash.
+    Those files include the plug-in's own JuceHeader.h, so this header
+    doesn't include one itself - include a JuceHeader.h before it.
+
+  ==============================================================================
+*/
+
+#ifndef BENCHMARKPLUGINS_H_INCLUDED
+#define BENCHMARKPLUGINS_H_INCLUDED
+
+//==============================================================================
+/** Describes a plug-in and how to make a new instance of it. */
+struct BenchmarkPlugin
+{
+    /** The name of the plug-in. */
+    const char* name;
+
+    /** Creates a new instance of the plug-in's processor. */
+    AudioProcessor* (JUCE_CALLTYPE *createProcessor)();
+
+    /** The {inputs, outputs} channel configurations the plug-in declares. */
+    const short (*channelConfigurations) [2];
+    int numChannelConfigurations;
+
+    /** Returns true if the plug-in declares a configuration with numChannels
+        inputs and outputs. */
+    bool supportsChannels (int numChannels) const
+    {
+        for (int i = 0; i < numChannelConfigurations; ++i)
+        {
+            if (channelConfigurations [i][0] == numChannels && channelConfigurations [i][1] == numChannels)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+};
+
+extern const BenchmarkPlugin compressorPlugin;
+extern const BenchmarkPlugin distortionPlugin;
+extern const BenchmarkPlugin equaliserPlugin;
+extern const BenchmarkPlugin harmonicsPlugin;
+extern const BenchmarkPlugin reverbPlugin;
+
+
+#endif  // BENCHMARKPLUGINS_H_INCLUDED
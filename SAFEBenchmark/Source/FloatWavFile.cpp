@@ -0,0 +1,168 @@
+/*
+  ==============================================================================
+
+    FloatWavFile.cpp
+
+  ==============================================================================
+*/
+
+#include "FloatWavFile.h"
+
+//==============================================================================
+namespace
+{
+    const int floatFormatTag = 3;
+    const int bytesPerSample = 4;
+    const int formatChunkSize = 16;
+}
+
+//==============================================================================
+Result FloatWavFile::write (const File& file, const AudioSampleBuffer& buffer, double sampleRate)
+{
+    const Result directoryCreated = file.getParentDirectory().createDirectory();
+
+    if (directoryCreated.failed())
+    {
+        return directoryCreated;
+    }
+
+    TemporaryFile tempFile (file);
+
+    {
+        FileOutputStream output (tempFile.getFile());
+
+        if (output.failedToOpen())
+        {
+            return Result::fail ("Could not write " + file.getFullPathName());
+        }
+
+        const int numChannels = buffer.getNumChannels();
+        const int numSamples = buffer.getNumSamples();
+        const int dataSize = numChannels * numSamples * bytesPerSample;
+
+        // the riff header and format chunk, all little endian
+        output.write ("RIFF", 4);
+        output.writeInt (4 + (8 + formatChunkSize) + (8 + dataSize));
+        output.write ("WAVE", 4);
+
+        output.write ("fmt ", 4);
+        output.writeInt (formatChunkSize);
+        output.writeShort ((short) floatFormatTag);
+        output.writeShort ((short) numChannels);
+        output.writeInt (roundToInt (sampleRate));
+        output.writeInt (roundToInt (sampleRate) * numChannels * bytesPerSample);
+        output.writeShort ((short) (numChannels * bytesPerSample));
+        output.writeShort ((short) (bytesPerSample * 8));
+
+        // interleaved samples
+        output.write ("data", 4);
+        output.writeInt (dataSize);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                output.writeFloat (buffer.getSample (channel, i));
+            }
+        }
+
+        output.flush();
+
+        if (! output.getStatus().wasOk())
+        {
+            return Result::fail ("Could not write " + file.getFullPathName());
+        }
+    }
+
+    if (! tempFile.overwriteTargetFileWithTemporary())
+    {
+        return Result::fail ("Could not write " + file.getFullPathName());
+    }
+
+    return Result::ok();
+}
+
+Result FloatWavFile::read (const File& file, AudioSampleBuffer& buffer, double& sampleRate)
+{
+    FileInputStream input (file);
+
+    if (input.failedToOpen())
+    {
+        return Result::fail ("Could not open " + file.getFullPathName());
+    }
+
+    char id [4];
+
+    if (input.read (id, 4) != 4 || memcmp (id, "RIFF", 4) != 0)
+    {
+        return Result::fail (file.getFileName() + " is not a WAV file");
+    }
+
+    input.readInt();
+
+    if (input.read (id, 4) != 4 || memcmp (id, "WAVE", 4) != 0)
+    {
+        return Result::fail (file.getFileName() + " is not a WAV file");
+    }
+
+    int numChannels = 0;
+    bool foundFormat = false;
+
+    while (! input.isExhausted())
+    {
+        if (input.read (id, 4) != 4)
+        {
+            break;
+        }
+
+        const int64 chunkSize = (int64) (uint32) input.readInt();
+        const int64 chunkEnd = input.getPosition() + chunkSize + (chunkSize & 1);
+
+        if (memcmp (id, "fmt ", 4) == 0)
+        {
+            const int formatTag = input.readShort();
+            numChannels = input.readShort();
+            sampleRate = (double) input.readInt();
+            input.readInt();
+            input.readShort();
+            const int bitsPerSample = input.readShort();
+
+            if (formatTag != floatFormatTag || bitsPerSample != bytesPerSample * 8 || numChannels <= 0)
+            {
+                return Result::fail (file.getFileName() + " is not a 32 bit float WAV file");
+            }
+
+            foundFormat = true;
+        }
+        else if (memcmp (id, "data", 4) == 0)
+        {
+            if (! foundFormat)
+            {
+                return Result::fail (file.getFileName() + " has no format chunk before its data");
+            }
+
+            const int numSamples = (int) (chunkSize / (numChannels * bytesPerSample));
+
+            if (input.getTotalLength() - input.getPosition() < (int64) numSamples * numChannels * bytesPerSample)
+            {
+                return Result::fail (file.getFileName() + " is truncated");
+            }
+
+            buffer.setSize (numChannels, numSamples);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                for (int channel = 0; channel < numChannels; ++channel)
+                {
+                    buffer.setSample (channel, i, input.readFloat());
+                }
+            }
+
+            return Result::ok();
+        }
+
+        input.setPosition (chunkEnd);
+    }
+
+    return Result::fail (file.getFileName() + " has no audio data");
+}
@@ -0,0 +1,43 @@
+/*
+  ==============================================================================
+
+    FloatWavFile.h
+
+    Reads and writes the 32 bit float WAV files the regression tests keep
+    their reference renders in.
+
+  ==============================================================================
+*/
+
+#ifndef FLOATWAVFILE_H_INCLUDED
+#define FLOATWAVFILE_H_INCLUDED
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+//==============================================================================
+/**
+    Saves and loads audio as 32 bit IEEE float WAV files.
+
+    Float samples are stored exactly, so a render can be compared with its
+    reference to the last bit, and the files can still be opened in any audio
+    editor to listen to or look at. Only the float format is read, which is
+    all write() produces.
+*/
+class FloatWavFile
+{
+public:
+    //==============================================================================
+    /** Writes a buffer to a file, replacing it if it already exists. */
+    static Result write (const File& file, const AudioSampleBuffer& buffer, double sampleRate);
+
+    /** Reads a file written by write().
+
+        @param file        the file to read
+        @param buffer      resized to fit and filled with the file's audio
+        @param sampleRate  set to the file's sample rate
+    */
+    static Result read (const File& file, AudioSampleBuffer& buffer, double& sampleRate);
+};
+
+
+#endif  // FLOATWAVFILE_H_INCLUDED
@@ -0,0 +1,528 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+
+    Benchmarks the DSP of the SAFE plug-ins over a sweep of sample rates,
+    block sizes and channel counts, with and without parameter automation,
+    and writes the results as JSON so they can be compared between commits.
+
+    With --check it instead runs the regression tests in a folder, comparing
+    each plug-in's output with a reference render, followed by checks of the
+    SAFE module's own DSP, and with --record it replaces those references.
+
+  ==============================================================================
+*/
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "PluginBenchmark.h"
+#include "RegressionTest.h"
+#include "ModuleChecks.h"
+
+//==============================================================================
+namespace
+{
+    const BenchmarkPlugin* const allPlugins [] =
+    {
+        &compressorPlugin,
+        &distortionPlugin,
+        &equaliserPlugin,
+        &harmonicsPlugin,
+        &reverbPlugin
+    };
+
+    //==============================================================================
+    enum Mode
+    {
+        benchmarkMode,
+        recordMode,
+        checkMode
+    };
+
+    struct Options
+    {
+        Options()
+            : mode (benchmarkMode),
+              blockSizes (StringArray::fromTokens ("16,32,64,128,256,512,1024,2048,4096", ",", "")),
+              sampleRates (StringArray::fromTokens ("44100,48000,88200,96000,176400,192000", ",", "")),
+              channels (StringArray::fromTokens ("1,2,4,8", ",", "")),
+              automationModes (StringArray::fromTokens ("off,on", ",", "")),
+              secondsPerBenchmark (1.0)
+        {
+        }
+
+        Mode mode;
+        File regressionDirectory;
+        RegressionTolerances tolerances;
+
+        Array <const BenchmarkPlugin*> plugins;
+        StringArray blockSizes, sampleRates, channels, automationModes;
+        double secondsPerBenchmark;
+        File outputFile;
+    };
+
+    //==============================================================================
+    void printUsage()
+    {
+        std::cout << JucePlugin_Name " " << String (JucePlugin_Version).toStdString() << "\n\n"
+                  << "Benchmarks the processing of the SAFE plug-ins and writes the results as JSON.\n\n"
+                  << "Usage: " JucePlugin_Name " [options]\n\n"
+                  << "Options:\n"
+                  << "  -p, --plugin <name>         a plug-in to benchmark, may be given more than once (default: all)\n"
+                  << "  -b, --block-sizes <list>    comma separated block sizes (default: 16,32,...,4096)\n"
+                  << "  -r, --sample-rates <list>   comma separated sample rates (default: 44100,48000,88200,96000,176400,192000)\n"
+                  << "  -c, --channels <list>       comma separated channel counts (default: 1,2,4,8)\n"
+                  << "  -a, --automation <mode>     off, on or both (default: both)\n"
+                  << "  -s, --seconds <n>           seconds of audio to time for each benchmark (default: 1)\n"
+                  << "  -o, --output <file>         where to write the results (default: standard output)\n"
+                  << "  -h, --help                  show this message\n\n"
+                  << "Regression tests:\n"
+                  << "  --check <folder>            render the tests in a folder and compare them with their references,\n"
+                  << "                              then check the module's DSP\n"
+                  << "  --record <folder>           render the tests in a folder and save them as their references\n"
+                  << "  --ulps <n>                  ULPs a sample may differ by, unless a test sets its own (default: 16)\n"
+                  << "  --error-db <dB>             level a sample may differ by, unless a test sets its own (default: -120)\n"
+                  << "\n"
+                  << "Plug-ins:";
+
+        for (int i = 0; i < numElementsInArray (allPlugins); ++i)
+        {
+            std::cout << " " << allPlugins [i]->name;
+        }
+
+        std::cout << "\n";
+    }
+
+    const BenchmarkPlugin* findPlugin (const String& name)
+    {
+        for (int i = 0; i < numElementsInArray (allPlugins); ++i)
+        {
+            const String pluginName (allPlugins [i]->name);
+
+            // accept "SAFECompressor" or just "compressor"
+            if (pluginName.equalsIgnoreCase (name) || pluginName.fromFirstOccurrenceOf ("SAFE", false, false).equalsIgnoreCase (name))
+            {
+                return allPlugins [i];
+            }
+        }
+
+        return nullptr;
+    }
+
+    /** Splits a comma separated list of positive numbers, failing if any of them aren't. */
+    Result parseList (const String& arg, const String& list, StringArray& values)
+    {
+        values = StringArray::fromTokens (list, ",", "");
+        values.trim();
+        values.removeEmptyStrings();
+
+        for (int i = 0; i < values.size(); ++i)
+        {
+            if (! values [i].containsOnly ("0123456789.") || values [i].getDoubleValue() <= 0)
+            {
+                return Result::fail (arg + " must be a list of positive numbers");
+            }
+        }
+
+        if (values.size() == 0)
+        {
+            return Result::fail (arg + " needs at least one value");
+        }
+
+        return Result::ok();
+    }
+
+    Result parseOptions (const StringArray& args, Options& options)
+    {
+        for (int i = 0; i < args.size(); ++i)
+        {
+            const String& arg = args [i];
+            const String value = args [i + 1];
+
+            if (arg.startsWith ("-") && value.isEmpty())
+            {
+                return Result::fail (arg + " needs a value");
+            }
+
+            Result result = Result::ok();
+
+            if (arg == "-p" || arg == "--plugin")
+            {
+                const BenchmarkPlugin* plugin = findPlugin (value);
+
+                if (plugin == nullptr)
+                {
+                    return Result::fail ("Unknown plug-in: " + value);
+                }
+
+                options.plugins.addIfNotAlreadyThere (plugin);
+            }
+            else if (arg == "-b" || arg == "--block-sizes")
+            {
+                result = parseList (arg, value, options.blockSizes);
+            }
+            else if (arg == "-r" || arg == "--sample-rates")
+            {
+                result = parseList (arg, value, options.sampleRates);
+            }
+            else if (arg == "-c" || arg == "--channels")
+            {
+                result = parseList (arg, value, options.channels);
+            }
+            else if (arg == "-a" || arg == "--automation")
+            {
+                if (value == "both")
+                {
+                    options.automationModes = StringArray::fromTokens ("off,on", ",", "");
+                }
+                else if (value == "off" || value == "on")
+                {
+                    options.automationModes = StringArray (value);
+                }
+                else
+                {
+                    return Result::fail (arg + " must be off, on or both");
+                }
+            }
+            else if (arg == "-s" || arg == "--seconds")
+            {
+                options.secondsPerBenchmark = value.getDoubleValue();
+
+                if (options.secondsPerBenchmark <= 0)
+                {
+                    return Result::fail (arg + " must be more than zero");
+                }
+            }
+            else if (arg == "--check" || arg == "--record")
+            {
+                options.mode = arg == "--check" ? checkMode : recordMode;
+                options.regressionDirectory = File::getCurrentWorkingDirectory().getChildFile (value);
+
+                if (! options.regressionDirectory.isDirectory())
+                {
+                    return Result::fail ("Can't find the folder " + value);
+                }
+            }
+            else if (arg == "--ulps")
+            {
+                options.tolerances.maxUlps = value.getIntValue();
+
+                if (! value.containsOnly ("0123456789"))
+                {
+                    return Result::fail (arg + " must be a whole number");
+                }
+            }
+            else if (arg == "--error-db")
+            {
+                options.tolerances.maxErrorDb = value.getDoubleValue();
+            }
+            else if (arg == "-o" || arg == "--output")
+            {
+                options.outputFile = File::getCurrentWorkingDirectory().getChildFile (value);
+            }
+            else
+            {
+                return Result::fail ("Unknown option: " + arg);
+            }
+
+            if (result.failed())
+            {
+                return result;
+            }
+
+            ++i;
+        }
+
+        if (options.plugins.size() == 0)
+        {
+            options.plugins.addArray (allPlugins, numElementsInArray (allPlugins));
+        }
+
+        return Result::ok();
+    }
+
+    //==============================================================================
+    var getSystemInfo()
+    {
+        DynamicObject* system = new DynamicObject();
+        system->setProperty ("os", SystemStats::getOperatingSystemName());
+        system->setProperty ("cpuVendor", SystemStats::getCpuVendor());
+        system->setProperty ("cpuSpeedMHz", SystemStats::getCpuSpeedInMegaherz());
+        system->setProperty ("numCpus", SystemStats::getNumCpus());
+
+       #if JUCE_DEBUG
+        system->setProperty ("build", "Debug");
+       #else
+        system->setProperty ("build", "Release");
+       #endif
+
+        return var (system);
+    }
+
+    /** Runs every combination of the options and collects the results. */
+    var runBenchmarks (const Options& options)
+    {
+        Array <var> results;
+        const int numBenchmarks = options.plugins.size() * options.sampleRates.size() * options.blockSizes.size()
+                                    * options.channels.size() * options.automationModes.size();
+
+        for (int p = 0; p < options.plugins.size(); ++p)
+        {
+            const BenchmarkPlugin& plugin = *options.plugins [p];
+
+            for (int r = 0; r < options.sampleRates.size(); ++r)
+            {
+                for (int b = 0; b < options.blockSizes.size(); ++b)
+                {
+                    for (int c = 0; c < options.channels.size(); ++c)
+                    {
+                        for (int a = 0; a < options.automationModes.size(); ++a)
+                        {
+                            const double sampleRate = options.sampleRates [r].getDoubleValue();
+                            const int blockSize = options.blockSizes [b].getIntValue();
+                            const int numChannels = options.channels [c].getIntValue();
+                            const bool automate = options.automationModes [a] == "on";
+
+                            // progress goes to stderr so the JSON can be piped
+                            std::cerr << "[" << (results.size() + 1) << "/" << numBenchmarks << "] "
+                                      << plugin.name << " " << sampleRate << " Hz, " << blockSize << " samples, "
+                                      << numChannels << (numChannels == 1 ? " channel" : " channels")
+                                      << (automate ? ", automated" : "") << std::endl;
+
+                            PluginBenchmark benchmark (plugin, sampleRate, blockSize, numChannels, automate);
+                            benchmark.run (options.secondsPerBenchmark);
+
+                            results.add (benchmark.getResults());
+                        }
+                    }
+                }
+            }
+        }
+
+        return var (results);
+    }
+
+    //==============================================================================
+    struct FileNameComparator
+    {
+        static int compareElements (const File& first, const File& second)
+        {
+            return first.getFileName().compareIgnoreCase (second.getFileName());
+        }
+    };
+
+    /** Runs the regression tests for the chosen plug-ins, printing a summary
+        table, and returns the number of tests which failed. */
+    int runRegressionTests (const Options& options, var& results)
+    {
+        Array <File> scripts;
+        options.regressionDirectory.findChildFiles (scripts, File::findFiles, false, "*.xml");
+
+        // run the tests in the same order on every platform
+        FileNameComparator comparator;
+        scripts.sort (comparator);
+
+        const bool recording = options.mode == recordMode;
+        int numFailed = 0;
+
+        std::cout << String ("Test").paddedRight (' ', 28) << String ("Result").paddedRight (' ', 10)
+                  << String ("Max error").paddedRight (' ', 14) << String ("Max ULPs").paddedRight (' ', 12)
+                  << String ("Residual").paddedRight (' ', 14) << "CPU time\n";
+
+        for (int i = 0; i < scripts.size(); ++i)
+        {
+            RegressionTest test (scripts [i]);
+            Result result = test.load (options.tolerances);
+            const BenchmarkPlugin* plugin = findPlugin (test.getPluginName());
+
+            if (result.wasOk() && plugin == nullptr)
+            {
+                result = Result::fail ("Unknown plug-in: " + test.getPluginName());
+            }
+
+            if (result.wasOk() && ! options.plugins.contains (plugin))
+            {
+                continue;
+            }
+
+            if (result.wasOk())
+            {
+                result = test.render (*plugin);
+            }
+
+            if (result.wasOk())
+            {
+                result = recording ? test.writeReference() : test.compareWithReference();
+            }
+
+            String line = test.getName().paddedRight (' ', 28);
+
+            if (result.failed())
+            {
+                ++numFailed;
+                line << "FAILED    ";
+            }
+            else
+            {
+                line << (recording ? "recorded  " : "passed    ");
+            }
+
+            if (! recording)
+            {
+                line << (String (test.maxErrorDb, 1) + " dB").paddedRight (' ', 14)
+                     << String (test.maxUlps).paddedRight (' ', 12)
+                     << (String (test.residualDb, 1) + " dB").paddedRight (' ', 14);
+            }
+
+            line << String (test.cpuSeconds * 1000.0, 2) << " ms";
+
+            std::cout << line << "\n";
+
+            if (result.failed())
+            {
+                std::cout << "    " << result.getErrorMessage() << "\n";
+            }
+
+            var testResults = test.getResults();
+            testResults.getDynamicObject()->setProperty ("passed", result.wasOk());
+            testResults.getDynamicObject()->setProperty ("error", result.getErrorMessage());
+
+            results.append (testResults);
+        }
+
+        std::cout << std::endl;
+
+        return numFailed;
+    }
+
+    /** Runs the checks of the module's DSP, printing a summary table, and
+        returns the number which failed. */
+    int runModuleChecks (var& results)
+    {
+        const StringArray names (ModuleChecks::getNames());
+        int numFailed = 0;
+
+        std::cout << String ("Check").paddedRight (' ', 28) << String ("Result").paddedRight (' ', 10) << "Measured\n";
+
+        for (int i = 0; i < names.size(); ++i)
+        {
+            String measurement;
+            const Result result = ModuleChecks::run (names [i], measurement);
+
+            String line = names [i].paddedRight (' ', 28);
+
+            if (result.failed())
+            {
+                ++numFailed;
+                line << "FAILED    ";
+            }
+            else
+            {
+                line << "passed    ";
+            }
+
+            std::cout << line << measurement << "\n";
+
+            if (result.failed())
+            {
+                std::cout << "    " << result.getErrorMessage() << "\n";
+            }
+
+            DynamicObject* checkResults = new DynamicObject();
+            checkResults->setProperty ("check", names [i]);
+            checkResults->setProperty ("measurement", measurement);
+            checkResults->setProperty ("passed", result.wasOk());
+            checkResults->setProperty ("error", result.getErrorMessage());
+
+            results.append (var (checkResults));
+        }
+
+        std::cout << std::endl;
+
+        return numFailed;
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    StringArray args;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        args.add (CharPointer_UTF8 (argv [i]));
+    }
+
+    if (args.contains ("-h") || args.contains ("--help"))
+    {
+        printUsage();
+        return 0;
+    }
+
+    Options options;
+    const Result parsed = parseOptions (args, options);
+
+    if (parsed.failed())
+    {
+        std::cerr << "Error: " << parsed.getErrorMessage() << "\n\n";
+        printUsage();
+        return 1;
+    }
+
+    if (options.mode != benchmarkMode)
+    {
+        var results = Array <var>();
+        int numFailed = runRegressionTests (options, results);
+
+        if (options.mode == checkMode)
+        {
+            numFailed += runModuleChecks (results);
+        }
+
+        if (options.outputFile != File::nonexistent)
+        {
+            DynamicObject* report = new DynamicObject();
+            report->setProperty ("regression", options.regressionDirectory.getFullPathName());
+            report->setProperty ("version", JucePlugin_Version);
+            report->setProperty ("date", Time::getCurrentTime().formatted ("%Y-%m-%dT%H:%M:%S"));
+            report->setProperty ("system", getSystemInfo());
+            report->setProperty ("results", results);
+
+            if (! options.outputFile.replaceWithText (JSON::toString (var (report)) + "\n"))
+            {
+                std::cerr << "Could not write " << options.outputFile.getFullPathName() << std::endl;
+                return 1;
+            }
+        }
+
+        if (numFailed > 0)
+        {
+            std::cerr << numFailed << (numFailed == 1 ? " test failed" : " tests failed") << std::endl;
+            return 1;
+        }
+
+        return 0;
+    }
+
+    DynamicObject* report = new DynamicObject();
+    report->setProperty ("benchmark", JucePlugin_Name);
+    report->setProperty ("version", JucePlugin_Version);
+    report->setProperty ("date", Time::getCurrentTime().formatted ("%Y-%m-%dT%H:%M:%S"));
+    report->setProperty ("secondsPerBenchmark", options.secondsPerBenchmark);
+    report->setProperty ("system", getSystemInfo());
+    report->setProperty ("results", runBenchmarks (options));
+
+    const String json = JSON::toString (var (report));
+
+    if (options.outputFile == File::nonexistent)
+    {
+        std::cout << json << std::endl;
+    }
+    else if (! options.outputFile.replaceWithText (json + "\n"))
+    {
+        std::cerr << "Could not write " << options.outputFile.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,428 @@
+/*
+  ==============================================================================
+
+    ModuleChecks.cpp
+
+  ==============================================================================
+*/
+
+#include "ModuleChecks.h"
+#include "TestSignal.h"
+
+//==============================================================================
+namespace
+{
+    // the decimator claims to keep anything which would alias below 20 kHz this
+    // far down at an output rate of 44.1 kHz
+    const double minimumStopbandRejectionDb = 78.0;
+    const double outputSampleRate = 44100.0;
+    const double aliasLimit = 20000.0;
+
+    // low frequency sines should come through the decimator at the same time and
+    // level they went in
+    const double maximumPassbandErrorDb = -70.0;
+
+    // how far FilterInfo::getResponses() may stray from getResponse()
+    const double maximumResponseErrorDb = 3.0e-6;
+    const double maximumPhaseError = 1.0e-6;
+
+    String formatDb (double level)
+    {
+        return String (level, 1) + " dB";
+    }
+
+    double toDb (double level)
+    {
+        return 20.0 * std::log10 (jmax (level, 1.0e-10));
+    }
+}
+
+//==============================================================================
+StringArray ModuleChecks::getNames()
+{
+    return StringArray::fromTokens ("DecimatorStopband,DecimatorDelay,ChunkedAnalysis,FilterResponses", ",", "");
+}
+
+Result ModuleChecks::run (const String& name, String& measurement)
+{
+    if (name == "DecimatorStopband")
+    {
+        return checkDecimatorStopband (measurement);
+    }
+    else if (name == "DecimatorDelay")
+    {
+        return checkDecimatorDelay (measurement);
+    }
+    else if (name == "ChunkedAnalysis")
+    {
+        return checkChunkedAnalysis (measurement);
+    }
+    else if (name == "FilterResponses")
+    {
+        return checkFilterResponses (measurement);
+    }
+
+    return Result::fail ("Unknown check: " + name);
+}
+
+//==============================================================================
+Result ModuleChecks::checkDecimatorStopband (String& measurement)
+{
+    double worstDb = -200.0;
+    int worstFactor = 0;
+    double worstFrequency = 0;
+
+    for (int factor = 2; factor <= 4; ++factor)
+    {
+        Decimator decimator;
+        decimator.setDecimationFactor (factor);
+
+        Array <double> coefficients;
+        getDecimatorCoefficients (decimator, coefficients);
+
+        const double inputSampleRate = outputSampleRate * factor;
+
+        // everything above the output nyquist frequency which folds back below 20 kHz
+        for (double frequency = outputSampleRate / 2; frequency <= inputSampleRate / 2; frequency += 10.0)
+        {
+            const double alias = std::abs (frequency - outputSampleRate * std::floor (frequency / outputSampleRate + 0.5));
+
+            if (alias >= aliasLimit)
+            {
+                continue;
+            }
+
+            const double w = 2.0 * double_Pi * frequency / inputSampleRate;
+            double real = 0, imag = 0;
+
+            for (int i = 0; i < coefficients.size(); ++i)
+            {
+                real += coefficients [i] * std::cos (w * i);
+                imag -= coefficients [i] * std::sin (w * i);
+            }
+
+            const double levelDb = toDb (std::sqrt (real * real + imag * imag));
+
+            if (levelDb > worstDb)
+            {
+                worstDb = levelDb;
+                worstFactor = factor;
+                worstFrequency = frequency;
+            }
+        }
+    }
+
+    measurement = formatDb (worstDb) + " at " + String (worstFrequency / 1000.0, 2) + " kHz, factor " + String (worstFactor);
+
+    if (worstDb > -minimumStopbandRejectionDb)
+    {
+        return Result::fail ("Aliasing is only " + formatDb (-worstDb) + " down, it should be at least "
+                              + formatDb (minimumStopbandRejectionDb));
+    }
+
+    return Result::ok();
+}
+
+Result ModuleChecks::checkDecimatorDelay (String& measurement)
+{
+    double worstErrorDb = -200.0;
+
+    for (int factor = 2; factor <= 4; ++factor)
+    {
+        Decimator decimator;
+        decimator.setDecimationFactor (factor);
+
+        // the filter must be symmetric about the delay, or taking the delay out
+        // would leave a phase shift behind
+        Array <double> coefficients;
+        getDecimatorCoefficients (decimator, coefficients);
+
+        const int delay = decimator.getDelay();
+
+        for (int i = 1; i <= delay; ++i)
+        {
+            if (coefficients [delay - i] != coefficients [delay + i])
+            {
+                return Result::fail ("The filter isn't symmetric about its delay with factor " + String (factor));
+            }
+        }
+
+        // each decimated sample should line up with every factor'th input sample
+        const double inputSampleRate = outputSampleRate * factor;
+        const int numOutputSamples = 1024;
+        const int numInputSamples = numOutputSamples * factor;
+        HeapBlock <float> input (numInputSamples);
+        HeapBlock <double> output (numOutputSamples);
+
+        const double frequencies [] = {1000.0, 5000.0};
+
+        for (int f = 0; f < numElementsInArray (frequencies); ++f)
+        {
+            for (int i = 0; i < numInputSamples; ++i)
+            {
+                input [i] = (float) (0.5 * std::sin (2.0 * double_Pi * frequencies [f] * i / inputSampleRate));
+            }
+
+            decimator.decimate (input, numInputSamples, 0, output, numOutputSamples);
+
+            // away from the ends, where the filter runs off the input
+            for (int n = delay; n < numOutputSamples - delay; ++n)
+            {
+                worstErrorDb = jmax (worstErrorDb, toDb (std::abs (output [n] - input [n * factor]) / 0.5));
+            }
+        }
+    }
+
+    measurement = "error " + formatDb (worstErrorDb);
+
+    if (worstErrorDb > maximumPassbandErrorDb)
+    {
+        return Result::fail ("Decimated sines are " + formatDb (worstErrorDb) + " away from the input, they should be within "
+                              + formatDb (maximumPassbandErrorDb));
+    }
+
+    return Result::ok();
+}
+
+Result ModuleChecks::checkChunkedAnalysis (String& measurement)
+{
+    // a long recording at 192 kHz, analysed a few frames at a time from a capture
+    // file the way SAFEAudioProcessor does, should give exactly the features an
+    // in memory recording does
+    const double sampleRate = 192000.0;
+    const int frameLength = 4096;
+    const int numFrames = 7;
+    const int numFramesPerChunk = 3;
+    const int blockSize = 512;
+
+    Decimator decimator;
+    decimator.setDecimationFactor (Decimator::getFactorForSampleRate (sampleRate, outputSampleRate));
+
+    const int factor = decimator.getDecimationFactor();
+    const int frameSamples = frameLength * factor;
+    const int numSamples = numFrames * frameSamples;
+
+    // the first channel stands in for the unprocessed signal and the second for the processed one
+    AudioSampleBuffer recording (2, numSamples);
+    TestSignal::generate ("chord", recording, sampleRate);
+
+    // room for the whole recording, so the writer thread never has to keep up
+    SAFECaptureFile captureFile;
+    captureFile.prepare (1, 1, numSamples + blockSize);
+
+    if (! captureFile.start())
+    {
+        return Result::fail ("Couldn't create a capture file");
+    }
+
+    for (int start = 0; start < numSamples; start += blockSize)
+    {
+        const int numThisTime = jmin (blockSize, numSamples - start);
+        float* unprocessed = recording.getWritePointer (0);
+        float* processed = recording.getWritePointer (1);
+
+        captureFile.addUnprocessedSamples (AudioSampleBuffer (&unprocessed, 1, start, numThisTime));
+        captureFile.addProcessedSamples (AudioSampleBuffer (&processed, 1, start, numThisTime));
+    }
+
+    if (! captureFile.stop() || captureFile.getNumSamples() != numSamples)
+    {
+        captureFile.deleteFile();
+        return Result::fail ("The capture file dropped samples");
+    }
+
+    const double analysisSampleRate = sampleRate / factor;
+    OwnedArray <SAFEFeatureExtractor> inMemory, chunked;
+    HeapBlock <double> decimatedFrame (frameLength);
+
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        inMemory.add (new SAFEFeatureExtractor);
+        inMemory [channel]->initialise (numFrames, frameLength, analysisSampleRate);
+        chunked.add (new SAFEFeatureExtractor);
+        chunked [channel]->initialise (numFrames, frameLength, analysisSampleRate);
+    }
+
+    for (int frame = 0; frame < numFrames; ++frame)
+    {
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            decimator.decimate (recording.getReadPointer (channel), numSamples, frame * frameLength, decimatedFrame, frameLength);
+            inMemory [channel]->analyseFrame (decimatedFrame, frameLength, frame);
+        }
+    }
+
+    const int margin = decimator.getStretchMargin();
+    const int chunkLength = numFramesPerChunk * frameSamples + 2 * margin;
+    AudioSampleBuffer chunk (2, chunkLength);
+    int numChunks = 0;
+
+    for (int firstFrame = 0; firstFrame < numFrames; firstFrame += numFramesPerChunk)
+    {
+        if (! captureFile.readSamples (chunk, (int64) firstFrame * frameSamples - margin, chunkLength))
+        {
+            captureFile.deleteFile();
+            return Result::fail ("Couldn't read the capture file");
+        }
+
+        const int numChunkFrames = jmin (numFramesPerChunk, numFrames - firstFrame);
+
+        for (int frame = 0; frame < numChunkFrames; ++frame)
+        {
+            for (int channel = 0; channel < 2; ++channel)
+            {
+                decimator.decimate (chunk.getReadPointer (channel), chunkLength, (margin + frame * frameSamples) / factor,
+                                    decimatedFrame, frameLength);
+                chunked [channel]->analyseFrame (decimatedFrame, frameLength, firstFrame + frame);
+            }
+        }
+
+        ++numChunks;
+    }
+
+    captureFile.deleteFile();
+
+    measurement = String (numFrames) + " frames in " + String (numChunks) + " chunks";
+
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        if (! (*chunked [channel] == *inMemory [channel]))
+        {
+            return Result::fail ("The features of the chunked recording differ from the in memory ones");
+        }
+    }
+
+    return Result::ok();
+}
+
+Result ModuleChecks::checkFilterResponses (String& measurement)
+{
+    // the frequencies of a filter graph's points, an odd number of them so the
+    // last one goes through the scalar code
+    const int numFrequencies = 771;
+    HeapBlock <double> frequencies (numFrequencies);
+
+    for (int i = 0; i < numFrequencies; ++i)
+    {
+        frequencies [i] = 20.0 * std::pow (1000.0, i / (numFrequencies - 1.0));
+    }
+
+    HeapBlock <double> unitDelayReal (numFrequencies), unitDelayImag (numFrequencies);
+    HeapBlock <double> magnitudes (numFrequencies), phases (numFrequencies);
+
+    double worstErrorDb = 0, worstPhaseError = 0;
+    const double sampleRates [] = {44100.0, 192000.0};
+
+    for (int r = 0; r < numElementsInArray (sampleRates); ++r)
+    {
+        const double sampleRate = sampleRates [r];
+        FilterInfo::makeUnitDelayTable (frequencies, sampleRate, unitDelayReal, unitDelayImag, numFrequencies);
+
+        // the sort of filters the plug-ins draw, with low shelves at high sample
+        // rates being the hardest on the precision
+        Array <FilterInfo> filters;
+        const IIRCoefficients sections [] = {IIRCoefficients::makeLowShelf (sampleRate, 30.0, 0.71, 4.0),
+                                             IIRCoefficients::makeHighShelf (sampleRate, 10000.0, 0.71, 0.25),
+                                             IIRCoefficients::makePeakFilter (sampleRate, 1000.0, 2.0, 2.0),
+                                             IIRCoefficients::makeLowPass (sampleRate, 5000.0),
+                                             IIRCoefficients::makeHighPass (sampleRate, 20.0)};
+
+        for (int i = 0; i < numElementsInArray (sections); ++i)
+        {
+            FilterInfo filter;
+            filter.setSampleRate (sampleRate);
+            filter.setCoefficients (sections [i]);
+            filters.add (filter);
+        }
+
+        // and a fourth order one, a low pass and a peak in series
+        {
+            const float* a = sections [3].coefficients;
+            const float* b = sections [2].coefficients;
+            Array <double> numerator, denominator;
+
+            numerator.add (a [0] * b [0]);
+            numerator.add (a [0] * b [1] + a [1] * b [0]);
+            numerator.add (a [0] * b [2] + a [1] * b [1] + a [2] * b [0]);
+            numerator.add (a [1] * b [2] + a [2] * b [1]);
+            numerator.add (a [2] * b [2]);
+
+            denominator.add (1.0);
+            denominator.add (a [3] + b [3]);
+            denominator.add (a [4] + a [3] * b [3] + b [4]);
+            denominator.add (a [3] * b [4] + a [4] * b [3]);
+            denominator.add (a [4] * b [4]);
+
+            FilterInfo filter;
+            filter.setSampleRate (sampleRate);
+            filter.setCoefficients (numerator, denominator);
+            filter.setGain (0.5);
+            filters.add (filter);
+        }
+
+        for (int f = 0; f < filters.size(); ++f)
+        {
+            filters.getReference (f).getResponses (unitDelayReal, unitDelayImag, magnitudes, phases, numFrequencies);
+
+            for (int i = 0; i < numFrequencies; ++i)
+            {
+                const FilterResponse response = filters.getReference (f).getResponse (frequencies [i]);
+                const double errorDb = std::abs (toDb (magnitudes [i]) - toDb (response.magnitudeValue));
+                const double phaseError = std::abs (std::remainder (phases [i] - response.phaseValue, 2.0 * double_Pi));
+
+                worstErrorDb = jmax (worstErrorDb, errorDb);
+                worstPhaseError = jmax (worstPhaseError, phaseError);
+            }
+        }
+    }
+
+    measurement = String (worstErrorDb, 8) + " dB, " + String (worstPhaseError, 8) + " rad";
+
+    if (worstErrorDb > maximumResponseErrorDb || worstPhaseError > maximumPhaseError)
+    {
+        return Result::fail ("getResponses() should be within " + String (maximumResponseErrorDb, 8) + " dB and "
+                              + String (maximumPhaseError, 8) + " rad of getResponse()");
+    }
+
+    return Result::ok();
+}
+
+//==============================================================================
+void ModuleChecks::getDecimatorCoefficients (const Decimator& decimator, Array <double>& coefficients)
+{
+    const int factor = decimator.getDecimationFactor();
+    const int delay = decimator.getDelay();
+    const int numTaps = 2 * delay + 1;
+
+    // an impulse at each phase, far enough in that the filter doesn't run off the
+    // start, picks out every factor'th tap
+    const int impulseStart = decimator.getStretchMargin();
+    const int numInputSamples = 2 * impulseStart + factor;
+    const int numOutputSamples = numInputSamples / factor + 1;
+
+    HeapBlock <float> input (numInputSamples, true);
+    HeapBlock <double> output (numOutputSamples);
+
+    coefficients.clearQuick();
+    coefficients.insertMultiple (0, 0.0, numTaps);
+
+    for (int phase = 0; phase < factor; ++phase)
+    {
+        const int impulse = impulseStart + phase;
+        input [impulse] = 1.0f;
+
+        decimator.decimate (input, numInputSamples, 0, output, numOutputSamples);
+
+        for (int n = 0; n < numOutputSamples; ++n)
+        {
+            const int tap = impulse - n * factor + delay;
+
+            if (isPositiveAndBelow (tap, numTaps))
+            {
+                coefficients.set (tap, output [n]);
+            }
+        }
+
+        input [impulse] = 0.0f;
+    }
+}
@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+    ModuleChecks.h
+
+    Checks of parts of the SAFE module whose claims a plug-in render wouldn't
+    show up, run alongside the regression tests.
+
+  ==============================================================================
+*/
+
+#ifndef MODULECHECKS_H_INCLUDED
+#define MODULECHECKS_H_INCLUDED
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+//==============================================================================
+/**
+    Runs checks on the SAFE module's DSP by name.
+
+    The regression tests only compare plug-ins with their own earlier output,
+    so they can't tell whether a filter meets its specification or whether two
+    ways of working something out agree. These checks measure that directly,
+    each against a fixed limit, so they need no reference files.
+*/
+class ModuleChecks
+{
+public:
+    //==============================================================================
+    /** Returns the names of the checks run() can do. */
+    static StringArray getNames();
+
+    /** Runs a check.
+
+        @param name         the name of the check, one of getNames()
+        @param measurement  set to a short description of what was measured,
+                            to show next to the result
+        @returns            a failure if the check didn't pass
+    */
+    static Result run (const String& name, String& measurement);
+
+private:
+    //==============================================================================
+    static Result checkDecimatorStopband (String& measurement);
+    static Result checkDecimatorDelay (String& measurement);
+    static Result checkChunkedAnalysis (String& measurement);
+    static Result checkFilterResponses (String& measurement);
+
+    /** Works out a decimator's filter from its response to impulses. */
+    static void getDecimatorCoefficients (const Decimator& decimator, Array <double>& coefficients);
+};
+
+
+#endif  // MODULECHECKS_H_INCLUDED
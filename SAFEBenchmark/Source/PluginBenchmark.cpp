@@ -0,0 +1,179 @@
+/*
+  ==============================================================================
+
+    PluginBenchmark.cpp
+
+  ==============================================================================
+*/
+
+#include "PluginBenchmark.h"
+
+//==============================================================================
+PluginBenchmark::PluginBenchmark (const BenchmarkPlugin& pluginToBenchmark, double sampleRateInit, int blockSizeInit,
+                                  int numChannelsInit, bool automateParametersInit)
+    : plugin (pluginToBenchmark),
+      sampleRate (sampleRateInit),
+      blockSize (blockSizeInit),
+      numChannels (numChannelsInit),
+      automateParameters (automateParametersInit),
+      inputPosition (0),
+      samplesProcessed (0),
+      totalSeconds (0)
+{
+    generateInputSignal();
+    buffer.setSize (numChannels, blockSize);
+
+    processor = plugin.createProcessor();
+    processor->setPlayConfigDetails (numChannels, numChannels, sampleRate, blockSize);
+    processor->prepareToPlay (sampleRate, blockSize);
+}
+
+PluginBenchmark::~PluginBenchmark()
+{
+    processor->releaseResources();
+}
+
+//==============================================================================
+void PluginBenchmark::run (double secondsToProcess)
+{
+    const int numWarmUpBlocks = jmax (8, (int) (0.1 * sampleRate / blockSize));
+    const int numTimedBlocks = jmax (16, (int) (secondsToProcess * sampleRate / blockSize));
+
+    for (int block = 0; block < numWarmUpBlocks; ++block)
+    {
+        processNextBlock();
+    }
+
+    // only count the timed blocks in the processor's own stage timings
+    if (SAFEAudioProcessor* safeProcessor = dynamic_cast <SAFEAudioProcessor*> (processor.get()))
+    {
+        safeProcessor->getProcessTimer().reset();
+    }
+
+    blockNanosecondsPerSample.clearQuick();
+    blockNanosecondsPerSample.ensureStorageAllocated (numTimedBlocks);
+    totalSeconds = 0;
+
+    for (int block = 0; block < numTimedBlocks; ++block)
+    {
+        const double blockSeconds = processNextBlock();
+
+        totalSeconds += blockSeconds;
+        blockNanosecondsPerSample.add (blockSeconds * 1.0e9 / blockSize);
+    }
+}
+
+var PluginBenchmark::getResults() const
+{
+    Array <double> sortedTimes (blockNanosecondsPerSample);
+    DefaultElementComparator <double> comparator;
+    sortedTimes.sort (comparator);
+
+    const int numBlocks = sortedTimes.size();
+    const double audioSeconds = (double) numBlocks * blockSize / sampleRate;
+    const double meanNanosecondsPerSample = numBlocks > 0 ? totalSeconds * 1.0e9 / ((double) numBlocks * blockSize) : 0;
+
+    DynamicObject* timings = new DynamicObject();
+    timings->setProperty ("mean", meanNanosecondsPerSample);
+    timings->setProperty ("min", getPercentile (sortedTimes, 0));
+    timings->setProperty ("p50", getPercentile (sortedTimes, 50));
+    timings->setProperty ("p90", getPercentile (sortedTimes, 90));
+    timings->setProperty ("p99", getPercentile (sortedTimes, 99));
+    timings->setProperty ("max", getPercentile (sortedTimes, 100));
+
+    // the fraction of the real time budget used by the slowest block
+    const double blockBudgetNanoseconds = 1.0e9 / sampleRate;
+
+    DynamicObject* result = new DynamicObject();
+    result->setProperty ("plugin", plugin.name);
+    result->setProperty ("sampleRate", sampleRate);
+    result->setProperty ("blockSize", blockSize);
+    result->setProperty ("channels", numChannels);
+    result->setProperty ("automation", automateParameters);
+    result->setProperty ("declaredChannelConfiguration", plugin.supportsChannels (numChannels));
+    result->setProperty ("blocks", numBlocks);
+    result->setProperty ("nsPerSample", var (timings));
+    result->setProperty ("realTimeFactor", totalSeconds > 0 ? audioSeconds / totalSeconds : 0);
+    result->setProperty ("peakBlockLoad", getPercentile (sortedTimes, 100) / blockBudgetNanoseconds);
+
+    if (SAFEAudioProcessor* safeProcessor = dynamic_cast <SAFEAudioProcessor*> (processor.get()))
+    {
+        // the plug-in's own breakdown of where the time went
+        const var processTimings = safeProcessor->getProcessTimer().toVar();
+
+        result->setProperty ("stages", processTimings.getProperty ("stages", var::null));
+        result->setProperty ("deadlineMisses", processTimings.getProperty ("deadlineMisses", var::null));
+    }
+
+    return var (result);
+}
+
+//==============================================================================
+void PluginBenchmark::generateInputSignal()
+{
+    // one second of the chord signal, looped
+    inputSignal.setSize (numChannels, (int) sampleRate);
+    TestSignal::generate ("chord", inputSignal, sampleRate);
+}
+
+double PluginBenchmark::processNextBlock()
+{
+    if (automateParameters)
+    {
+        moveParameters();
+    }
+
+    const int inputLength = inputSignal.getNumSamples();
+    int samplesCopied = 0;
+
+    while (samplesCopied < blockSize)
+    {
+        const int samplesToCopy = jmin (blockSize - samplesCopied, inputLength - inputPosition);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            buffer.copyFrom (channel, samplesCopied, inputSignal, channel, inputPosition, samplesToCopy);
+        }
+
+        samplesCopied += samplesToCopy;
+        inputPosition = (inputPosition + samplesToCopy) % inputLength;
+    }
+
+    midiMessages.clear();
+
+    // Time::getHighResolutionTicks() only counts microseconds on Linux, which
+    // is too coarse for small blocks, so use the standard library clock
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    processor->processBlock (buffer, midiMessages);
+    const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    samplesProcessed += blockSize;
+
+    return std::chrono::duration <double> (end - start).count();
+}
+
+void PluginBenchmark::moveParameters()
+{
+    // each parameter follows a slow sine wave, with its own phase, as if
+    // it were being automated by the host
+    const double time = samplesProcessed / sampleRate;
+    const int numParameters = processor->getNumParameters();
+
+    for (int i = 0; i < numParameters; ++i)
+    {
+        const double phase = 2.0 * double_Pi * (0.5 * time + (double) i / numParameters);
+        processor->setParameter (i, (float) (0.5 + 0.4 * std::sin (phase)));
+    }
+}
+
+double PluginBenchmark::getPercentile (const Array <double>& sortedValues, double percentile) const
+{
+    if (sortedValues.size() == 0)
+    {
+        return 0;
+    }
+
+    const int index = roundToInt (percentile / 100.0 * (sortedValues.size() - 1));
+
+    return sortedValues [index];
+}
@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+    PluginBenchmark.h
+
+    Times a SAFE plug-in's processBlock() for one combination of sample rate,
+    block size and channel count.
+
+  ==============================================================================
+*/
+
+#ifndef PLUGINBENCHMARK_H_INCLUDED
+#define PLUGINBENCHMARK_H_INCLUDED
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "BenchmarkPlugins.h"
+#include "TestSignal.h"
+
+#include <chrono>
+
+//==============================================================================
+/**
+    Runs a plug-in headlessly and measures how long each block takes.
+
+    A fresh instance of the plug-in is created and prepared for each
+    benchmark so earlier runs can't affect the result. The input is a fixed,
+    seeded mix of tones and noise, so runs on different builds see the same
+    signal.
+*/
+class PluginBenchmark
+{
+public:
+    //==============================================================================
+    /** Creates a plug-in instance and prepares it to play.
+
+        @param plugin              the plug-in to benchmark
+        @param sampleRate          the sample rate to run at
+        @param blockSize           the number of samples passed to each processBlock() call
+        @param numChannels         the number of input and output channels
+        @param automateParameters  if true every parameter is moved between blocks,
+                                   so the cost of parameter smoothing is included
+    */
+    PluginBenchmark (const BenchmarkPlugin& plugin, double sampleRate, int blockSize,
+                     int numChannels, bool automateParameters);
+
+    /** Destructor. */
+    ~PluginBenchmark();
+
+    //==============================================================================
+    /** Processes some audio, timing each block.
+
+        Only the processBlock() calls are timed, not filling the buffer with
+        input or moving the automated parameters.
+
+        A short stretch of audio is processed first and not timed, so the
+        plug-in's filters and buffers are in a steady state.
+
+        @param secondsToProcess  how much audio to time, at least 16 blocks are always timed
+    */
+    void run (double secondsToProcess);
+
+    /** Returns the results of the last run() as an object ready to be
+        written as JSON. */
+    var getResults() const;
+
+private:
+    //==============================================================================
+    const BenchmarkPlugin& plugin;
+    ScopedPointer <AudioProcessor> processor;
+
+    double sampleRate;
+    int blockSize, numChannels;
+    bool automateParameters;
+
+    AudioSampleBuffer inputSignal, buffer;
+    MidiBuffer midiMessages;
+    int inputPosition;
+    int64 samplesProcessed;
+
+    Array <double> blockNanosecondsPerSample;
+    double totalSeconds;
+
+    void generateInputSignal();
+    double processNextBlock();
+    void moveParameters();
+
+    double getPercentile (const Array <double>& sortedValues, double percentile) const;
+
+    JUCE_DECLARE_NON_COPYABLE (PluginBenchmark)
+};
+
+
+#endif  // PLUGINBENCHMARK_H_INCLUDED
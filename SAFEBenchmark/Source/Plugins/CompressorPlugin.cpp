@@ -0,0 +1,29 @@
+/*
+  ==============================================================================
+
+    CompressorPlugin.cpp
+
+    Builds the SAFECompressor processor into the benchmark.
+
+  ==============================================================================
+*/
+
+#define createPluginFilter createCompressorProcessor
+
+#include "../../../SAFECompressor/Source/PluginProcessor.cpp"
+#include "../../../SAFECompressor/Source/PluginEditor.cpp"
+
+#undef createPluginFilter
+
+#include "../BenchmarkPlugins.h"
+
+//==============================================================================
+static const short compressorChannelConfigurations [][2] = { JucePlugin_PreferredChannelConfigurations };
+
+const BenchmarkPlugin compressorPlugin =
+{
+    JucePlugin_Name,
+    createCompressorProcessor,
+    compressorChannelConfigurations,
+    numElementsInArray (compressorChannelConfigurations)
+};
@@ -0,0 +1,29 @@
+/*
+  ==============================================================================
+
+    DistortionPlugin.cpp
+
+    Builds the SAFEDistortion processor into the benchmark.
+
+  ==============================================================================
+*/
+
+#define createPluginFilter createDistortionProcessor
+
+#include "../../../SAFEDistortion/Source/PluginProcessor.cpp"
+#include "../../../SAFEDistortion/Source/PluginEditor.cpp"
+
+#undef createPluginFilter
+
+#include "../BenchmarkPlugins.h"
+
+//==============================================================================
+static const short distortionChannelConfigurations [][2] = { JucePlugin_PreferredChannelConfigurations };
+
+const BenchmarkPlugin distortionPlugin =
+{
+    JucePlugin_Name,
+    createDistortionProcessor,
+    distortionChannelConfigurations,
+    numElementsInArray (distortionChannelConfigurations)
+};
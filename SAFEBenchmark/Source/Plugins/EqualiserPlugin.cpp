@@ -0,0 +1,29 @@
+/*
+  ==============================================================================
+
+    EqualiserPlugin.cpp
+
+    Builds the SAFEEqualiser processor into the benchmark.
+
+  ==============================================================================
+*/
+
+#define createPluginFilter createEqualiserProcessor
+
+#include "../../../SAFEEqualiser/Source/PluginProcessor.cpp"
+#include "../../../SAFEEqualiser/Source/PluginEditor.cpp"
+
+#undef createPluginFilter
+
+#include "../BenchmarkPlugins.h"
+
+//==============================================================================
+static const short equaliserChannelConfigurations [][2] = { JucePlugin_PreferredChannelConfigurations };
+
+const BenchmarkPlugin equaliserPlugin =
+{
+    JucePlugin_Name,
+    createEqualiserProcessor,
+    equaliserChannelConfigurations,
+    numElementsInArray (equaliserChannelConfigurations)
+};
@@ -0,0 +1,29 @@
+/*
+  ==============================================================================
+
+    HarmonicsPlugin.cpp
+
+    Builds the SAFEHarmonics processor into the benchmark.
+
+  ==============================================================================
+*/
+
+#define createPluginFilter createHarmonicsProcessor
+
+#include "../../../SAFEHarmonics/Source/PluginProcessor.cpp"
+#include "../../../SAFEHarmonics/Source/PluginEditor.cpp"
+
+#undef createPluginFilter
+
+#include "../BenchmarkPlugins.h"
+
+//==============================================================================
+static const short harmonicsChannelConfigurations [][2] = { JucePlugin_PreferredChannelConfigurations };
+
+const BenchmarkPlugin harmonicsPlugin =
+{
+    JucePlugin_Name,
+    createHarmonicsProcessor,
+    harmonicsChannelConfigurations,
+    numElementsInArray (harmonicsChannelConfigurations)
+};
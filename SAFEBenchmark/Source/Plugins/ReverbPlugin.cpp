@@ -0,0 +1,29 @@
+/*
+  ==============================================================================
+
+    ReverbPlugin.cpp
+
+    Builds the SAFEReverb processor into the benchmark.
+
+  ==============================================================================
+*/
+
+#define createPluginFilter createReverbProcessor
+
+#include "../../../SAFEReverb/Source/PluginProcessor.cpp"
+#include "../../../SAFEReverb/Source/PluginEditor.cpp"
+
+#undef createPluginFilter
+
+#include "../BenchmarkPlugins.h"
+
+//==============================================================================
+static const short reverbChannelConfigurations [][2] = { JucePlugin_PreferredChannelConfigurations };
+
+const BenchmarkPlugin reverbPlugin =
+{
+    JucePlugin_Name,
+    createReverbProcessor,
+    reverbChannelConfigurations,
+    numElementsInArray (reverbChannelConfigurations)
+};
@@ -0,0 +1,275 @@
+/*
+  ==============================================================================
+
+    RegressionTest.cpp
+
+  ==============================================================================
+*/
+
+#include "RegressionTest.h"
+#include "FloatWavFile.h"
+#include "TestSignal.h"
+
+#include <chrono>
+
+//==============================================================================
+RegressionTest::RegressionTest (const File& scriptFileInit)
+    : maxErrorDb (-200.0),
+      maxUlps (0),
+      residualDb (-200.0),
+      numSamplesOutOfTolerance (0),
+      cpuSeconds (0),
+      scriptFile (scriptFileInit),
+      sampleRate (44100),
+      seconds (0.5),
+      blockSize (256),
+      numChannels (2)
+{
+}
+
+RegressionTest::~RegressionTest()
+{
+}
+
+//==============================================================================
+Result RegressionTest::load (const RegressionTolerances& defaultTolerances)
+{
+    ScopedPointer <XmlElement> script (XmlDocument::parse (scriptFile));
+
+    if (script == nullptr || ! script->hasTagName ("RegressionTest"))
+    {
+        return Result::fail (scriptFile.getFileName() + " is not a regression test script");
+    }
+
+    pluginName = script->getStringAttribute ("Plugin");
+    signalName = script->getStringAttribute ("Signal", "chord");
+    sampleRate = script->getDoubleAttribute ("SampleRate", 44100);
+    blockSize = script->getIntAttribute ("BlockSize", 256);
+    numChannels = script->getIntAttribute ("Channels", 2);
+    seconds = script->getDoubleAttribute ("Seconds", 0.5);
+
+    tolerances.maxUlps = script->getIntAttribute ("MaxUlps", defaultTolerances.maxUlps);
+    tolerances.maxErrorDb = script->getDoubleAttribute ("MaxErrorDb", defaultTolerances.maxErrorDb);
+
+    if (! TestSignal::getNames().contains (signalName))
+    {
+        return Result::fail (scriptFile.getFileName() + " uses an unknown signal: " + signalName);
+    }
+
+    if (sampleRate <= 0 || blockSize <= 0 || numChannels <= 0 || seconds <= 0)
+    {
+        return Result::fail (scriptFile.getFileName() + " needs a positive sample rate, block size, channel count and length");
+    }
+
+    parameterChanges.clearQuick();
+
+    forEachXmlChildElementWithTagName (*script, parameterXml, "Parameter")
+    {
+        ParameterChange change;
+        change.time = parameterXml->getDoubleAttribute ("Time");
+        change.name = parameterXml->getStringAttribute ("Name");
+        change.value = (float) parameterXml->getDoubleAttribute ("Value");
+
+        parameterChanges.add (change);
+    }
+
+    ParameterChangeComparator comparator;
+    parameterChanges.sort (comparator, true);
+
+    return Result::ok();
+}
+
+String RegressionTest::getName() const
+{
+    return scriptFile.getFileNameWithoutExtension();
+}
+
+String RegressionTest::getPluginName() const
+{
+    return pluginName;
+}
+
+File RegressionTest::getReferenceFile() const
+{
+    return scriptFile.withFileExtension ("wav");
+}
+
+//==============================================================================
+Result RegressionTest::render (const BenchmarkPlugin& plugin)
+{
+    ScopedPointer <AudioProcessor> processor (plugin.createProcessor());
+    SAFEAudioProcessor* safeProcessor = dynamic_cast <SAFEAudioProcessor*> (processor.get());
+
+    // find the parameters before processing anything, so a typo in
+    // the script fails the test straight away
+    Array <int> parameterIndices;
+
+    for (int i = 0; i < parameterChanges.size(); ++i)
+    {
+        int index = -1;
+
+        for (int p = 0; p < processor->getNumParameters(); ++p)
+        {
+            if (processor->getParameterName (p).equalsIgnoreCase (parameterChanges [i].name))
+            {
+                index = p;
+                break;
+            }
+        }
+
+        if (index < 0 || safeProcessor == nullptr)
+        {
+            return Result::fail (plugin.name + String (" has no parameter called ") + parameterChanges [i].name);
+        }
+
+        parameterIndices.add (index);
+    }
+
+    processor->setPlayConfigDetails (numChannels, numChannels, sampleRate, blockSize);
+    processor->prepareToPlay (sampleRate, blockSize);
+
+    output.setSize (numChannels, roundToInt (seconds * sampleRate));
+    TestSignal::generate (signalName, output, sampleRate);
+
+    MidiBuffer midiMessages;
+    int nextChange = 0;
+    cpuSeconds = 0;
+
+    for (int start = 0; start < output.getNumSamples(); start += blockSize)
+    {
+        const int numSamples = jmin (blockSize, output.getNumSamples() - start);
+
+        // the changes are in time order, make any which are due
+        while (nextChange < parameterChanges.size() && roundToInt (parameterChanges [nextChange].time * sampleRate) <= start)
+        {
+            safeProcessor->setScaledParameter (parameterIndices [nextChange], parameterChanges [nextChange].value);
+            ++nextChange;
+        }
+
+        // process the output buffer in place, a block at a time
+        AudioSampleBuffer block (output.getArrayOfWritePointers(), numChannels, start, numSamples);
+        midiMessages.clear();
+
+        const std::chrono::steady_clock::time_point blockStart = std::chrono::steady_clock::now();
+        processor->processBlock (block, midiMessages);
+        const std::chrono::steady_clock::time_point blockEnd = std::chrono::steady_clock::now();
+
+        cpuSeconds += std::chrono::duration <double> (blockEnd - blockStart).count();
+    }
+
+    processor->releaseResources();
+
+    return Result::ok();
+}
+
+Result RegressionTest::writeReference() const
+{
+    return FloatWavFile::write (getReferenceFile(), output, sampleRate);
+}
+
+Result RegressionTest::compareWithReference()
+{
+    AudioSampleBuffer reference;
+    double referenceSampleRate = 0;
+
+    const Result loaded = FloatWavFile::read (getReferenceFile(), reference, referenceSampleRate);
+
+    if (loaded.failed())
+    {
+        return loaded;
+    }
+
+    if (reference.getNumChannels() != output.getNumChannels() || reference.getNumSamples() != output.getNumSamples()
+          || roundToInt (referenceSampleRate) != roundToInt (sampleRate))
+    {
+        return Result::fail ("The reference has a different format to the render, record it again");
+    }
+
+    const float maxErrorGain = Decibels::decibelsToGain ((float) tolerances.maxErrorDb, -1000.0f);
+    double sumOfSquaredDifferences = 0, sumOfSquaredReference = 0;
+    float maxError = 0;
+
+    maxUlps = 0;
+    numSamplesOutOfTolerance = 0;
+
+    for (int channel = 0; channel < output.getNumChannels(); ++channel)
+    {
+        const float* rendered = output.getReadPointer (channel);
+        const float* expected = reference.getReadPointer (channel);
+
+        for (int i = 0; i < output.getNumSamples(); ++i)
+        {
+            const float error = std::abs (rendered [i] - expected [i]);
+            const int64 ulps = getUlpDistance (rendered [i], expected [i]);
+
+            // NaNs compare false, so count them as out of tolerance explicitly
+            if (rendered [i] != rendered [i] || (ulps > tolerances.maxUlps && ! (error <= maxErrorGain)))
+            {
+                ++numSamplesOutOfTolerance;
+            }
+
+            maxError = jmax (maxError, error);
+            maxUlps = jmax (maxUlps, ulps);
+
+            sumOfSquaredDifferences += (double) error * error;
+            sumOfSquaredReference += (double) expected [i] * expected [i];
+        }
+    }
+
+    maxErrorDb = Decibels::gainToDecibels ((double) maxError, -200.0);
+
+    // the level of the null test, relative to the reference
+    if (sumOfSquaredDifferences > 0 && sumOfSquaredReference > 0)
+    {
+        residualDb = jmax (-200.0, 10.0 * std::log10 (sumOfSquaredDifferences / sumOfSquaredReference));
+    }
+    else
+    {
+        residualDb = sumOfSquaredDifferences > 0 ? 0.0 : -200.0;
+    }
+
+    if (numSamplesOutOfTolerance > 0)
+    {
+        return Result::fail (String (numSamplesOutOfTolerance) + " samples are out of tolerance");
+    }
+
+    return Result::ok();
+}
+
+var RegressionTest::getResults() const
+{
+    const double audioSeconds = output.getNumSamples() / sampleRate;
+
+    DynamicObject* result = new DynamicObject();
+    result->setProperty ("test", getName());
+    result->setProperty ("plugin", pluginName);
+    result->setProperty ("signal", signalName);
+    result->setProperty ("sampleRate", sampleRate);
+    result->setProperty ("blockSize", blockSize);
+    result->setProperty ("channels", numChannels);
+    result->setProperty ("maxUlpsAllowed", tolerances.maxUlps);
+    result->setProperty ("maxErrorDbAllowed", tolerances.maxErrorDb);
+    result->setProperty ("maxErrorDb", maxErrorDb);
+    result->setProperty ("maxUlps", maxUlps);
+    result->setProperty ("residualDb", residualDb);
+    result->setProperty ("samplesOutOfTolerance", numSamplesOutOfTolerance);
+    result->setProperty ("cpuSeconds", cpuSeconds);
+    result->setProperty ("realTimeFactor", cpuSeconds > 0 ? audioSeconds / cpuSeconds : 0);
+
+    return var (result);
+}
+
+//==============================================================================
+int64 RegressionTest::getUlpDistance (float a, float b)
+{
+    // map the floats onto integers which are in the same order, so the
+    // distance between them counts the floats in between
+    union { float f; int32 i; } aBits, bBits;
+    aBits.f = a;
+    bBits.f = b;
+
+    const int64 aOrdered = aBits.i >= 0 ? (int64) aBits.i : (int64) std::numeric_limits <int32>::min() - aBits.i;
+    const int64 bOrdered = bBits.i >= 0 ? (int64) bBits.i : (int64) std::numeric_limits <int32>::min() - bBits.i;
+
+    return aOrdered > bOrdered ? aOrdered - bOrdered : bOrdered - aOrdered;
+}
@@ -0,0 +1,149 @@
+/*
+  ==============================================================================
+
+    RegressionTest.h
+
+    Renders a test signal through a plug-in, following a script of parameter
+    changes, and compares the output with a reference render.
+
+  ==============================================================================
+*/
+
+#ifndef REGRESSIONTEST_H_INCLUDED
+#define REGRESSIONTEST_H_INCLUDED
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "BenchmarkPlugins.h"
+
+//==============================================================================
+/** How far a render may stray from its reference and still pass.
+
+    Each sample passes if it is within maxUlps units in the last place of the
+    reference sample, or if the difference is no louder than maxErrorDb. The
+    ULP check allows for rounding in loud samples and the level check stops
+    tiny differences in near silent samples from failing.
+*/
+struct RegressionTolerances
+{
+    RegressionTolerances()
+        : maxUlps (16),
+          maxErrorDb (-120.0)
+    {
+    }
+
+    int maxUlps;
+    double maxErrorDb;
+};
+
+//==============================================================================
+/**
+    A regression test for one plug-in, loaded from an XML script.
+
+    The script names the plug-in and the signal to render, and lists parameter
+    changes in the plug-in's own units, e.g.
+
+    @code
+    <RegressionTest Plugin="SAFECompressor" Signal="chord" SampleRate="44100"
+                    BlockSize="256" Channels="2" Seconds="0.5">
+      <Parameter Time="0" Name="Threshold" Value="-30"/>
+      <Parameter Time="0.25" Name="Ratio" Value="8"/>
+    </RegressionTest>
+    @endcode
+
+    Parameter changes are made at the start of the first block at or after
+    their time, as a host would make them. The script may also give its own
+    MaxUlps and MaxErrorDb tolerances. The reference render is kept next to
+    the script, as a float WAV file with the same name.
+*/
+class RegressionTest
+{
+public:
+    //==============================================================================
+    /** Creates a test from a script, call load() to read it. */
+    explicit RegressionTest (const File& scriptFile);
+
+    /** Destructor. */
+    ~RegressionTest();
+
+    //==============================================================================
+    /** Reads the script.
+
+        @param defaultTolerances  the tolerances to use if the script doesn't set its own
+    */
+    Result load (const RegressionTolerances& defaultTolerances);
+
+    /** Returns the name of the test, taken from its script's file name. */
+    String getName() const;
+
+    /** Returns the name of the plug-in the script tests. */
+    String getPluginName() const;
+
+    /** Returns the file the reference render is kept in. */
+    File getReferenceFile() const;
+
+    //==============================================================================
+    /** Renders the test signal through a new instance of the plug-in, timing
+        each processBlock() call. */
+    Result render (const BenchmarkPlugin& plugin);
+
+    /** Writes the last render as the test's reference. */
+    Result writeReference() const;
+
+    /** Compares the last render with the reference, returning a failure if
+        the reference can't be read or the render isn't within tolerance. */
+    Result compareWithReference();
+
+    /** Returns the results of the last render and comparison as an object
+        ready to be written as JSON. */
+    var getResults() const;
+
+    //==============================================================================
+    /** The size of the largest difference from the reference, in dBFS. */
+    double maxErrorDb;
+
+    /** The largest difference from the reference in units in the last place. */
+    int64 maxUlps;
+
+    /** The level of the render with the reference subtracted, relative to the
+        level of the reference, in dB. */
+    double residualDb;
+
+    /** The number of samples which weren't within tolerance. */
+    int numSamplesOutOfTolerance;
+
+    /** The time spent in processBlock(), in seconds. */
+    double cpuSeconds;
+
+private:
+    //==============================================================================
+    struct ParameterChange
+    {
+        double time;
+        String name;
+        float value;
+    };
+
+    struct ParameterChangeComparator
+    {
+        static int compareElements (const ParameterChange& first, const ParameterChange& second)
+        {
+            return first.time < second.time ? -1 : (first.time > second.time ? 1 : 0);
+        }
+    };
+
+    File scriptFile;
+    String pluginName, signalName;
+    double sampleRate, seconds;
+    int blockSize, numChannels;
+    RegressionTolerances tolerances;
+    Array <ParameterChange> parameterChanges;
+
+    AudioSampleBuffer output;
+
+    static int64 getUlpDistance (float a, float b);
+
+    JUCE_DECLARE_NON_COPYABLE (RegressionTest)
+};
+
+
+#endif  // REGRESSIONTEST_H_INCLUDED
@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+
+    TestSignal.cpp
+
+  ==============================================================================
+*/
+
+#include "TestSignal.h"
+
+//==============================================================================
+StringArray TestSignal::getNames()
+{
+    return StringArray::fromTokens ("chord,noise,sweep,impulses", ",", "");
+}
+
+bool TestSignal::generate (const String& name, AudioSampleBuffer& buffer, double sampleRate)
+{
+    if (name == "chord")
+    {
+        generateChord (buffer, sampleRate);
+    }
+    else if (name == "noise")
+    {
+        generateNoise (buffer);
+    }
+    else if (name == "sweep")
+    {
+        generateSweep (buffer, sampleRate);
+    }
+    else if (name == "impulses")
+    {
+        generateImpulses (buffer, sampleRate);
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+//==============================================================================
+void TestSignal::generateChord (AudioSampleBuffer& buffer, double sampleRate)
+{
+    // a slowly pulsing chord with some noise
+    Random random (0x5afe);
+
+    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+    {
+        float* samples = buffer.getWritePointer (channel);
+        const double detune = 1.0 + 0.01 * channel;
+
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+        {
+            const double time = i / sampleRate;
+            const double envelope = 0.55 + 0.45 * std::sin (2.0 * double_Pi * 2.0 * time);
+
+            const double tones = 0.3 * std::sin (2.0 * double_Pi * 110.0 * detune * time)
+                               + 0.2 * std::sin (2.0 * double_Pi * 440.0 * detune * time)
+                               + 0.1 * std::sin (2.0 * double_Pi * 3520.0 * detune * time);
+
+            samples [i] = (float) (envelope * tones + 0.05 * (random.nextDouble() * 2.0 - 1.0));
+        }
+    }
+}
+
+void TestSignal::generateNoise (AudioSampleBuffer& buffer)
+{
+    // white noise at -6 dBFS peak
+    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+    {
+        Random random (0x5afe + channel);
+        float* samples = buffer.getWritePointer (channel);
+
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+        {
+            samples [i] = (float) (0.5 * (random.nextDouble() * 2.0 - 1.0));
+        }
+    }
+}
+
+void TestSignal::generateSweep (AudioSampleBuffer& buffer, double sampleRate)
+{
+    // an exponential sine sweep from 20 Hz to 20 kHz, or just below nyquist
+    const double startFrequency = 20.0;
+    const double endFrequency = jmin (20000.0, 0.45 * sampleRate);
+    const double duration = buffer.getNumSamples() / sampleRate;
+    const double sweepRate = std::log (endFrequency / startFrequency) / duration;
+
+    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+    {
+        float* samples = buffer.getWritePointer (channel);
+        const double phaseOffset = 0.25 * double_Pi * channel;
+
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+        {
+            const double time = i / sampleRate;
+            const double phase = 2.0 * double_Pi * startFrequency * (std::exp (sweepRate * time) - 1.0) / sweepRate;
+
+            samples [i] = (float) (0.5 * std::sin (phase + phaseOffset));
+        }
+    }
+}
+
+void TestSignal::generateImpulses (AudioSampleBuffer& buffer, double sampleRate)
+{
+    // full scale clicks every 100 ms, a little later on each channel
+    const int spacing = jmax (1, roundToInt (0.1 * sampleRate));
+
+    buffer.clear();
+
+    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+    {
+        float* samples = buffer.getWritePointer (channel);
+
+        for (int i = channel; i < buffer.getNumSamples(); i += spacing)
+        {
+            samples [i] = 1.0f;
+        }
+    }
+}
@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    TestSignal.h
+
+    The fixed input signals the benchmarks and regression tests are run with.
+
+  ==============================================================================
+*/
+
+#ifndef TESTSIGNAL_H_INCLUDED
+#define TESTSIGNAL_H_INCLUDED
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+//==============================================================================
+/**
+    Generates test signals by name.
+
+    The signals are made from fixed seeds and formulas, so the same signal is
+    generated on every platform and in every build. Each channel gets a slightly
+    different version of the signal, so a plug-in which mixes up its channels
+    can't pass a regression test by chance.
+*/
+class TestSignal
+{
+public:
+    //==============================================================================
+    /** Returns the names of the signals generate() can make. */
+    static StringArray getNames();
+
+    /** Fills a buffer with a test signal.
+
+        The buffer should already be the size you want, the whole of it is written.
+
+        @param name        the name of the signal, one of getNames()
+        @param buffer      the buffer to fill
+        @param sampleRate  the sample rate to generate the signal at
+        @returns           false if there is no signal with that name
+    */
+    static bool generate (const String& name, AudioSampleBuffer& buffer, double sampleRate);
+
+private:
+    //==============================================================================
+    static void generateChord (AudioSampleBuffer& buffer, double sampleRate);
+    static void generateNoise (AudioSampleBuffer& buffer);
+    static void generateSweep (AudioSampleBuffer& buffer, double sampleRate);
+    static void generateImpulses (AudioSampleBuffer& buffer, double sampleRate);
+};
+
+
+#endif  // TESTSIGNAL_H_INCLUDED
@@ -12,6 +12,18 @@
 #include "PluginEditor.h"
 
 
+//==============================================================================
+static const SAFEParameterInfo parameterLayout [] =
+{
+    // name            initial  min     max      units  skew  dB     time   UI scale
+    {"Threshold",      0.0f,    -50.0f, 0.0f,    "dB",  1.0f, false, 100.0, 1.0f},
+    {"Ratio",          2.0f,    1.0f,   20.0f,   ":1",  0.4f, false, 100.0, 1.0f},
+    {"Knee",           0.0f,    0.0f,   20.0f,   "dB",  1.0f, false, 100.0, 1.0f},
+    {"Attack Time",    5.0f,    0.1f,   100.0f,  "ms",  1.0f, false, 100.0, 1.0f},
+    {"Release Time",   200.0f,  10.0f,  2000.0f, "ms",  1.0f, false, 100.0, 1.0f},
+    {"Make Up Gain",   0.0f,    0.0f,   20.0f,   "dB",  1.0f, false, 100.0, 1.0f}
+};
+
 //==============================================================================
 SafecompressorAudioProcessor::SafecompressorAudioProcessor()
     : inputBuffer (1, 1),
@@ -28,12 +40,12 @@ SafecompressorAudioProcessor::SafecompressorAudioProcessor()
     
     inputIndB = compIndB = outputIndB = compIndB_prev = 0;
     
-    addParameter ("Threshold", thresholdIndB, 0.0f, -50.0f, 0.0f, "dB");
-    addParameter ("Ratio", ratio, 2.0f, 1.0f, 20.0f, ":1", 0.4);
-    addParameter ("Knee", kneeIndB, 0.0f, 0.0f, 20.0f, "dB");
-    addParameter ("Attack Time", atimeInMs, 5.0f, 0.1f, 100.0f, "ms");
-    addParameter ("Release Time", rtimeInMs, 200.0f, 10.0f, 2000.0f, "ms");
-    addParameter ("Make Up Gain", makeUpGain, 0.0f, 0.0f, 20.0f, "dB"); 
+    float* const parameterValues [numParameters] = {&thresholdIndB, &ratio, &kneeIndB, &atimeInMs, &rtimeInMs, &makeUpGain};
+    addParameters <numParameters> (parameterLayout, parameterValues);
+    
+    // the make up gain is applied per sample so can follow its ramp,
+    // the rest are only read once per block so are stepped at the control rate
+    setParameterSmoothingMode (PARAMmakeUpGain, SAFEParameter::sampleRateSmoothing);
     
     rmsDetector.clear();
 }
@@ -94,6 +106,8 @@ void SafecompressorAudioProcessor::compress(AudioSampleBuffer &buffer)
 	alphaAttack  = exp (-1.0f / (0.001f * fs * atimeInMs));
 	alphaRelease = exp (-1.0f / (0.001f * fs * rtimeInMs));
 	
+    const float* makeUpGainRamp = getParameterRamp (PARAMmakeUpGain);
+    
 	for (int sample = 0 ; sample < numSamples ; ++sample) // sample by sample
 	{                
 	    rmsDetector.copyFrom (0, rmsCounter, buffer, 0, sample, 1);
@@ -125,11 +139,13 @@ void SafecompressorAudioProcessor::compress(AudioSampleBuffer &buffer)
 		else
            compIndB = alphaRelease * compIndB_prev + (1.0f - alphaRelease) * compIndB;
          
+        float currentMakeUpGain = makeUpGainRamp != nullptr ? makeUpGainRamp [sample] : makeUpGain;
+        
 		// Calculate control voltag
-		controlVoltage [sample] = Decibels::decibelsToGain (- compIndB + makeUpGain);
+		controlVoltage [sample] = Decibels::decibelsToGain (- compIndB + currentMakeUpGain);
 		compIndB_prev = compIndB;
 		
-		currentOutputLevel = inputIndB - compIndB + makeUpGain;
+		currentOutputLevel = inputIndB - compIndB + currentMakeUpGain;
 	}
 }
 
@@ -41,7 +41,9 @@ public:
         PARAMknee,
         PARAMatime,
         PARAMrtime,
-        PARAMmakeUpGain
+        PARAMmakeUpGain,
+        
+        numParameters
 	}; 
 	
 	void compress (AudioSampleBuffer &buffer);
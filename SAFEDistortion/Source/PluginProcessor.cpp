@@ -12,6 +12,17 @@
 #include "PluginEditor.h"
 
 
+//==============================================================================
+static const SAFEParameterInfo parameterLayout [] =
+{
+    // name           initial  min     max    units  skew  dB     time   UI scale
+    {"Input Gain",    0.0f,    -50.0f, 50.0f, "dB",  1.0f, true,  100.0, 1.0f},
+    {"Knee",          0.0f,    0.0f,   1.0f,  "",    1.0f, false, 100.0, 1.0f},
+    {"Bias",          0.0f,    0.0f,   1.0f,  "",    1.0f, false, 100.0, 1.0f},
+    {"Tone",          1.0f,    0.0f,   1.0f,  "",    1.0f, false, 100.0, 1.0f},
+    {"Output Gain",   0.0f,    -60.0f, 6.0f,  "dB",  1.0f, true,  100.0, 1.0f}
+};
+
 //==============================================================================
 SafedistortionAudioProcessor::SafedistortionAudioProcessor()
     : freqDCBlocking (20.0f),
@@ -21,11 +32,8 @@ SafedistortionAudioProcessor::SafedistortionAudioProcessor()
 {
     fs = 44100;
     
-    addDBParameter ("Input Gain", inputGain, 0.0f, -50.0f, 50.0f, "dB");
-    addParameter ("Knee", knee, 0.0f, 0.0f, 1.0f);
-    addParameter ("Bias", bias, 0.0f, 0.0f, 1.0f);
-    addParameter ("Tone", tone, 1.0f, 0.0f, 1.0f);
-    addDBParameter ("Output Gain", outputGain, 0.0f, -60.0f, 6.0f, "dB");
+    float* const parameterValues [numParameters] = {&inputGain, &knee, &bias, &tone, &outputGain};
+    addParameters <numParameters> (parameterLayout, parameterValues);
     
     numChannels = 0;
 }
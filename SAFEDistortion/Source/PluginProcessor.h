@@ -42,7 +42,9 @@ public:
         PARAMknee,
         PARAMbias,
         PARAMtone,
-        PARAMoutputGain
+        PARAMoutputGain,
+        
+        numParameters
 	};    
     
 private:
@@ -149,6 +149,7 @@ SafeequaliserAudioProcessorEditor::SafeequaliserAudioProcessorEditor (Safeequali
     display.setBounds (20, 20, 770, 180);
     display.setMaxDecibels (20);
     display.addListener (this);
+    display.setSpectrumAnalyser (&ownerFilter->getSpectrumAnalyser());
     
     display.setControlColour (0, Colours::red);
     display.setControlColour (1, Colours::green);
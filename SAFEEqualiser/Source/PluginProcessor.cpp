@@ -12,6 +12,32 @@
 #include "PluginEditor.h"
 
 
+//==============================================================================
+static const float frequencySkewFactor = 0.25f;
+static const float qSkewFactor = 0.5f;
+
+static const SAFEParameterInfo parameterLayout [] =
+{
+    // name                 initial  min     max       units  skew                 dB     time   UI scale
+    {"Band 1 Gain",         0.0f,    -12.0f, 12.0f,    "dB",  1.0f,                true,  100.0, 1.0f},
+    {"Band 1 Frequency",    150.0f,  22.0f,  1000.0f,  "Hz",  frequencySkewFactor, false, 100.0, 1.0f},
+
+    {"Band 2 Gain",         0.0f,    -12.0f, 12.0f,    "dB",  1.0f,                true,  100.0, 1.0f},
+    {"Band 2 Frequency",    560.0f,  82.0f,  3900.0f,  "Hz",  frequencySkewFactor, false, 100.0, 1.0f},
+    {"Band 2 Q Factor",     0.71f,   0.1f,   10.0f,    "",    qSkewFactor,         false, 100.0, 1.0f},
+
+    {"Band 3 Gain",         0.0f,    -12.0f, 12.0f,    "dB",  1.0f,                true,  100.0, 1.0f},
+    {"Band 3 Frequency",    1000.0f, 180.0f, 4700.0f,  "Hz",  frequencySkewFactor, false, 100.0, 1.0f},
+    {"Band 3 Q Factor",     0.71f,   0.1f,   10.0f,    "",    qSkewFactor,         false, 100.0, 1.0f},
+
+    {"Band 4 Gain",         0.0f,    -12.0f, 12.0f,    "dB",  1.0f,                true,  100.0, 1.0f},
+    {"Band 4 Frequency",    3300.0f, 220.0f, 10000.0f, "Hz",  frequencySkewFactor, false, 100.0, 1.0f},
+    {"Band 4 Q Factor",     0.71f,   0.1f,   10.0f,    "",    qSkewFactor,         false, 100.0, 1.0f},
+
+    {"Band 5 Gain",         0.0f,    -12.0f, 12.0f,    "dB",  1.0f,                true,  100.0, 1.0f},
+    {"Band 5 Frequency",    8200.0f, 580.0f, 20000.0f, "Hz",  frequencySkewFactor, false, 100.0, 1.0f}
+};
+
 //==============================================================================
 SafeequaliserAudioProcessor::SafeequaliserAudioProcessor()
 {
@@ -20,27 +46,15 @@ SafeequaliserAudioProcessor::SafeequaliserAudioProcessor()
     freqs.allocate (numFilters, true);
     qFactors.allocate (numFilters, true);
     
-    float frequencySkewFactor = 0.25;
-    float qSkewFactor = 0.5;
+    float* const parameterValues [numParameters] = {&gains [0], &freqs [0],
+                                                    &gains [1], &freqs [1], &qFactors [1],
+                                                    &gains [2], &freqs [2], &qFactors [2],
+                                                    &gains [3], &freqs [3], &qFactors [3],
+                                                    &gains [4], &freqs [4]};
+    addParameters <numParameters> (parameterLayout, parameterValues);
     
-    addDBParameter ("Band 1 Gain", gains [0], 0.0f, -12.0f, 12.0f, "dB");
-    addParameter ("Band 1 Frequency", freqs [0], 150.0f, 22.0f, 1000.0f, "Hz", frequencySkewFactor);
+    // the shelving bands don't have a Q factor parameter
     qFactors [0] = 0.71f;
-    
-    addDBParameter ("Band 2 Gain", gains [1], 0.0f, -12.0f, 12.0f, "dB");
-    addParameter ("Band 2 Frequency", freqs [1], 560.0f, 82.0f, 3900.0f, "Hz", frequencySkewFactor);
-    addParameter ("Band 2 Q Factor", qFactors [1], 0.71f, 0.1f, 10.0f, String::empty, qSkewFactor);
-    
-    addDBParameter ("Band 3 Gain", gains [2], 0.0f, -12.0f, 12.0f, "dB");
-    addParameter ("Band 3 Frequency", freqs [2], 1000.0f, 180.0f, 4700.0f, "Hz", frequencySkewFactor);
-    addParameter ("Band 3 Q Factor", qFactors [2], 0.71f, 0.1f, 10.0f, String::empty, qSkewFactor);    
-    
-    addDBParameter ("Band 4 Gain", gains [3], 0.0f, -12.0f, 12.0f, "dB");
-    addParameter ("Band 4 Frequency", freqs [3], 3300.0f, 220.0f, 10000.0f, "Hz", frequencySkewFactor);
-    addParameter ("Band 4 Q Factor", qFactors [3], 0.71f, 0.1f, 10.0f, String::empty, qSkewFactor);
-    
-    addDBParameter ("Band 5 Gain", gains [4], 0.0f, -12.0f, 12.0f, "dB");
-    addParameter ("Band 5 Frequency", freqs [4], 8200.0f, 580.0f, 20000.0f, "Hz", frequencySkewFactor);
     qFactors [4] = 0.71f;
         
     fs = 44100;
@@ -56,7 +56,9 @@ public:
         PARAMqFactor3,
         
         PARAMgain4,
-        PARAMfreq4  
+        PARAMfreq4,
+        
+        numParameters
 	};
     
 private:
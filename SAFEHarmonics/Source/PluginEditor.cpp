@@ -24,6 +24,9 @@ SafeharmonicsAudioProcessorEditor::SafeharmonicsAudioProcessorEditor (Safeharmon
     
     addAndMakeVisible (&ampBox);
     ampBox.setBounds (20, 60, 100, 30);
+    
+    // the amplitude box shows the RMS level of the output
+    setFeatureMonitorEnabled (true);
 }
 
 SafeharmonicsAudioProcessorEditor::~SafeharmonicsAudioProcessorEditor()
@@ -42,4 +45,14 @@ void SafeharmonicsAudioProcessorEditor::updateMeters()
     
     double f0 = ourProcessor->getFundamental(); 
     f0Box.setText (String (f0));
+}
+
+void SafeharmonicsAudioProcessorEditor::updateFeatureMonitor (const StringArray& featureNames, const Array <double>& featureValues)
+{
+    int rmsIndex = featureNames.indexOf ("RMS_Amplitude");
+    
+    if (rmsIndex >= 0)
+    {
+        ampBox.setText (String (featureValues [rmsIndex]));
+    }
 }
\ No newline at end of file
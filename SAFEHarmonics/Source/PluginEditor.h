@@ -30,6 +30,8 @@ public:
     
     void updateMeters();
     
+    void updateFeatureMonitor (const StringArray& featureNames, const Array <double>& featureValues);
+    
 private:
     TextEditor f0Box, ampBox;
     
@@ -10,13 +10,34 @@
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
-#include <complex>
 
 
+//==============================================================================
+static const SAFEParameterInfo parameterLayout [] =
+{
+    // name     initial  min      max    units  skew  dB     time   UI scale
+    {"F0",      0.0f,    -100.0f, 12.0f, "",    1.0f, true,  100.0, 1.0f},
+    {"F1",      -100.0f, -100.0f, 12.0f, "",    1.0f, true,  100.0, 1.0f},
+    {"F2",      -100.0f, -100.0f, 12.0f, "",    1.0f, true,  100.0, 1.0f},
+    {"F3",      -100.0f, -100.0f, 12.0f, "",    1.0f, true,  100.0, 1.0f},
+    {"F4",      -100.0f, -100.0f, 12.0f, "",    1.0f, true,  100.0, 1.0f},
+    {"F5",      -100.0f, -100.0f, 12.0f, "",    1.0f, true,  100.0, 1.0f},
+    {"Gain",    0.0f,    -20.0f,  20.0f, "",    1.0f, true,  100.0, 1.0f},
+    {"Method",  1.0f,    0.0f,    1.0f,  "",    1.0f, false, 100.0, 1.0f}
+};
+
+// the filters are tuned to this until the tracker has a confident estimate
+static const double initialFundamental = 440.0;
+
+// only retune the filters when the fundamental moves by more than this
+// proportion of the frequency they are tuned to, about 17 cents
+static const double retuneTolerance = 0.01;
+
 //==============================================================================
 SafeharmonicsAudioProcessor::SafeharmonicsAudioProcessor()
     : method (IAP),
       fundamental (0),
+      filterFundamental (0),
       realSignal (1, 1),
       imagSignal (1, 1),
       f1 (1, 1),
@@ -27,14 +48,8 @@ SafeharmonicsAudioProcessor::SafeharmonicsAudioProcessor()
       numInputs (1),
       fs (44100)      
 {        
-    addDBParameter ("F0", f0Amplitude, 0, -100, 12);
-    addDBParameter ("F1", f1Amplitude, -100, -100, 12);
-    addDBParameter ("F2", f2Amplitude, -100, -100, 12);
-    addDBParameter ("F3", f3Amplitude, -100, -100, 12);
-    addDBParameter ("F4", f4Amplitude, -100, -100, 12);
-    addDBParameter ("F5", f5Amplitude, -100, -100, 12);
-    addDBParameter ("Gain", gain, 0, -20, 20);
-    addParameter ("Method", methodParam);
+    float* const parameterValues [numParameters] = {&f0Amplitude, &f1Amplitude, &f2Amplitude, &f3Amplitude, &f4Amplitude, &f5Amplitude, &gain, &methodParam};
+    addParameters <numParameters> (parameterLayout, parameterValues);
 }
 
 SafeharmonicsAudioProcessor::~SafeharmonicsAudioProcessor()
@@ -61,6 +76,7 @@ void SafeharmonicsAudioProcessor::pluginPreparation (double sampleRate, int samp
 {
     fs = sampleRate;
     f0Tracker.setSampleRate (sampleRate);
+    f0Tracker.reset();
     
     f0Filters.clear();
     quadFilters.clear();
@@ -76,10 +92,7 @@ void SafeharmonicsAudioProcessor::pluginPreparation (double sampleRate, int samp
         quadFilters [channel]->reset();
     }
     
-    if (! synthPhases.getData())
-    {
-        synthPhases.allocate (numInputs, true);
-    }
+    tuneFilters (jmin (initialFundamental, fs / 4));
     
     realSignal.setSize (numInputs, samplesPerBlock * 4);
     imagSignal.setSize (numInputs, samplesPerBlock * 4);
@@ -98,22 +111,22 @@ void SafeharmonicsAudioProcessor::pluginProcessing (AudioSampleBuffer& buffer, M
 {
     int numSamples = buffer.getNumSamples();
     
-    const float* channelData = buffer.getReadPointer (0);
+    f0Tracker.processBlock (buffer.getArrayOfReadPointers(), numInputs, numSamples);
     
-    for (int i = 0; i < numSamples; ++i)
-    {     
-        f0Tracker.addSample (channelData [i]);
-    }   
-    
-    
-    fundamental = f0Tracker.getFundamental();        
-    IIRCoefficients coeffs = IIRCoefficients::makeLowPass (fs, fundamental);
-    
-    int phaseIncrement = 2 * double_Pi * fundamental / fs;
+    // only retune the filters when the tracker has a confident estimate
+    // which is noticeably different to the one they are already tuned to
+    if (f0Tracker.isTracking())
+    {
+        fundamental = f0Tracker.getFundamental();
         
+        if (fundamental > 0 && fundamental < fs / 2 && std::abs (fundamental - filterFundamental) > retuneTolerance * filterFundamental)
+        {
+            tuneFilters (fundamental);
+        }
+    }
+    
     for (int channel = 0; channel < numInputs; ++channel)
     {
-        f0Filters [channel]->setCoefficients (coeffs);
         f0Filters [channel]->processSamples (buffer.getWritePointer (channel), numSamples);           
     }
     
@@ -122,46 +135,24 @@ void SafeharmonicsAudioProcessor::pluginProcessing (AudioSampleBuffer& buffer, M
         const float* inputSamples = buffer.getReadPointer (channel);
         float* realSamples = realSignal.getWritePointer (channel);
         float* imagSamples = imagSignal.getWritePointer (channel);
-        float* f1Samples = f1.getWritePointer (channel);
-        float* f2Samples = f2.getWritePointer (channel);
-        float* f3Samples = f3.getWritePointer (channel);
-        float* f4Samples = f4.getWritePointer (channel);
-        float* f5Samples = f5.getWritePointer (channel);
+        
+        float* harmonicSamples [numHarmonics] = {f1.getWritePointer (channel),
+                                                 f2.getWritePointer (channel),
+                                                 f3.getWritePointer (channel),
+                                                 f4.getWritePointer (channel),
+                                                 f5.getWritePointer (channel)};
         
         quadFilters [channel]->processSamples (inputSamples, realSamples, imagSamples, numSamples);
         
-        for (int i = 0; i < numSamples; ++i)
+        switch (method)
         {
-            float currentSample = inputSamples [i];
-            float sinSample = currentSample * sin (synthPhases [channel]);
-            float cosSample = currentSample * cos (synthPhases [channel]);
-            float harmonicsGain = 1;//2 * sqrt (pow (sinSample, 2) + pow (cosSample, 2));
-            
-            std::complex <float> currentComplexSample (realSamples [i], imagSamples [i]);
-            
-            switch (method)
-            {
-                case SSB:
-                    f1Samples [i] = harmonicsGain * real (pow (currentComplexSample, 2)); 
-                    f2Samples [i] = harmonicsGain * real (pow (currentComplexSample, 3));
-                    f3Samples [i] = harmonicsGain * real (pow (currentComplexSample, 4));
-                    f4Samples [i] = harmonicsGain * real (pow (currentComplexSample, 5));
-                    f5Samples [i] = harmonicsGain * real (pow (currentComplexSample, 6));
-                    break;
-                    
-                case IAP:
-                    float phase = arg (currentComplexSample);
-                    float amplitude = abs (currentComplexSample);
-                    f1Samples [i] = harmonicsGain * amplitude * cos (2 * phase);
-                    f2Samples [i] = harmonicsGain * amplitude * cos (3 * phase);
-                    f3Samples [i] = harmonicsGain * amplitude * cos (4 * phase);
-                    f4Samples [i] = harmonicsGain * amplitude * cos (5 * phase);
-                    f5Samples [i] = harmonicsGain * amplitude * cos (6 * phase);
-                    break;
-            }
-            
-            synthPhases [channel] += phaseIncrement;
-            synthPhases [channel] = fmod (synthPhases [channel], 2 * double_Pi);
+            case SSB:
+                generateSSBHarmonics (realSamples, imagSamples, harmonicSamples, numSamples);
+                break;
+                
+            case IAP:
+                generateIAPHarmonics (realSamples, imagSamples, harmonicSamples, numSamples);
+                break;
         }
         
         buffer.applyGain (channel, 0, numSamples, f0Amplitude);
@@ -175,6 +166,93 @@ void SafeharmonicsAudioProcessor::pluginProcessing (AudioSampleBuffer& buffer, M
     buffer.applyGain (gain);
 }
 
+//==============================================================================
+void SafeharmonicsAudioProcessor::tuneFilters (double newFundamental)
+{
+    IIRCoefficients coeffs = IIRCoefficients::makeLowPass (fs, newFundamental);
+    
+    for (int channel = 0; channel < numInputs; ++channel)
+    {
+        f0Filters [channel]->setCoefficients (coeffs);
+    }
+    
+    filterFundamental = newFundamental;
+}
+
+//==============================================================================
+// Harmonics 2 to 6 of the analytic signal z = re + j im.
+// SSB takes the real part of successive powers of z, building each one from
+// the last with a single complex multiply.
+void SafeharmonicsAudioProcessor::generateSSBHarmonics (const float* realSamples, const float* imagSamples, float* const* harmonicSamples, int numSamples)
+{
+    float* h2 = harmonicSamples [0];
+    float* h3 = harmonicSamples [1];
+    float* h4 = harmonicSamples [2];
+    float* h5 = harmonicSamples [3];
+    float* h6 = harmonicSamples [4];
+    
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float a = realSamples [i];
+        const float b = imagSamples [i];
+        
+        float re = a * a - b * b;
+        float im = 2 * a * b;
+        h2 [i] = re;
+        
+        float nextRe = re * a - im * b;
+        im = re * b + im * a;
+        re = nextRe;
+        h3 [i] = re;
+        
+        nextRe = re * a - im * b;
+        im = re * b + im * a;
+        re = nextRe;
+        h4 [i] = re;
+        
+        nextRe = re * a - im * b;
+        im = re * b + im * a;
+        re = nextRe;
+        h5 [i] = re;
+        
+        h6 [i] = re * a - im * b;
+    }
+}
+
+// IAP keeps the instantaneous amplitude A = |z| and multiplies the phase.
+// cos (k phase) comes from the Chebyshev recurrence
+// T(k + 1) = 2 cos (phase) T(k) - T(k - 1) with cos (phase) = re / A.
+void SafeharmonicsAudioProcessor::generateIAPHarmonics (const float* realSamples, const float* imagSamples, float* const* harmonicSamples, int numSamples)
+{
+    float* h2 = harmonicSamples [0];
+    float* h3 = harmonicSamples [1];
+    float* h4 = harmonicSamples [2];
+    float* h5 = harmonicSamples [3];
+    float* h6 = harmonicSamples [4];
+    
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float a = realSamples [i];
+        const float b = imagSamples [i];
+        
+        const float amplitude = sqrt (a * a + b * b);
+        const float cosPhase = amplitude > 0 ? a / amplitude : 1.0f;
+        const float twoCosPhase = 2 * cosPhase;
+        
+        const float t2 = twoCosPhase * cosPhase - 1;
+        const float t3 = twoCosPhase * t2 - cosPhase;
+        const float t4 = twoCosPhase * t3 - t2;
+        const float t5 = twoCosPhase * t4 - t3;
+        const float t6 = twoCosPhase * t5 - t4;
+        
+        h2 [i] = amplitude * t2;
+        h3 [i] = amplitude * t3;
+        h4 [i] = amplitude * t4;
+        h5 [i] = amplitude * t5;
+        h6 [i] = amplitude * t6;
+    }
+}
+
 //==============================================================================
 bool SafeharmonicsAudioProcessor::hasEditor() const
 {
@@ -47,7 +47,9 @@ public:
         F4Gain,
         F5Gain,
         MasterGain,
-        Method
+        Method,
+        
+        numParameters
     };
     
     enum HarmonicGenerationMethod
@@ -57,12 +59,10 @@ public:
     } method;
 
 private:
-    double fundamental;
+    double fundamental, filterFundamental;
     
     FundamentalTracker f0Tracker;
     
-    HeapBlock <float> synthPhases;
-    
     OwnedArray <IIRFilter> f0Filters;
     OwnedArray <QuadratureFilter> quadFilters;
     
@@ -74,6 +74,12 @@ private:
     
     float f0Amplitude, f1Amplitude, f2Amplitude, f3Amplitude, f4Amplitude, f5Amplitude, gain;
     float methodParam;
+    
+    enum {numHarmonics = 5};
+    
+    void tuneFilters (double newFundamental);
+    void generateSSBHarmonics (const float* realSamples, const float* imagSamples, float* const* harmonicSamples, int numSamples);
+    void generateIAPHarmonics (const float* realSamples, const float* imagSamples, float* const* harmonicSamples, int numSamples);
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SafeharmonicsAudioProcessor)
 };
@@ -12,6 +12,21 @@
 #include "PluginEditor.h"
 
 
+//==============================================================================
+static const SAFEParameterInfo parameterLayout [] =
+{
+    // name                   initial  min   max   units  skew  dB     time   UI scale
+    {"Damping Frequency",     0.0f,    0.0f, 1.0f, "",    1.0f, false, 100.0, 1.0f},
+    {"Density",               0.5f,    0.0f, 1.0f, "",    1.0f, false, 100.0, 1.0f},
+    {"Bandwidth Frequency",   1.0f,    0.0f, 1.0f, "",    1.0f, false, 100.0, 1.0f},
+    {"Decay",                 0.5f,    0.0f, 1.0f, "",    1.0f, false, 100.0, 1.0f},
+    {"PreDelay",              0.0f,    0.0f, 1.0f, "",    1.0f, false, 100.0, 1.0f},
+    {"Size",                  0.5f,    0.0f, 1.0f, "",    1.0f, false, 100.0, 1.0f},
+    {"Gain",                  1.0f,    0.0f, 1.0f, "",    1.0f, false, 100.0, 1.0f},
+    {"Mix",                   0.15f,   0.0f, 1.0f, "%",   1.0f, false, 100.0, 100.0f},
+    {"Early Mix",             0.75f,   0.0f, 1.0f, "%",   1.0f, false, 100.0, 100.0f}
+};
+
 //==============================================================================
 SafereverbAudioProcessor::SafereverbAudioProcessor()
     : tempInput (2, 44100),
@@ -20,17 +35,10 @@ SafereverbAudioProcessor::SafereverbAudioProcessor()
     tempInput.clear();
     tempOutput.clear();
     
-    addParameter ("Damping Frequency", dampingFreq, 0);
-    addParameter ("Density", density, 0.5);
-    addParameter ("Bandwidth Frequency", bandwidthFreq, 1.0);
-    addParameter ("Decay", decay, 0.5);
-    addParameter ("PreDelay", predelay, 0);
-    addParameter ("Size", size, 0.5);
-    addParameter ("Gain", gain, 1.0);
-    addParameter ("Mix", mix, 0.15, 0.0, 1.0, "%", 1.0, false, 100.0, 100.0);
-    addParameter ("Early Mix", earlyMix, 0.75, 0.0, 1.0, "%", 1.0, false, 100.0, 100.0);
+    float* const parameterValues [numParameters] = {&dampingFreq, &density, &bandwidthFreq, &decay, &predelay, &size, &gain, &mix, &earlyMix};
+    addParameters <numParameters> (parameterLayout, parameterValues);
     
-    for (int i = 0; i < 9; ++i)
+    for (int i = 0; i < numParameters; ++i)
     {
         parameterUpdateCalculations (i);
     }
@@ -42,7 +42,9 @@ public:
         PARAMsize,
         PARAMgain,
         PARAMmix,
-        PARAMearlyMix
+        PARAMearlyMix,
+        
+        numParameters
 	};
     
     //==============================================================================